@@ -116,6 +116,16 @@ void req_set_response(void* req_ptr, bytes_t data, uint16_t node_index) {
   ctx->response_node_index = node_index;
 }
 
+void req_append_response(void* req_ptr, bytes_t data) {
+  c4_req_append_response((data_request_t*) req_ptr, data);
+}
+
+void req_finish_response(void* req_ptr, uint16_t node_index) {
+  data_request_t* ctx = (data_request_t*) req_ptr;
+  c4_req_finish_response(ctx);
+  ctx->response_node_index = node_index;
+}
+
 void req_set_error(void* req_ptr, char* error, uint16_t node_index) {
   data_request_t* ctx      = (data_request_t*) req_ptr;
   ctx->error               = strdup(error);
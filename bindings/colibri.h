@@ -66,6 +66,22 @@ void free_proofer_ctx(proofer_t* ctx);
  */
 void req_set_response(void* req_ptr, bytes_t data, uint16_t node_index);
 
+/**
+ * passes the next chunk of the response while it is still being received.
+ * For large results like block receipts the values are processed right away, so the complete response is never kept in memory.
+ * After the last chunk req_finish_response must be called.
+ * @param req_ptr the pointer to the data request ( as given in the json-string of proofer_execute_json_status)
+ * @param data the chunk, which is copied
+ */
+void req_append_response(void* req_ptr, bytes_t data);
+
+/**
+ * sets the response of the data request from all chunks passed with req_append_response.
+ * @param req_ptr the pointer to the data request ( as given in the json-string of proofer_execute_json_status)
+ * @param node_index the  index of the node the response came from.
+ */
+void req_finish_response(void* req_ptr, uint16_t node_index);
+
 /**
  * sets the error of the data request
  * @param req_ptr the pointer to the data request ( as given in the json-string of proofer_execute_json_status)
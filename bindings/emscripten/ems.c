@@ -104,6 +104,15 @@ void EMSCRIPTEN_KEEPALIVE c4w_req_set_response(data_request_t* ctx, void* data,
   ctx->response_node_index = node_index;
 }
 
+void EMSCRIPTEN_KEEPALIVE c4w_req_append_response(data_request_t* ctx, void* data, size_t len) {
+  c4_req_append_response(ctx, bytes(data, len));
+}
+
+void EMSCRIPTEN_KEEPALIVE c4w_req_finish_response(data_request_t* ctx, uint16_t node_index) {
+  c4_req_finish_response(ctx);
+  ctx->response_node_index = node_index;
+}
+
 void EMSCRIPTEN_KEEPALIVE c4w_req_set_error(data_request_t* ctx, char* error, uint16_t node_index) {
   ctx->error               = strdup(error);
   ctx->response_node_index = node_index;
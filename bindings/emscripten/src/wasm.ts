@@ -5,6 +5,8 @@ export interface C4W {
     _c4w_execute_proof_ctx: (proofCtx: number) => number;
     _c4w_get_pending_data_request: (proofCtx: number) => number;
     _c4w_req_set_response: (reqPtr: number, data: number, len: number, node_index: number) => void;
+    _c4w_req_append_response: (reqPtr: number, data: number, len: number) => void;
+    _c4w_req_finish_response: (reqPtr: number, node_index: number) => void;
     _c4w_req_set_error: (reqPtr: number, error: number, node_index: number) => void;
     _c4w_verify_proof: (proof: number, proof_len: number, method: number, args: number, chain_id: bigint) => number;
     _c4w_handle_client_updates: (update_ptr: number, chain_id: bigint) => boolean;
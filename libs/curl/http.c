@@ -64,6 +64,20 @@ static size_t curl_append(void* contents, size_t size, size_t nmemb, void* buf)
   return size * nmemb;
 }
 
+// passes the chunk directly to the stream of the request, so the complete response is never kept in memory
+static size_t curl_stream(void* contents, size_t size, size_t nmemb, void* req) {
+  c4_req_append_response((data_request_t*) req, bytes(contents, size * nmemb));
+  return size * nmemb;
+}
+
+static bool use_stream(data_request_t* req) {
+#ifdef TEST
+  // the testdata and the cache need the complete response
+  if (REQ_TEST_DIR || cache_dir) return false;
+#endif
+  return req->stream != NULL;
+}
+
 static void configure() {
   char*   config_file = getenv("C4_CONFIG");
   bytes_t content     = {0};
@@ -104,15 +118,20 @@ static bool handle(data_request_t* req, char* url, buffer_t* error) {
   headers = curl_slist_append(headers, "User-Agent: c4 curl ");
   curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
 
-  curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, curl_append);
-  curl_easy_setopt(curl, CURLOPT_WRITEDATA, &buffer);
+  bool stream = use_stream(req);
+  curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, stream ? curl_stream : curl_append);
+  curl_easy_setopt(curl, CURLOPT_WRITEDATA, stream ? (void*) req : (void*) &buffer);
   curl_easy_setopt(curl, CURLOPT_TIMEOUT, (uint64_t) 120);
   curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, CURL_METHODS[req->method]);
   CURLcode res = curl_easy_perform(curl);
   if (res == CURLE_OK) {
-    req->response = buffer.data;
+    if (stream)
+      c4_req_finish_response(req);
+    else
+      req->response = buffer.data;
   }
   else {
+    if (stream) c4_req_reset_response(req);
     buffer_free(&buffer);
     buffer_add_chars(error, curl_easy_strerror(res));
   }
@@ -0,0 +1,140 @@
+#!/usr/bin/env node
+
+// generates src/verifier/types_fields.h with index constants and inline accessors for the ssz containers of the verifier.
+// Since the position of each field within the fixed part of a container is known at compile time,
+// fixed fields are read directly from their offset and dynamic fields by their index without any name lookup.
+
+const fs = require('fs');
+
+const type_defs = [
+    "verifier/types_beacon.c",
+    "verifier/types_verify.c",
+]
+const target = '../src/verifier/types_fields.h'
+
+// predefined types from ssz.c with their fixed length (0 = dynamic)
+const predefined = {
+    ssz_uint8: 1,
+    ssz_bytes32: 32,
+    ssz_bls_pubky: 48,
+    ssz_bytes_list: 0,
+}
+
+let arrays = {}     // name of the elements array -> [{name, macro, args}]
+let containers = {} // name of a ssz_def_t holding a container -> name of its elements
+let order = []
+let names = {}
+
+function parse(lines) {
+    let fields = null
+    for (let line of lines) {
+        line = line.split('//')[0]
+        let match = line.match(/const\s+ssz_def_t\s+(\w+)\s*\[.*/)
+        if (match) {
+            fields = arrays[match[1]] = []
+            order.push(match[1])
+        }
+        else if ((match = line.match(/const\s+ssz_def_t\s+(\w+)\s*=\s*SSZ_(\w+)\((.*)\)/))) {
+            fields = null
+            const args = match[3].split(',').map(_ => _.trim())
+            if (match[2] == 'CONTAINER') containers[match[1]] = args[1]
+            else predefined[match[1]] = fixed_length(match[2], args.slice(1))
+        }
+        else if (fields && (match = line.match(/^\s*SSZ_(\w+)\("(\w+)"(.*?)\)/)))
+            fields.push({ name: match[2], macro: match[1], args: match[3].split(',').map(_ => _.trim()).filter(_ => _) })
+        if (line.indexOf('};') >= 0) fields = null
+    }
+}
+
+// returns the length of the type within the fixed part or 0 if it is dynamic
+function type_length(type) {
+    type = type.replace('&', '')
+    if (predefined[type] !== undefined) return predefined[type]
+    if (containers[type]) return container_length(containers[type])
+    throw new Error('unknown type ' + type)
+}
+
+function container_length(elements) {
+    let len = 0
+    for (const field of arrays[elements]) {
+        const l = fixed_length(field.macro, field.args)
+        if (!l) return 0
+        len += l
+    }
+    return len
+}
+
+function fixed_length(macro, args) {
+    switch (macro) {
+        case 'UINT': return parseInt(args[0])
+        case 'UINT8': return 1
+        case 'UINT16': return 2
+        case 'UINT32': return 4
+        case 'UINT64': return 8
+        case 'UINT256': return 32
+        case 'BOOLEAN': return 1
+        case 'BYTES32': return 32
+        case 'ADDRESS': return 20
+        case 'BYTE_VECTOR': return parseInt(args[0])
+        case 'BIT_VECTOR': return (parseInt(args[0]) + 7) >> 3
+        case 'VECTOR': return type_length(args[0]) * parseInt(args[1])
+        case 'CONTAINER': return container_length(args[0])
+        case 'LIST':
+        case 'BYTES':
+        case 'BIT_LIST':
+        case 'UNION':
+            return 0
+        default:
+            throw new Error('unknown ssz macro SSZ_' + macro)
+    }
+}
+
+function snake(name) {
+    return name.replace(/([a-z0-9])([A-Z])/g, '$1_$2').toLowerCase()
+}
+
+type_defs.forEach(f => parse(fs.readFileSync('../src/' + f, 'utf8').split('\n')))
+
+let out = [
+    '// generated by scripts/update_ssz_fields.js from the type definitions - do not edit!',
+    '#ifndef types_fields_h__',
+    '#define types_fields_h__',
+    '',
+    '#ifdef __cplusplus',
+    'extern "C" {',
+    '#endif',
+    '',
+    '#include "../util/ssz.h"',
+    '',
+]
+
+for (const elements of order) {
+    if (elements.endsWith('_UNION')) continue
+    const fields = arrays[elements]
+    const prefix = elements.toLowerCase()
+    const fixed = container_length(elements)
+    out.push(`// ${elements} (${fixed ? 'fixed length: ' + fixed : 'dynamic'})`)
+    out.push(`extern const ssz_def_t ${elements}[];`)
+    let offset = 0
+    let defines = []
+    let accessors = []
+    fields.forEach((field, index) => {
+        const len = fixed_length(field.macro, field.args)
+        const name = `${prefix}_${snake(field.name)}`
+        const index_name = `IDX_${name.toUpperCase()}`
+        if (names[name]) throw new Error(`duplicate accessor ${name} for ${elements}.${field.name} and ${names[name]}`)
+        names[name] = `${elements}.${field.name}`
+        defines.push([`#define ${index_name}`, `${index}`])
+        accessors.push(`static inline ssz_ob_t ${name}(ssz_ob_t* ob) { ` + (len
+            ? `return ssz_get_fixed_field(ob, ${elements}, ${index_name}, ${offset}, ${len}); }`
+            : `return ssz_get_indexed_field(ob, ${elements}, ${index_name}); }`))
+        offset += len || 4
+    })
+    const pad = defines.reduce((max, l) => Math.max(max, l[0].length), 0)
+    defines.forEach(l => out.push(l[0].padEnd(pad) + ' ' + l[1]))
+    out.push(...accessors)
+    out.push('')
+}
+
+out.push('#ifdef __cplusplus', '}', '#endif', '', '#endif', '')
+fs.writeFileSync(target, out.join('\n'))
@@ -0,0 +1,35 @@
+#!/usr/bin/env node
+
+// generates src/util/zero_hashes.h with the roots of merkle trees containing only zero chunks.
+// ZERO_HASHES[h] is the root of a tree with the height h, so ZERO_HASHES[0] is the zero chunk itself.
+// Since gindexes are 64 bit values, no tree can be deeper than 64.
+
+const crypto = require('crypto');
+const fs = require('fs');
+
+const MAX_HEIGHT = 64
+const target = '../src/util/zero_hashes.h'
+
+let hash = Buffer.alloc(32)
+let rows = []
+for (let h = 0; h <= MAX_HEIGHT; h++) {
+    rows.push('    {' + [...hash].map(b => '0x' + b.toString(16).padStart(2, '0')).join(', ') + '}, // ' + h)
+    hash = crypto.createHash('sha256').update(Buffer.concat([hash, hash])).digest()
+}
+
+fs.writeFileSync(target, [
+    '// generated by scripts/update_zero_hashes.js - do not edit!',
+    '#ifndef zero_hashes_h__',
+    '#define zero_hashes_h__',
+    '',
+    '#include <stdint.h>',
+    '',
+    `#define ZERO_HASHES_MAX_HEIGHT ${MAX_HEIGHT}`,
+    '',
+    '// the roots of merkle trees with only zero chunks by their height (0 = the zero chunk)',
+    `static const uint8_t ZERO_HASHES[ZERO_HASHES_MAX_HEIGHT + 1][32] = {`,
+    ...rows,
+    '};',
+    '',
+    '#endif',
+    ''].join('\n'))
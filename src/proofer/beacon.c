@@ -1,4 +1,5 @@
 #include "beacon.h"
+#include "../util/compat.h"
 #include "../util/json.h"
 #include "../verifier/types_beacon.h"
 #include "../verifier/types_verify.h"
@@ -6,6 +7,7 @@
 #include "proofer.h"
 #include "ssz_types.h"
 #include <inttypes.h>
+#include <stdlib.h>
 #include <string.h>
 
 static c4_status_t get_beacon_header_by_hash(proofer_ctx_t* ctx, char* hash, json_t* header) {
@@ -90,6 +92,117 @@ c4_status_t c4_beacon_get_block_for_eth(proofer_ctx_t* ctx, json_t block, beacon
   return C4_SUCCESS;
 }
 
+// hashed views of the last used block bodies, shared by all proofer contexts of the process, most recent first.
+// every entry in the cache holds one reference, so an entry evicted while a context still uses it is freed with its last release.
+#define BODY_CACHE_SIZE 4
+
+static c4_hashed_body_t*     body_cache[BODY_CACHE_SIZE] = {0};
+static c4_body_cache_stats_t body_cache_stats            = {0};
+static void*                 body_cache_lock             = NULL; // spinlock, only held while the list or the refs change
+
+static void lock_body_cache() {
+  while (!c4_atomic_cas_ptr(&body_cache_lock, NULL, (void*) &body_cache_lock)) {}
+}
+
+static void unlock_body_cache() {
+  c4_atomic_cas_ptr(&body_cache_lock, (void*) &body_cache_lock, NULL);
+}
+
+static void free_hashed_body(c4_hashed_body_t* body) {
+  ssz_hashed_free(body->view);
+  free(body->body.data);
+  free(body);
+}
+
+// finds the entry, moves it to the front and adds a reference. must be called with the lock held.
+static c4_hashed_body_t* find_hashed_body(uint64_t slot, const uint8_t* block_hash) {
+  for (int i = 0; i < BODY_CACHE_SIZE && body_cache[i]; i++) {
+    c4_hashed_body_t* body = body_cache[i];
+    if (body->slot != slot || memcmp(body->block_hash, block_hash, 32)) continue;
+    memmove(body_cache + 1, body_cache, i * sizeof(c4_hashed_body_t*));
+    body_cache[0] = body;
+    body->refs++;
+    return body;
+  }
+  return NULL;
+}
+
+c4_hashed_body_t* c4_beacon_body_acquire(beacon_block_t* block) {
+  bytes_t           block_hash = ssz_get(&block->execution, "blockHash").bytes;
+  bool              cacheable  = block_hash.len == 32;
+  c4_hashed_body_t* body       = NULL;
+  if (cacheable) {
+    lock_body_cache();
+    body = find_hashed_body(block->slot, block_hash.data);
+    if (body) body_cache_stats.hits++;
+    unlock_body_cache();
+    if (body) return body;
+  }
+
+  // hash a copy of the body outside of the lock, so the view does not depend on the data of the request.
+  body       = calloc(1, sizeof(c4_hashed_body_t));
+  body->slot = block->slot;
+  body->body = bytes_dup(block->body.bytes);
+  body->view = ssz_hashed_create(ssz_ob(*block->body.def, body->body));
+  body->refs = 1;
+  if (!cacheable) return body;
+  memcpy(body->block_hash, block_hash.data, 32);
+
+  lock_body_cache();
+  c4_hashed_body_t* cached  = find_hashed_body(body->slot, body->block_hash); // another thread may have been faster
+  c4_hashed_body_t* evicted = NULL;
+  if (!cached) {
+    evicted = body_cache[BODY_CACHE_SIZE - 1];
+    if (evicted && --evicted->refs) evicted = NULL; // still used by a context, which frees it with the last release
+    memmove(body_cache + 1, body_cache, (BODY_CACHE_SIZE - 1) * sizeof(c4_hashed_body_t*));
+    body_cache[0] = body;
+    body->refs++;
+    body_cache_stats.misses++;
+  }
+  else
+    body_cache_stats.hits++;
+  unlock_body_cache();
+
+  if (evicted) free_hashed_body(evicted);
+  if (!cached) return body;
+  free_hashed_body(body);
+  return cached;
+}
+
+void c4_beacon_body_release(c4_hashed_body_t* body) {
+  if (!body) return;
+  lock_body_cache();
+  bool last = --body->refs == 0;
+  unlock_body_cache();
+  if (last) free_hashed_body(body);
+}
+
+void c4_beacon_body_cache_free() {
+  c4_hashed_body_t* bodies[BODY_CACHE_SIZE] = {0};
+  lock_body_cache();
+  memcpy(bodies, body_cache, sizeof(body_cache));
+  memset(body_cache, 0, sizeof(body_cache));
+  body_cache_stats = (c4_body_cache_stats_t) {0};
+  unlock_body_cache();
+  for (int i = 0; i < BODY_CACHE_SIZE; i++) c4_beacon_body_release(bodies[i]);
+}
+
+c4_body_cache_stats_t c4_beacon_body_cache_stats() {
+  lock_body_cache();
+  c4_body_cache_stats_t stats = body_cache_stats;
+  for (int i = 0; i < BODY_CACHE_SIZE && body_cache[i]; i++) stats.entries++;
+  unlock_body_cache();
+  return stats;
+}
+
+bytes_t c4_beacon_body_proof(beacon_block_t* block, gindex_t* gindexes, int gindex_len, bytes32_t body_root) {
+  c4_hashed_body_t* body = c4_beacon_body_acquire(block);
+  ssz_hashed_root(body->view, body_root);
+  bytes_t proof = ssz_hashed_multi_proof(body->view, gindexes, gindex_len);
+  c4_beacon_body_release(body);
+  return proof;
+}
+
 ssz_builder_t c4_proof_add_header(ssz_ob_t block, bytes32_t body_root) {
   ssz_builder_t beacon_header = {.def = (ssz_def_t*) &BEACON_BLOCKHEADER_CONTAINER, .dynamic = {0}, .fixed = {0}};
   ssz_add_bytes(&beacon_header, "slot", ssz_get(&block, "slot").bytes);
@@ -100,6 +213,14 @@ ssz_builder_t c4_proof_add_header(ssz_ob_t block, bytes32_t body_root) {
   return beacon_header;
 }
 
+void c4_proof_set_header(ssz_node_t* node, ssz_ob_t header, bytes32_t body_root) {
+  ssz_node_set_bytes(node, "slot", ssz_get(&header, "slot").bytes);
+  ssz_node_set_bytes(node, "proposerIndex", ssz_get(&header, "proposerIndex").bytes);
+  ssz_node_set_bytes(node, "parentRoot", ssz_get(&header, "parentRoot").bytes);
+  ssz_node_set_bytes(node, "stateRoot", ssz_get(&header, "stateRoot").bytes);
+  ssz_node_set_bytes(node, "bodyRoot", bytes(body_root, 32));
+}
+
 bytes_t c4_proofer_add_data(json_t data, const char* union_name, buffer_t* tmp) {
   buffer_grow(tmp, 100);
   const ssz_def_t* data_type = NULL;
@@ -125,7 +246,7 @@ c4_status_t c4_send_beacon_json(proofer_ctx_t* ctx, char* path, char* query, jso
     buffer_free(&buffer);
     if (c4_state_is_pending(data_request)) return C4_PENDING;
     if (!data_request->error && data_request->response.data) {
-      json_t response = json_parse((char*) data_request->response.data);
+      json_t response = json_parse_indexed((char*) data_request->response.data, data_request->response.len, &data_request->json_index);
       if (response.type == JSON_TYPE_INVALID) THROW_ERROR("Invalid JSON response");
       *result = response;
       return C4_SUCCESS;
@@ -162,7 +283,11 @@ c4_status_t c4_send_beacon_ssz(proofer_ctx_t* ctx, char* path, char* query, cons
     if (c4_state_is_pending(data_request)) return C4_PENDING;
     if (!data_request->error && data_request->response.data) {
       *result = (ssz_ob_t) {.def = def, .bytes = data_request->response};
-      return ssz_is_valid(*result, true, &ctx->state) ? C4_SUCCESS : C4_ERROR;
+      if (!data_request->validated) {
+        if (!ssz_is_valid(*result, true, &ctx->state)) return C4_ERROR;
+        data_request->validated = true;
+      }
+      return C4_SUCCESS;
     }
     else
       THROW_ERROR(data_request->error ? data_request->error : "Data request failed");
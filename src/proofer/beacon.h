@@ -21,9 +21,43 @@ typedef struct {
 // get the beacon block for the given eth block number or hash
 c4_status_t c4_beacon_get_block_for_eth(proofer_ctx_t* ctx, json_t block, beacon_block_t* beacon_block);
 
+// a hashed view of a block body, which is shared by all proofer contexts. It owns a copy of the body
+// and stays valid until it is released, even if it has been evicted from the cache in the meantime.
+typedef struct {
+  uint64_t      slot;       // slot of the block
+  bytes32_t     block_hash; // blockHash of the execution payload
+  bytes_t       body;       // copy of the ssz encoded body
+  ssz_hashed_t* view;       // hashed view of the body
+  uint32_t      refs;       // references held by contexts and the cache
+} c4_hashed_body_t;
+
+// counters of the body cache
+typedef struct {
+  uint32_t entries; // number of cached bodies
+  uint64_t hits;    // bodies found in the cache
+  uint64_t misses;  // bodies hashed and added to the cache
+} c4_body_cache_stats_t;
+
+// returns the hashed body of the block from the process wide cache (keyed by slot and blockHash) or hashes and adds it.
+// the cache is thread safe and keeps the last used bodies. The result must be released with c4_beacon_body_release.
+c4_hashed_body_t* c4_beacon_body_acquire(beacon_block_t* block);
+// releases a hashed body and frees it, if it is not cached anymore and this was the last reference
+void c4_beacon_body_release(c4_hashed_body_t* body);
+// removes all bodies from the cache and resets the counters. Bodies still acquired are freed with their last release.
+void c4_beacon_body_cache_free();
+// returns the counters of the body cache
+c4_body_cache_stats_t c4_beacon_body_cache_stats();
+
+// creates a multi proof for the gindexes within the body and writes the body_root.
+// the hashed body is taken from the body cache, so more proofs for the same block don't need to hash it again.
+bytes_t c4_beacon_body_proof(beacon_block_t* block, gindex_t* gindexes, int gindex_len, bytes32_t body_root);
+
 // creates a new header with the body_root passed and returns the ssz_builder_t, which must be freed
 ssz_builder_t c4_proof_add_header(ssz_ob_t header, bytes32_t body_root);
 
+// sets the fields of a header node with the body_root passed. The values are referenced, so the header and body_root must stay valid until the node is serialized
+void c4_proof_set_header(ssz_node_t* node, ssz_ob_t header, bytes32_t body_root);
+
 // creates the data based on the json as ssz object with the union_name passed and returns the bytes_t, which uses the buffer_t passed for memory
 bytes_t c4_proofer_add_data(json_t data, const char* union_name, buffer_t* tmp);
 
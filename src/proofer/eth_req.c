@@ -23,14 +23,6 @@ c4_status_t get_eth_tx(proofer_ctx_t* ctx, json_t txhash, json_t* tx_data) {
   return C4_SUCCESS;
 }
 
-c4_status_t eth_getBlockReceipts(proofer_ctx_t* ctx, json_t block, json_t* receipts_array) {
-  uint8_t  tmp[200];
-  buffer_t buf = stack_buffer(tmp);
-  TRY_ASYNC(c4_send_eth_rpc(ctx, "eth_getBlockReceipts", bprintf(&buf, "[%J]", block), receipts_array));
-  CHECK_JSON(*receipts_array, "[" JSON_RECEIPTS_FIELDS "]", "Invalid results for Block Receipts: ");
-  return C4_SUCCESS;
-}
-
 c4_status_t eth_get_logs(proofer_ctx_t* ctx, json_t params, json_t* logs) {
   uint8_t  tmp[1000];
   buffer_t buf = stack_buffer(tmp);
@@ -39,60 +31,179 @@ c4_status_t eth_get_logs(proofer_ctx_t* ctx, json_t params, json_t* logs) {
   return C4_SUCCESS;
 }
 
+static c4_status_t send_eth_rpc(proofer_ctx_t* ctx, char* method, char* params, json_t* result, data_request_t** req);
+
+// validates and serializes each receipt as it arrives.
+static void receipts_add(void* ptr, json_t receipt) {
+  static json_schema_t* schema   = NULL;
+  eth_receipts_t*       receipts = (eth_receipts_t*) ptr;
+  if (receipts->error) return;
+
+  const char* err = json_schema_validate(json_schema_cached(&schema, JSON_RECEIPTS_FIELDS), receipt, "");
+  if (err) {
+    buffer_t error  = {0};
+    receipts->error = bprintf(&error, "Invalid results for Block Receipts:  at elemtent (idx: %d ) : %s", receipts->stream.json.count, err);
+    free((char*) err);
+    return;
+  }
+
+  uint32_t index    = json_get_uint32(receipt, "transactionIndex");
+  bytes_t  rlp      = c4_serialize_receipt(receipt, &receipts->rlp);
+  uint32_t entry[2] = {index, rlp.len};
+  if (index == receipts->tx_index && !receipts->receipt) receipts->receipt = json_new_string(receipt);
+  buffer_append(&receipts->values, rlp);
+  buffer_append(&receipts->entries, bytes(entry, sizeof(entry)));
+}
+
+// builds the receipts trie from all serialized receipts at once.
+static void receipts_build(eth_receipts_t* receipts) {
+  uint32_t* entries = (uint32_t*) receipts->entries.data.data;
+  uint32_t  len     = receipts->entries.data.len / (2 * sizeof(uint32_t));
+  bytes_t*  keys    = calloc(len * 2, sizeof(bytes_t));
+  bytes_t*  values  = keys + len;
+  uint8_t*  paths   = calloc(len, 8);
+  uint32_t  offset  = 0;
+  for (uint32_t i = 0; i < len; i++) {
+    buffer_t buf = {.data = bytes(paths + i * 8, 0), .allocated = -8};
+    keys[i]      = c4_eth_create_tx_path(entries[i * 2], &buf);
+    values[i]    = bytes(receipts->values.data.data + offset, entries[i * 2 + 1]);
+    offset += values[i].len;
+  }
+  receipts->trie = patricia_build(keys, values, len); // the trie borrows the values
+  free(keys);
+  free(paths);
+  buffer_free(&receipts->entries);
+  receipts->entries = (buffer_t) {0};
+}
+
+static void receipts_reset(data_stream_t* stream) {
+  eth_receipts_t* receipts = (eth_receipts_t*) stream;
+  patricia_node_free(receipts->trie);
+  free(receipts->receipt);
+  free(receipts->error);
+  buffer_free(&receipts->values);
+  buffer_free(&receipts->entries);
+  receipts->trie    = NULL;
+  receipts->receipt = NULL;
+  receipts->error   = NULL;
+  receipts->values  = (buffer_t) {0};
+  receipts->entries = (buffer_t) {0};
+}
+
+static void receipts_free(data_stream_t* stream) {
+  receipts_reset(stream);
+  buffer_free(&((eth_receipts_t*) stream)->rlp);
+  free(stream);
+}
+
+c4_status_t eth_get_receipts_trie(proofer_ctx_t* ctx, json_t block, uint32_t tx_index, eth_receipts_t** receipts) {
+  uint8_t         tmp[200];
+  buffer_t        buf    = stack_buffer(tmp);
+  json_t          result = {0};
+  data_request_t* req    = NULL;
+  c4_status_t     status = send_eth_rpc(ctx, "eth_getBlockReceipts", bprintf(&buf, "[%J]", block), &result, &req);
+  // the stream is attached to a new request, before the host sends it
+  if (req && !req->stream) {
+    eth_receipts_t* r       = calloc(1, sizeof(eth_receipts_t));
+    r->tx_index             = tx_index;
+    r->stream.json.property = "result";
+    r->stream.json.on_value = receipts_add;
+    r->stream.json.ctx      = r;
+    r->stream.reset         = receipts_reset;
+    r->stream.free          = receipts_free;
+    req->stream             = &r->stream;
+    if (!c4_state_is_pending(req)) c4_req_stream_response(req);
+    if (status == C4_SUCCESS) status = send_eth_rpc(ctx, "eth_getBlockReceipts", (char*) buf.data.data, &result, &req);
+  }
+  if (status != C4_SUCCESS) return status;
+
+  // the values of the array were passed to the stream, but the remaining result must still be an (empty) array
+  if (result.type != JSON_TYPE_ARRAY) {
+    ctx->state.error = strdup("Invalid results for Block Receipts: Expected array");
+    return C4_ERROR;
+  }
+
+  *receipts = (eth_receipts_t*) req->stream;
+  if ((*receipts)->error) {
+    ctx->state.error = strdup((*receipts)->error);
+    return C4_ERROR;
+  }
+  if (!(*receipts)->trie) receipts_build(*receipts);
+  return C4_SUCCESS;
+}
+
+// the length of a hex value as rlp item. Only values of up to one byte need to be decoded for this.
+static uint32_t json_item_len(json_t val) {
+  uint8_t  tmp[8] = {0};
+  buffer_t buf    = stack_buffer(tmp);
+  if (val.type == JSON_TYPE_STRING && val.len > 6) return rlp_item_len(bytes(NULL, (val.len - 3) / 2));
+  return rlp_item_len(json_as_bytes(val, &buf));
+}
+
+// the length of the payload of a log and its topics.
+static uint32_t log_len(json_t log, uint32_t* topics_len) {
+  *topics_len = 0;
+  json_for_each_value(json_get(log, "topics"), topic) *topics_len += json_item_len(topic);
+  return json_item_len(json_get(log, "address")) + rlp_list_len(*topics_len) + json_item_len(json_get(log, "data"));
+}
+
 bytes_t c4_serialize_receipt(json_t r, buffer_t* buf) {
-  uint8_t  tmp[300]   = {0};
-  buffer_t tmp_buf    = stack_buffer(tmp);
+  uint8_t  tmp[320]   = {0};
+  buffer_t head       = stack_buffer(tmp);
   uint8_t  tmp2[32]   = {0};
   buffer_t short_buf  = stack_buffer(tmp2);
-  buffer_t topics_buf = {0};
-  buffer_t logs_buf   = {0};
-  buffer_t log_buf    = {0};
+  buffer_t data_buf   = {0};
   uint8_t  type       = json_get_uint8(r, "type");
   uint8_t  status     = json_get_uint8(r, "status");
-  bytes_t  state_root = json_get_bytes(r, "stateRoot", &tmp_buf);
+  bytes_t  state_root = json_get_bytes(r, "stateRoot", &data_buf);
+  uint32_t logs_len   = 0;
+  uint32_t topics_len = 0;
+  json_t   logs       = json_get(r, "logs");
   buffer_reset(buf);
 
+  // the fixed fields are encoded first and the lengths of the logs are taken from the hex strings,
+  // so all headers are written before their payload in one pass.
   if (state_root.len == 32)
-    rlp_add_item(buf, state_root);
+    rlp_add_item(&head, state_root);
   else
-    rlp_add_uint64(buf, (uint64_t) status);
-  rlp_add_uint64(buf, json_get_uint64(r, "cumulativeGasUsed"));
-  rlp_add_item(buf, json_get_bytes(r, "logsBloom", &tmp_buf));
+    rlp_add_uint64(&head, (uint64_t) status);
+  rlp_add_uint64(&head, json_get_uint64(r, "cumulativeGasUsed"));
+  rlp_add_item(&head, json_get_bytes(r, "logsBloom", &data_buf));
+  json_for_each_value(logs, log) logs_len += rlp_list_len(log_len(log, &topics_len));
 
-  // encode logs
-  json_for_each_value(json_get(r, "logs"), log) {
-    buffer_reset(&log_buf);
-    rlp_add_item(&log_buf, json_get_bytes(log, "address", &tmp_buf));
-
-    buffer_reset(&topics_buf);
+  uint32_t len = head.data.len + rlp_list_len(logs_len);
+  buffer_grow(buf, rlp_list_len(len) + 1);
+  if (type) buffer_add_bytes(buf, 1, type);
+  rlp_add_list_header(buf, len);
+  buffer_append(buf, head.data);
+  rlp_add_list_header(buf, logs_len);
+  json_for_each_value(logs, log) {
+    rlp_add_list_header(buf, log_len(log, &topics_len));
+    rlp_add_item(buf, json_get_bytes(log, "address", &short_buf));
+    rlp_add_list_header(buf, topics_len);
     json_for_each_value(json_get(log, "topics"), topic)
-        rlp_add_item(&topics_buf, json_as_bytes(topic, &short_buf));
-
-    rlp_add_list(&log_buf, topics_buf.data);
-    rlp_add_item(&log_buf, json_get_bytes(log, "data", &topics_buf));
-    rlp_add_list(&logs_buf, log_buf.data);
+        rlp_add_item(buf, json_as_bytes(topic, &short_buf));
+    rlp_add_item(buf, json_get_bytes(log, "data", &data_buf));
   }
-  rlp_add_list(buf, logs_buf.data);
-  rlp_to_list(buf);
-  if (type) buffer_splice(buf, 0, 0, bytes(&type, 1));
-  buffer_free(&logs_buf);
-  buffer_free(&log_buf);
-  buffer_free(&topics_buf);
+  buffer_free(&data_buf);
   return buf->data;
 }
 
 // sends a request to the eth rpc and returns the result or returns with status C4_PENDING
-c4_status_t c4_send_eth_rpc(proofer_ctx_t* ctx, char* method, char* params, json_t* result) {
+static c4_status_t send_eth_rpc(proofer_ctx_t* ctx, char* method, char* params, json_t* result, data_request_t** req) {
   bytes32_t id     = {0};
   buffer_t  buffer = {0};
   bprintf(&buffer, "{\"jsonrpc\":\"2.0\",\"method\":\"%s\",\"params\":%s,\"id\":1}", method, params);
   sha256(buffer.data, id);
   data_request_t* data_request = c4_state_get_data_request_by_id(&ctx->state, id);
+  *req                         = data_request;
   if (data_request) {
     buffer_free(&buffer);
     if (c4_state_is_pending(data_request)) return C4_PENDING;
     if (!data_request->error && data_request->response.data) {
-      json_t response = json_parse((char*) data_request->response.data);
+      c4_req_stream_response(data_request);
+      // the response is indexed once, so all following accesses to the result are constant time
+      json_t response = json_parse_indexed((char*) data_request->response.data, data_request->response.len, &data_request->json_index);
       if (response.type != JSON_TYPE_OBJECT) {
         ctx->state.error = strdup("Invalid JSON response");
         return C4_ERROR;
@@ -126,8 +237,14 @@ c4_status_t c4_send_eth_rpc(proofer_ctx_t* ctx, char* method, char* params, json
     data_request->method   = C4_DATA_METHOD_POST;
     data_request->type     = C4_DATA_TYPE_ETH_RPC;
     c4_state_add_request(&ctx->state, data_request);
+    *req = data_request;
     return C4_PENDING;
   }
 
   return C4_SUCCESS;
 }
+
+c4_status_t c4_send_eth_rpc(proofer_ctx_t* ctx, char* method, char* params, json_t* result) {
+  data_request_t* req = NULL;
+  return send_eth_rpc(ctx, method, params, result, &req);
+}
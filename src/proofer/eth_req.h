@@ -5,6 +5,7 @@
 extern "C" {
 #endif
 #include "../util/json.h"
+#include "../util/patricia.h"
 #include "../util/state.h"
 #include "../verifier/eth_tx.h"
 #include "proofer.h"
@@ -15,8 +16,22 @@ c4_status_t get_eth_tx(proofer_ctx_t* ctx, json_t txhash, json_t* tx_data);
 // get the logs
 c4_status_t eth_get_logs(proofer_ctx_t* ctx, json_t params, json_t* logs);
 
-// get the block receipts for the given block
-c4_status_t eth_getBlockReceipts(proofer_ctx_t* ctx, json_t block, json_t* receipts_array);
+// the receipts of a block, which are validated and serialized while the response is received.
+// Once the response is complete, the receipts trie is built from all of them at once.
+typedef struct {
+  data_stream_t stream;   // the stream of the request, which owns the receipts
+  node_t*       trie;     // the receipts trie
+  uint32_t      tx_index; // the index of the transaction, whose receipt is kept
+  char*         receipt;  // the json of the receipt of tx_index or NULL if not found
+  char*         error;    // the error of the first invalid receipt
+  buffer_t      rlp;      // the buffer for serializing a receipt
+  buffer_t      values;   // the serialized receipts, which are referenced by the trie
+  buffer_t      entries;  // the transaction index and length of each serialized receipt as uint32 pairs
+} eth_receipts_t;
+
+// get the receipts trie for the given block. The receipt of tx_index is kept as json (use UINT32_MAX if not needed).
+// The receipts are owned by the request and stay valid until the state is freed.
+c4_status_t eth_get_receipts_trie(proofer_ctx_t* ctx, json_t block, uint32_t tx_index, eth_receipts_t** receipts);
 
 // serialize the receipt for the given json using the buffer to allocate memory
 bytes_t c4_serialize_receipt(json_t r, buffer_t* buf);
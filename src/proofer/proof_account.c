@@ -33,9 +33,8 @@ static void add_dynamic_byte_list(json_t bytes_list, ssz_builder_t* builder, cha
   list.def           = (ssz_def_t*) &ETH_ACCOUNT_PROOF_CONTAINER.def.container.elements[0];
   buffer_t tmp       = {0};
   size_t   len       = json_len(bytes_list);
-  uint32_t offset    = 0;
-  for (size_t i = 0; i < len; i++)
-    ssz_add_dynamic_list_bytes(&list, len, json_as_bytes(json_at(bytes_list, i), &tmp));
+  json_for_each_value(bytes_list, item)
+      ssz_add_dynamic_list_bytes(&list, len, json_as_bytes(item, &tmp));
 
   ssz_ob_t list_ob = ssz_builder_to_bytes(&list);
   ssz_add_bytes(builder, name, list_ob.bytes);
@@ -131,7 +130,8 @@ c4_status_t c4_proof_account(proofer_ctx_t* ctx) {
   TRY_ASYNC(get_eth_proof(ctx, address, storage_keys,
                           &eth_proof, ssz_get_uint64(&block.execution, "blockNumber")));
 
-  bytes_t state_proof = ssz_create_proof(block.body, body_root, ssz_gindex(block.body.def, 2, "executionPayload", "stateRoot"));
+  gindex_t state_gindex = c4_chain_gindexes(ctx->chain_id, block.slot)->state_root;
+  bytes_t  state_proof  = c4_beacon_body_proof(&block, &state_gindex, 1, body_root);
 
   TRY_ASYNC_FINAL(
       create_eth_account_proof(ctx, eth_proof, &block, body_root, state_proof, address),
@@ -18,7 +18,6 @@ typedef struct proof_logs_tx {
   uint64_t              block_number;
   bytes32_t             tx_hash;
   uint32_t              tx_index;
-  ssz_ob_t              proof;
   bytes_t               raw_tx;
   struct proof_logs_tx* next;
 } proof_logs_tx_t;
@@ -27,8 +26,9 @@ typedef struct proof_logs_block {
   uint64_t                 block_number;
   bytes_t                  block_hash;
   bytes_t                  proof;
+  ssz_ob_t                 receipt_proof;
   struct proof_logs_block* next;
-  json_t                   block_receipts;
+  eth_receipts_t*          receipts;
   proof_logs_tx_t*         txs;
   uint32_t                 tx_count;
   beacon_block_t           beacon_block;
@@ -47,12 +47,12 @@ static inline uint32_t get_block_count(proof_logs_block_t* blocks) {
 static void free_blocks(proof_logs_block_t* blocks) {
   while (blocks) {
     while (blocks->txs) {
-      if (blocks->txs->proof.bytes.data) free(blocks->txs->proof.bytes.data);
       proof_logs_tx_t* next = blocks->txs->next;
       free(blocks->txs);
       blocks->txs = next;
     }
     if (blocks->proof.data) free(blocks->proof.data);
+    if (blocks->receipt_proof.bytes.data) free(blocks->receipt_proof.bytes.data);
     proof_logs_block_t* next = blocks->next;
     free(blocks);
     blocks = next;
@@ -101,93 +101,81 @@ static c4_status_t get_receipts(proofer_ctx_t* ctx, proof_logs_block_t* blocks)
     buffer_reset(&buf);
     json_t block_number = json_parse(bprintf(&buf, "\"0x%lx\"", block->block_number));
     TRY_ADD_ASYNC(status, c4_beacon_get_block_for_eth(ctx, block_number, &block->beacon_block));
-    TRY_ADD_ASYNC(status, eth_getBlockReceipts(ctx, block_number, &block->block_receipts));
+    TRY_ADD_ASYNC(status, eth_get_receipts_trie(ctx, block_number, UINT32_MAX, &block->receipts));
   }
   return status;
 }
 
 static c4_status_t proof_create_multiproof(proofer_ctx_t* ctx, proof_logs_block_t* block) {
 
-  int       i      = 0;
-  gindex_t* gindex = calloc(3 + block->tx_count, sizeof(gindex_t));
-  gindex[0]        = ssz_gindex(block->beacon_block.body.def, 2, "executionPayload", "blockNumber");
-  gindex[1]        = ssz_gindex(block->beacon_block.body.def, 2, "executionPayload", "blockHash");
-  gindex[2]        = ssz_gindex(block->beacon_block.body.def, 2, "executionPayload", "receiptsRoot");
+  int                  i       = 0;
+  const c4_gindexes_t* indexes = c4_chain_gindexes(ctx->chain_id, block->beacon_block.slot);
+  gindex_t*            gindex  = calloc(3 + block->tx_count, sizeof(gindex_t));
+  gindex[0]                    = indexes->block_number;
+  gindex[1]                    = indexes->block_hash;
+  gindex[2]                    = indexes->receipts_root;
   for (proof_logs_tx_t* tx = block->txs; tx; tx = tx->next, i++)
-    gindex[i + 3] = ssz_gindex(block->beacon_block.body.def, 3, "executionPayload", "transactions", tx->tx_index);
+    gindex[i + 3] = indexes->transactions + tx->tx_index;
 
-  block->proof = ssz_create_multi_proof_for_gindexes(block->beacon_block.body, block->body_root, gindex, 3 + block->tx_count);
+  block->proof = c4_beacon_body_proof(&block->beacon_block, gindex, 3 + block->tx_count, block->body_root);
   free(gindex);
 
   return C4_SUCCESS;
 }
 
 static c4_status_t proof_block(proofer_ctx_t* ctx, proof_logs_block_t* block) {
-  node_t*   root         = NULL;
-  bytes32_t tmp          = {0};
-  buffer_t  receipts_buf = {0};
-  buffer_t  buf          = stack_buffer(tmp);
+  bytes_t* paths = calloc(block->tx_count, sizeof(bytes_t));
+  uint8_t* tmp   = calloc(block->tx_count, 8);
+  int      i     = 0;
 
   block->block_hash = ssz_get(&block->beacon_block.execution, "blockHash").bytes;
 
-  // create receipts tree
-  json_for_each_value(block->block_receipts, r)
-      patricia_set_value(&root,
-                         c4_eth_create_tx_path(json_get_uint32(r, "transactionIndex"), &buf),
-                         c4_serialize_receipt(r, &receipts_buf));
-
-  // create receipts proofs
-  for (proof_logs_tx_t* tx = block->txs; tx; tx = tx->next) {
-    tx->proof  = patricia_create_merkle_proof(root, c4_eth_create_tx_path(tx->tx_index, &buf));
-    tx->raw_tx = ssz_at(ssz_get(&block->beacon_block.execution, "transactions"), tx->tx_index).bytes;
+  // create one receipts proof for all txs from the receipts trie, so shared nodes are only included once
+  for (proof_logs_tx_t* tx = block->txs; tx; tx = tx->next, i++) {
+    buffer_t buf = {.data = bytes(tmp + i * 8, 0), .allocated = -8};
+    paths[i]     = c4_eth_create_tx_path(tx->tx_index, &buf);
+    tx->raw_tx   = ssz_at(ssz_get(&block->beacon_block.execution, "transactions"), tx->tx_index).bytes;
   }
+  block->receipt_proof = patricia_create_multi_proof(block->receipts->trie, paths, block->tx_count);
+  free(paths);
+  free(tmp);
 
   // create multiproof for the transactions
   proof_create_multiproof(ctx, block);
-  patricia_node_free(root);
-  buffer_free(&buf);
-  buffer_free(&receipts_buf);
 
   return C4_SUCCESS;
 }
 
 static c4_status_t serialize_log_proof(proofer_ctx_t* ctx, proof_logs_block_t* blocks, json_t logs) {
 
-  buffer_t      tmp         = {0};
-  ssz_builder_t c4_req      = ssz_builder_for(C4_REQUEST_CONTAINER);
-  ssz_builder_t block_list  = {0};
-  uint32_t      block_count = get_block_count(blocks);
-  ssz_def_t     txs_def     = SSZ_LIST("txs", ETH_LOGS_TX_CONTAINER, 256);
-
-  ssz_add_uniondef(&block_list, C4_REQUEST_PROOFS_UNION, "LogsProof");
-  for (proof_logs_block_t* block = blocks; block; block = block->next) {
-    ssz_builder_t block_ssz = ssz_builder_for(ETH_LOGS_BLOCK_CONTAINER);
-    ssz_add_uint64(&block_ssz, block->block_number);
-    ssz_add_bytes(&block_ssz, "blockHash", block->block_hash);
-    ssz_add_bytes(&block_ssz, "proof", block->proof);
-    ssz_add_builders(&block_ssz, "header", c4_proof_add_header(block->beacon_block.header, block->body_root));
-    ssz_add_bytes(&block_ssz, "sync_committee_bits", ssz_get(&block->beacon_block.sync_aggregate, "syncCommitteeBits").bytes);
-    ssz_add_bytes(&block_ssz, "sync_committee_signature", ssz_get(&block->beacon_block.sync_aggregate, "syncCommitteeSignature").bytes);
-
-    ssz_builder_t tx_list = ssz_builder_for(txs_def);
-    for (proof_logs_tx_t* tx = block->txs; tx; tx = tx->next) {
-      ssz_builder_t tx_ssz = ssz_builder_for(ETH_LOGS_TX_CONTAINER);
-      ssz_add_bytes(&tx_ssz, "transaction", tx->raw_tx);
-      ssz_add_uint32(&tx_ssz, tx->tx_index);
-      ssz_add_bytes(&tx_ssz, "proof", tx->proof.bytes);
-      ssz_add_dynamic_list_builders(&tx_list, block->tx_count, tx_ssz);
+  buffer_t    tmp        = {0};
+  ssz_node_t  c4_req     = ssz_node(&C4_REQUEST_CONTAINER);
+  ssz_node_t* block_list = ssz_node_select(ssz_node_get(&c4_req, "proof"), "LogsProof");
+  ssz_node_t* block_ssz  = ssz_node_add_elements(block_list, get_block_count(blocks));
+
+  // all values are only referenced and written once into the final proof
+  for (proof_logs_block_t* block = blocks; block; block = block->next, block_ssz++) {
+    ssz_node_set_uint(block_ssz, "blockNumber", block->block_number);
+    ssz_node_set_bytes(block_ssz, "blockHash", block->block_hash);
+    ssz_node_set_bytes(block_ssz, "proof", block->proof);
+    c4_proof_set_header(ssz_node_get(block_ssz, "header"), block->beacon_block.header, block->body_root);
+    ssz_node_set_bytes(block_ssz, "sync_committee_bits", ssz_get(&block->beacon_block.sync_aggregate, "syncCommitteeBits").bytes);
+    ssz_node_set_bytes(block_ssz, "sync_committee_signature", ssz_get(&block->beacon_block.sync_aggregate, "syncCommitteeSignature").bytes);
+
+    ssz_node_t* tx_ssz = ssz_node_add_elements(ssz_node_get(block_ssz, "txs"), block->tx_count);
+    for (proof_logs_tx_t* tx = block->txs; tx; tx = tx->next, tx_ssz++) {
+      ssz_node_set_bytes(tx_ssz, "transaction", tx->raw_tx);
+      ssz_node_set_uint(tx_ssz, "transactionIndex", tx->tx_index);
     }
-    ssz_add_builders(&block_ssz, "txs", tx_list);
-    ssz_add_dynamic_list_builders(&block_list, block_count, block_ssz);
+    ssz_node_set_bytes(block_ssz, "receipt_proof", block->receipt_proof.bytes);
   }
 
   // build the request
-  ssz_add_bytes(&c4_req, "version", bytes(c4_version_bytes, 4));
-  ssz_add_bytes(&c4_req, "data", c4_proofer_add_data(logs, "EthLogs", &tmp));
-  ssz_add_builders(&c4_req, "proof", block_list);
-  ssz_add_bytes(&c4_req, "sync_data", bytes(NULL, 1));
+  ssz_node_set_bytes(&c4_req, "version", bytes(c4_version_bytes, 4));
+  ssz_node_set_bytes(&c4_req, "data", c4_proofer_add_data(logs, "EthLogs", &tmp));
+  ssz_node_set_bytes(&c4_req, "sync_data", bytes(NULL, 1));
 
-  ctx->proof = ssz_builder_to_bytes(&c4_req).bytes;
+  ctx->proof = ssz_node_to_bytes(&c4_req).bytes;
 
   buffer_free(&tmp);
   return C4_SUCCESS;
@@ -16,61 +16,42 @@
 
 static c4_status_t create_eth_receipt_proof(proofer_ctx_t* ctx, beacon_block_t* block_data, bytes32_t body_root, ssz_ob_t receipt_proof, json_t receipt, bytes_t tx_proof) {
 
-  buffer_t      tmp          = {0};
-  ssz_builder_t eth_tx_proof = {0};
-  ssz_builder_t c4_req       = {.def = (ssz_def_t*) &C4_REQUEST_CONTAINER, .dynamic = {0}, .fixed = {0}};
-  uint32_t      tx_index     = json_get_uint32(receipt, "transactionIndex");
+  buffer_t    tmp          = {0};
+  buffer_t    block_hash   = {0};
+  ssz_node_t  c4_req       = ssz_node(&C4_REQUEST_CONTAINER);
+  ssz_node_t* eth_tx_proof = ssz_node_select(ssz_node_get(&c4_req, "proof"), "ReceiptProof");
+  uint32_t    tx_index     = json_get_uint32(receipt, "transactionIndex");
 
   // build the proof
-  ssz_add_uint8(&eth_tx_proof, ssz_union_selector_index(C4_REQUEST_PROOFS_UNION, "ReceiptProof", &eth_tx_proof.def));
-  ssz_add_bytes(&eth_tx_proof, "transaction", ssz_at(ssz_get(&block_data->execution, "transactions"), tx_index).bytes);
-  ssz_add_uint32(&eth_tx_proof, tx_index);
-  ssz_add_uint64(&eth_tx_proof, json_get_uint64(receipt, "blockNumber"));
-  ssz_add_bytes(&eth_tx_proof, "blockHash", json_get_bytes(receipt, "blockHash", &tmp));
-  ssz_add_bytes(&eth_tx_proof, "receipt_proof", receipt_proof.bytes);
-  ssz_add_bytes(&eth_tx_proof, "block_proof", tx_proof);
-  ssz_add_builders(&eth_tx_proof, "header", c4_proof_add_header(block_data->header, body_root));
-  ssz_add_bytes(&eth_tx_proof, "sync_committee_bits", ssz_get(&block_data->sync_aggregate, "syncCommitteeBits").bytes);
-  ssz_add_bytes(&eth_tx_proof, "sync_committee_signature", ssz_get(&block_data->sync_aggregate, "syncCommitteeSignature").bytes);
+  ssz_node_set_bytes(eth_tx_proof, "transaction", ssz_at(ssz_get(&block_data->execution, "transactions"), tx_index).bytes);
+  ssz_node_set_uint(eth_tx_proof, "transactionIndex", tx_index);
+  ssz_node_set_uint(eth_tx_proof, "blockNumber", json_get_uint64(receipt, "blockNumber"));
+  ssz_node_set_bytes(eth_tx_proof, "blockHash", json_get_bytes(receipt, "blockHash", &block_hash));
+  ssz_node_set_bytes(eth_tx_proof, "receipt_proof", receipt_proof.bytes);
+  ssz_node_set_bytes(eth_tx_proof, "block_proof", tx_proof);
+  c4_proof_set_header(ssz_node_get(eth_tx_proof, "header"), block_data->header, body_root);
+  ssz_node_set_bytes(eth_tx_proof, "sync_committee_bits", ssz_get(&block_data->sync_aggregate, "syncCommitteeBits").bytes);
+  ssz_node_set_bytes(eth_tx_proof, "sync_committee_signature", ssz_get(&block_data->sync_aggregate, "syncCommitteeSignature").bytes);
 
   // build the request
-  ssz_add_bytes(&c4_req, "version", bytes(c4_version_bytes, 4));
-  ssz_add_bytes(&c4_req, "data", c4_proofer_add_data(receipt, "EthReceiptData", &tmp));
-  ssz_add_builders(&c4_req, "proof", eth_tx_proof);
-  ssz_add_bytes(&c4_req, "sync_data", bytes(NULL, 1));
+  ssz_node_set_bytes(&c4_req, "version", bytes(c4_version_bytes, 4));
+  ssz_node_set_bytes(&c4_req, "data", c4_proofer_add_data(receipt, "EthReceiptData", &tmp));
+  ssz_node_set_bytes(&c4_req, "sync_data", bytes(NULL, 1));
 
+  ctx->proof = ssz_node_to_bytes(&c4_req).bytes;
   buffer_free(&tmp);
-  ctx->proof = ssz_builder_to_bytes(&c4_req).bytes;
+  buffer_free(&block_hash);
   return C4_SUCCESS;
 }
 
-static ssz_ob_t create_receipts_proof(json_t block_receipts, uint32_t tx_index, json_t* receipt) {
-  node_t*   root         = NULL;
-  bytes32_t tmp          = {0};
-  buffer_t  receipts_buf = {0};
-  buffer_t  buf          = stack_buffer(tmp);
-
-  json_for_each_value(block_receipts, r) {
-    uint32_t index = json_get_uint32(r, "transactionIndex");
-    if (index == tx_index) *receipt = r;
-    patricia_set_value(&root, c4_eth_create_tx_path(index, &buf), c4_serialize_receipt(r, &receipts_buf));
-  }
-
-  ssz_ob_t proof = patricia_create_merkle_proof(root, c4_eth_create_tx_path(tx_index, &buf));
-
-  patricia_node_free(root);
-  buffer_free(&buf);
-  buffer_free(&receipts_buf);
-  return proof;
-}
-
 c4_status_t c4_proof_receipt(proofer_ctx_t* ctx) {
-  json_t         txhash         = json_at(ctx->params, 0);
-  json_t         tx_data        = {0};
-  json_t         block_receipts = {0};
-  beacon_block_t block          = {0};
-  json_t         receipt        = {0};
-  bytes32_t      body_root      = {0};
+  json_t          txhash    = json_at(ctx->params, 0);
+  json_t          tx_data   = {0};
+  eth_receipts_t* receipts  = NULL;
+  beacon_block_t  block     = {0};
+  bytes32_t       body_root = {0};
+  bytes32_t       tmp       = {0};
+  buffer_t        buf       = stack_buffer(tmp);
 
   CHECK_JSON(txhash, "bytes32", "Invalid arguments for Tx: ");
 
@@ -81,16 +62,14 @@ c4_status_t c4_proof_receipt(proofer_ctx_t* ctx) {
 
   TRY_2_ASYNC(
       c4_beacon_get_block_for_eth(ctx, block_number, &block),
-      eth_getBlockReceipts(ctx, block_number, &block_receipts));
-
-  ssz_ob_t receipt_proof = create_receipts_proof(block_receipts, tx_index, &receipt);
-  bytes_t  state_proof   = ssz_create_multi_proof(block.body, body_root, 4,
-                                                  ssz_gindex(block.body.def, 2, "executionPayload", "blockNumber"),
-                                                  ssz_gindex(block.body.def, 2, "executionPayload", "blockHash"),
-                                                  ssz_gindex(block.body.def, 2, "executionPayload", "receiptsRoot"),
-                                                  ssz_gindex(block.body.def, 3, "executionPayload", "transactions", tx_index)
+      eth_get_receipts_trie(ctx, block_number, tx_index, &receipts));
 
-     );
+  if (!receipts->receipt) THROW_ERROR("Receipt not found in block receipts");
+  json_t               receipt       = json_parse(receipts->receipt);
+  ssz_ob_t             receipt_proof = patricia_create_merkle_proof(receipts->trie, c4_eth_create_tx_path(tx_index, &buf));
+  const c4_gindexes_t* gindex        = c4_chain_gindexes(ctx->chain_id, block.slot);
+  gindex_t             gindexes[]    = {gindex->block_number, gindex->block_hash, gindex->receipts_root, gindex->transactions + tx_index};
+  bytes_t state_proof = c4_beacon_body_proof(&block, gindexes, 4, body_root);
 
   TRY_ASYNC_FINAL(
       create_eth_receipt_proof(ctx, &block, body_root, receipt_proof, receipt, state_proof),
@@ -98,4 +77,4 @@ c4_status_t c4_proof_receipt(proofer_ctx_t* ctx) {
       free(state_proof.data);
       free(receipt_proof.bytes.data));
   return C4_SUCCESS;
-}
\ No newline at end of file
+}
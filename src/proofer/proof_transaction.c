@@ -66,12 +66,9 @@ c4_status_t c4_proof_transaction(proofer_ctx_t* ctx) {
 
   TRY_ASYNC(c4_beacon_get_block_for_eth(ctx, block_number, &block));
 
-  bytes_t state_proof = ssz_create_multi_proof(block.body, body_root, 3,
-                                               ssz_gindex(block.body.def, 2, "executionPayload", "blockNumber"),
-                                               ssz_gindex(block.body.def, 2, "executionPayload", "blockHash"),
-                                               ssz_gindex(block.body.def, 3, "executionPayload", "transactions", tx_index)
-
-  );
+  const c4_gindexes_t* gindex      = c4_chain_gindexes(ctx->chain_id, block.slot);
+  gindex_t             gindexes[]  = {gindex->block_number, gindex->block_hash, gindex->transactions + tx_index};
+  bytes_t              state_proof = c4_beacon_body_proof(&block, gindexes, 3, body_root);
   TRY_ASYNC_FINAL(
       create_eth_tx_proof(ctx, tx_data, &block, body_root, state_proof),
       free(state_proof.data));
@@ -139,43 +139,199 @@ void buffer_free(buffer_t* buffer) {
     free(buffer->data.data);
 }
 
-void print_hex(FILE* f, bytes_t data, char* prefix, char* suffix) {
-  if (prefix) fprintf(f, "%s", prefix);
-  for (uint32_t i = 0; i < data.len; i++)
-    fprintf(f, "%02x", data.data[i]);
-  if (suffix) fprintf(f, "%s", suffix);
-}
-
 bool bytes_all_equal(bytes_t a, uint8_t value) {
   for (uint32_t i = 0; i < a.len; i++)
     if (a.data[i] != value) return false;
   return true;
 }
 
+// hex encoding and decoding uses table-free simd kernels converting 16 bytes at once:
+//
+//   - x86 SSE2
+//   - ARMv8 NEON
+//   - WASM SIMD128 (if built with -msimd128)
+//
+// Embedded builds and the remaining bytes use the scalar conversion.
+
+#if !defined(EMBEDDED) && defined(__GNUC__)
+#if defined(__SSE2__)
+#define HEX_SSE2
+#include <emmintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#define HEX_NEON
+#include <arm_neon.h>
+#elif defined(__wasm_simd128__)
+#define HEX_WASM
+#include <wasm_simd128.h>
+#endif
+#endif
+
 static inline int hexchar_to_int(char c) {
-  if (isdigit(c)) return c - '0';
-  if (isxdigit(c)) return tolower(c) - 'a' + 10;
-  return -1; // Ungültiges Zeichen
+  uint8_t d = (uint8_t) c - '0';
+  uint8_t l = ((uint8_t) c | 0x20) - 'a';
+  if (d < 10) return d;
+  if (l < 6) return l + 10;
+  return -1; // invalid char
+}
+
+static inline char int_to_hexchar(uint8_t n) {
+  return (char) (n + '0' + (n > 9 ? 'a' - '0' - 10 : 0));
+}
+
+#ifdef HEX_SSE2
+// converts 16 chars into their nibble values and clears valid, if one of them is not a hex char
+static inline __m128i hex_nibbles(__m128i c, bool* valid) {
+  __m128i d        = _mm_sub_epi8(c, _mm_set1_epi8('0'));
+  __m128i l        = _mm_sub_epi8(_mm_or_si128(c, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+  __m128i is_digit = _mm_and_si128(_mm_cmpgt_epi8(d, _mm_set1_epi8(-1)), _mm_cmplt_epi8(d, _mm_set1_epi8(10)));
+  __m128i is_alpha = _mm_and_si128(_mm_cmpgt_epi8(l, _mm_set1_epi8(-1)), _mm_cmplt_epi8(l, _mm_set1_epi8(6)));
+  *valid &= _mm_movemask_epi8(_mm_or_si128(is_digit, is_alpha)) == 0xFFFF;
+  return _mm_or_si128(_mm_and_si128(is_digit, d), _mm_and_si128(is_alpha, _mm_add_epi8(l, _mm_set1_epi8(10))));
+}
+
+// joins the pairs of nibbles (high nibble first) into 8 bytes stored in the 16-bit lanes
+static inline __m128i hex_join(__m128i n) {
+  return _mm_or_si128(_mm_slli_epi16(_mm_and_si128(n, _mm_set1_epi16(0xff)), 4), _mm_srli_epi16(n, 8));
+}
+
+static inline __m128i hex_chars(__m128i n) {
+  __m128i alpha = _mm_and_si128(_mm_cmpgt_epi8(n, _mm_set1_epi8(9)), _mm_set1_epi8('a' - '0' - 10));
+  return _mm_add_epi8(_mm_add_epi8(n, _mm_set1_epi8('0')), alpha);
+}
+
+static inline bool hex_decode16(const char* hex, uint8_t* out) {
+  bool    valid = true;
+  __m128i a     = hex_nibbles(_mm_loadu_si128((const __m128i*) hex), &valid);
+  __m128i b     = hex_nibbles(_mm_loadu_si128((const __m128i*) (hex + 16)), &valid);
+  _mm_storeu_si128((__m128i*) out, _mm_packus_epi16(hex_join(a), hex_join(b)));
+  return valid;
+}
+
+static inline void hex_encode16(const uint8_t* data, char* out) {
+  __m128i x  = _mm_loadu_si128((const __m128i*) data);
+  __m128i hi = _mm_and_si128(_mm_srli_epi16(x, 4), _mm_set1_epi8(0x0f));
+  __m128i lo = _mm_and_si128(x, _mm_set1_epi8(0x0f));
+  _mm_storeu_si128((__m128i*) out, hex_chars(_mm_unpacklo_epi8(hi, lo)));
+  _mm_storeu_si128((__m128i*) (out + 16), hex_chars(_mm_unpackhi_epi8(hi, lo)));
+}
+#elif defined(HEX_NEON)
+static inline uint8x16_t hex_nibbles(uint8x16_t c, bool* valid) {
+  uint8x16_t d        = vsubq_u8(c, vdupq_n_u8('0'));
+  uint8x16_t l        = vsubq_u8(vorrq_u8(c, vdupq_n_u8(0x20)), vdupq_n_u8('a'));
+  uint8x16_t is_digit = vcltq_u8(d, vdupq_n_u8(10));
+  *valid &= vminvq_u8(vorrq_u8(is_digit, vcltq_u8(l, vdupq_n_u8(6)))) == 0xFF;
+  return vbslq_u8(is_digit, d, vaddq_u8(l, vdupq_n_u8(10)));
+}
+
+static inline uint8x16_t hex_chars(uint8x16_t n) {
+  uint8x16_t alpha = vandq_u8(vcgtq_u8(n, vdupq_n_u8(9)), vdupq_n_u8('a' - '0' - 10));
+  return vaddq_u8(vaddq_u8(n, vdupq_n_u8('0')), alpha);
+}
+
+static inline bool hex_decode16(const char* hex, uint8_t* out) {
+  bool        valid = true;
+  uint8x16x2_t c    = vld2q_u8((const uint8_t*) hex);
+  uint8x16_t  hi    = hex_nibbles(c.val[0], &valid);
+  uint8x16_t  lo    = hex_nibbles(c.val[1], &valid);
+  vst1q_u8(out, vorrq_u8(vshlq_n_u8(hi, 4), lo));
+  return valid;
+}
+
+static inline void hex_encode16(const uint8_t* data, char* out) {
+  uint8x16_t   x = vld1q_u8(data);
+  uint8x16x2_t r = {{hex_chars(vshrq_n_u8(x, 4)), hex_chars(vandq_u8(x, vdupq_n_u8(0x0f)))}};
+  vst2q_u8((uint8_t*) out, r);
+}
+#elif defined(HEX_WASM)
+static inline v128_t hex_nibbles(v128_t c, bool* valid) {
+  v128_t d        = wasm_i8x16_sub(c, wasm_i8x16_splat('0'));
+  v128_t l        = wasm_i8x16_sub(wasm_v128_or(c, wasm_i8x16_splat(0x20)), wasm_i8x16_splat('a'));
+  v128_t is_digit = wasm_u8x16_lt(d, wasm_i8x16_splat(10));
+  *valid &= wasm_i8x16_all_true(wasm_v128_or(is_digit, wasm_u8x16_lt(l, wasm_i8x16_splat(6))));
+  return wasm_v128_bitselect(d, wasm_i8x16_add(l, wasm_i8x16_splat(10)), is_digit);
+}
+
+static inline v128_t hex_join(v128_t n) {
+  return wasm_v128_or(wasm_i16x8_shl(wasm_v128_and(n, wasm_i16x8_splat(0xff)), 4), wasm_u16x8_shr(n, 8));
+}
+
+static inline v128_t hex_chars(v128_t n) {
+  v128_t alpha = wasm_v128_and(wasm_u8x16_gt(n, wasm_i8x16_splat(9)), wasm_i8x16_splat('a' - '0' - 10));
+  return wasm_i8x16_add(wasm_i8x16_add(n, wasm_i8x16_splat('0')), alpha);
+}
+
+static inline bool hex_decode16(const char* hex, uint8_t* out) {
+  bool   valid = true;
+  v128_t a     = hex_nibbles(wasm_v128_load(hex), &valid);
+  v128_t b     = hex_nibbles(wasm_v128_load(hex + 16), &valid);
+  wasm_v128_store(out, wasm_u8x16_narrow_i16x8(hex_join(a), hex_join(b)));
+  return valid;
+}
+
+static inline void hex_encode16(const uint8_t* data, char* out) {
+  v128_t x  = wasm_v128_load(data);
+  v128_t hi = wasm_u8x16_shr(x, 4);
+  v128_t lo = wasm_v128_and(x, wasm_i8x16_splat(0x0f));
+  wasm_v128_store(out, hex_chars(wasm_i8x16_shuffle(hi, lo, 0, 16, 1, 17, 2, 18, 3, 19, 4, 20, 5, 21, 6, 22, 7, 23)));
+  wasm_v128_store(out + 16, hex_chars(wasm_i8x16_shuffle(hi, lo, 8, 24, 9, 25, 10, 26, 11, 27, 12, 28, 13, 29, 14, 30, 15, 31)));
+}
+#endif
+
+// decodes 2*len hex chars into len bytes and returns false if one of them is not a hex char
+static bool hex_decode(const char* hex, size_t len, uint8_t* out) {
+  size_t i = 0;
+#if defined(HEX_SSE2) || defined(HEX_NEON) || defined(HEX_WASM)
+  for (; i + 16 <= len; i += 16)
+    if (!hex_decode16(hex + i * 2, out + i)) return false;
+#endif
+  for (; i < len; i++) {
+    int high = hexchar_to_int(hex[i * 2]);
+    int low  = hexchar_to_int(hex[i * 2 + 1]);
+    if (high == -1 || low == -1) return false;
+    out[i] = (high << 4) | low;
+  }
+  return true;
+}
+
+// encodes len bytes as 2*len lowercase hex chars
+static void hex_encode(const uint8_t* data, size_t len, char* out) {
+  size_t i = 0;
+#if defined(HEX_SSE2) || defined(HEX_NEON) || defined(HEX_WASM)
+  for (; i + 16 <= len; i += 16) hex_encode16(data + i, out + i * 2);
+#endif
+  for (; i < len; i++) {
+    out[i * 2]     = int_to_hexchar(data[i] >> 4);
+    out[i * 2 + 1] = int_to_hexchar(data[i] & 0x0f);
+  }
 }
 
 int hex_to_bytes(const char* hexstring, int len, bytes_t buffer) {
-  size_t hex_len = len == -1 ? strlen(hexstring) : (size_t) len;
   if (!hexstring || !buffer.data) return -1;
-  int dst_offset = hex_len % 2;
-  int src_offset = (hexstring[0] == '0' && hexstring[1] == 'x') ? 2 : 0;
-  if (dst_offset) buffer.data[0] = hexchar_to_int(hexstring[src_offset++]);
+  size_t hex_len    = len == -1 ? strlen(hexstring) : (size_t) len;
+  int    dst_offset = hex_len % 2;
+  int    src_offset = (hex_len > 1 && hexstring[0] == '0' && hexstring[1] == 'x') ? 2 : 0;
+  if (dst_offset) {
+    int first = hex_len > (size_t) src_offset ? hexchar_to_int(hexstring[src_offset++]) : -1;
+    if (first == -1 || !buffer.len) return -1;
+    buffer.data[0] = first;
+  }
 
   if ((hex_len - src_offset) % 2 || (buffer.len - dst_offset) < (hex_len - src_offset) / 2)
     return -1;
 
-  for (size_t i = src_offset; i < hex_len; i += 2) {
-    int high = hexchar_to_int(hexstring[i]);
-    int low  = hexchar_to_int(hexstring[i + 1]);
-    if (high == -1 || low == -1) return -1;
-    buffer.data[dst_offset++] = (high << 4) | low;
-  }
+  if (!hex_decode(hexstring + src_offset, (hex_len - src_offset) / 2, buffer.data + dst_offset)) return -1;
+  return dst_offset + (hex_len - src_offset) / 2;
+}
 
-  return dst_offset;
+void print_hex(FILE* f, bytes_t data, char* prefix, char* suffix) {
+  if (prefix) fprintf(f, "%s", prefix);
+  char tmp[128];
+  for (uint32_t i = 0; i < data.len; i += sizeof(tmp) / 2) {
+    uint32_t n = data.len - i < sizeof(tmp) / 2 ? data.len - i : sizeof(tmp) / 2;
+    hex_encode(data.data + i, n, tmp);
+    fwrite(tmp, 1, n * 2, f);
+  }
+  if (suffix) fprintf(f, "%s", suffix);
 }
 
 void buffer_add_chars(buffer_t* buffer, const char* data) {
@@ -189,13 +345,17 @@ void buffer_add_hex_chars(buffer_t* buffer, bytes_t data, char* prefix, char* su
   uint32_t len = data.len * 2 + (prefix ? strlen(prefix) : 0) + (suffix ? strlen(suffix) : 0);
   buffer_grow(buffer, buffer->data.len + len + 1);
   buffer_add_chars(buffer, prefix);
-  char tmp[4];
+  char tmp[128];
 
-  for (size_t i = 0; i < data.len; i++) {
-    sprintf(tmp, "%02x", data.data[i]);
-    buffer_add_chars(buffer, tmp);
+  for (uint32_t i = 0; i < data.len; i += sizeof(tmp) / 2) {
+    uint32_t n = data.len - i < sizeof(tmp) / 2 ? data.len - i : sizeof(tmp) / 2;
+    hex_encode(data.data + i, n, tmp);
+    buffer_append(buffer, bytes((uint8_t*) tmp, n * 2));
   }
-  buffer_add_chars(buffer, suffix);
+  if (suffix)
+    buffer_add_chars(buffer, suffix);
+  else if (buffer_append(buffer, bytes(NULL, 1)))
+    buffer->data.len--; // keep it terminated
 }
 
 bytes_t bytes_dup(bytes_t data) {
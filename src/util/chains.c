@@ -4,32 +4,95 @@
 
 const uint64_t eth_mainnet_fork_epochs[] = {74240, 144896, 194048, 269568, 0};
 
-bool c4_chain_genesis_validators_root(chain_id_t chain_id, bytes32_t genesis_validators_root) {
-  void* hash;
-  switch (chain_id) {
-    case C4_CHAIN_MAINNET:
-      hash = "\x4b\x36\x3d\xb9\x4e\x28\x61\x20\xd7\x6e\xb9\x05\x34\x0f\xdd\x4e\x54\xbf\xe9\xf0\x6b\xf3\x3f\xf6\xcf\x5a\xd2\x7f\x51\x1b\xfe\x95";
-      break;
+// the hash_tree_root of the ForkData (fork version, genesis_validators_root) for each fork, which starts with the fork digest
+static const bytes32_t eth_mainnet_fork_data_roots[] = {
+    {0xb5, 0x30, 0x3f, 0x2a, 0xd2, 0x01, 0x0d, 0x69, 0x9a, 0x76, 0xc8, 0xe6, 0x23, 0x50, 0x94, 0x74, 0x21, 0xa3, 0xe4, 0xa9, 0x79, 0x77, 0x96, 0x42, 0xcf, 0xdb, 0x0f, 0x66, 0x68, 0x98, 0x6b, 0x25}, // phase0
+    {0xaf, 0xca, 0xab, 0xa0, 0xef, 0xab, 0x1c, 0xa8, 0x32, 0xa1, 0x51, 0x52, 0x46, 0x9b, 0xb0, 0x9b, 0xb8, 0x46, 0x41, 0xc4, 0x05, 0x17, 0x1d, 0xfa, 0x2d, 0x3f, 0xb4, 0x5f, 0x2b, 0xd8, 0xdd, 0xb9}, // altair
+    {0x4a, 0x26, 0xc5, 0x8b, 0x08, 0xad, 0xd8, 0x08, 0x9b, 0x75, 0xca, 0xa5, 0x40, 0x84, 0x88, 0x81, 0xa8, 0xd4, 0xf0, 0xaf, 0x0b, 0xe8, 0x34, 0x17, 0xa8, 0x5c, 0x0f, 0x45, 0x8c, 0xa6, 0x7c, 0xd1}, // bellatrix
+    {0xbb, 0xa4, 0xda, 0x96, 0x35, 0x4c, 0x9f, 0x25, 0x47, 0x6c, 0xf1, 0xbc, 0x69, 0xbf, 0x58, 0x3a, 0x7f, 0x9e, 0x0a, 0xf0, 0x49, 0x30, 0x5b, 0x62, 0xde, 0x67, 0x66, 0x40, 0xe8, 0x4b, 0x38, 0x99}, // capella
+    {0x6a, 0x95, 0xa1, 0xa9, 0x67, 0x85, 0x5d, 0x67, 0x6d, 0x48, 0xbe, 0x69, 0x88, 0x3b, 0x71, 0x26, 0x07, 0xf9, 0x52, 0xd5, 0x19, 0x8d, 0x0f, 0x56, 0x77, 0x56, 0x46, 0x36, 0xf3, 0x65, 0xac, 0x53}, // deneb
+    {0xad, 0x53, 0x2c, 0xeb, 0x9e, 0xc5, 0xd2, 0x46, 0xda, 0xad, 0x29, 0xda, 0x8a, 0xa1, 0x57, 0xbf, 0xda, 0xb3, 0x5e, 0x5f, 0x06, 0x9f, 0x9d, 0xb8, 0x1f, 0x1d, 0xa7, 0x54, 0xd7, 0xb0, 0xbe, 0x65}, // electra
+    {0x82, 0xfa, 0xe5, 0x41, 0xf8, 0xa3, 0xdb, 0x43, 0xad, 0xb5, 0xe7, 0x99, 0x7a, 0xc5, 0xf5, 0x62, 0xcf, 0x68, 0x2c, 0xe6, 0xbc, 0x41, 0xb8, 0xec, 0x28, 0xba, 0x1a, 0x07, 0x41, 0x3b, 0x84, 0x0b}, // fulu
+};
+
+typedef struct {
+  const uint8_t*   genesis_validators_root;
+  const uint64_t*  fork_epochs;     // the first epoch of each fork after phase0, terminated by 0
+  uint32_t         fork_count;      // the number of fork epochs
+  const bytes32_t* fork_data_roots; // one per fork up to C4_FORK_FULU
+} chain_spec_t;
 
-    default: return false;
+static const chain_spec_t eth_mainnet = {
+    .genesis_validators_root = (const uint8_t*) "\x4b\x36\x3d\xb9\x4e\x28\x61\x20\xd7\x6e\xb9\x05\x34\x0f\xdd\x4e\x54\xbf\xe9\xf0\x6b\xf3\x3f\xf6\xcf\x5a\xd2\x7f\x51\x1b\xfe\x95",
+    .fork_epochs             = eth_mainnet_fork_epochs,
+    .fork_count              = sizeof(eth_mainnet_fork_epochs) / sizeof(uint64_t) - 1,
+    .fork_data_roots         = eth_mainnet_fork_data_roots};
+
+static const chain_spec_t* chain_spec(chain_id_t chain_id) {
+  switch (chain_id) {
+    case C4_CHAIN_MAINNET: return &eth_mainnet;
+    default: return NULL;
   }
+}
 
-  memcpy(genesis_validators_root, hash, 32);
+bool c4_chain_genesis_validators_root(chain_id_t chain_id, bytes32_t genesis_validators_root) {
+  const chain_spec_t* spec = chain_spec(chain_id);
+  if (!spec) return false;
+  memcpy(genesis_validators_root, spec->genesis_validators_root, 32);
   return true;
 }
 
-fork_id_t c4_chain_fork_id(chain_id_t chain_id, uint64_t epoch) {
-  const uint64_t* fork_epochs = NULL;
-  int             i           = 0;
+bool c4_chain_domain(chain_id_t chain_id, fork_id_t fork, uint32_t domain_type, bytes32_t domain) {
+  const chain_spec_t* spec = chain_spec(chain_id);
+  if (!spec || fork > C4_FORK_FULU) return false;
+  uint32_to_le(domain, domain_type);
+  memcpy(domain + 4, spec->fork_data_roots[fork], 28);
+  return true;
+}
 
-  switch (chain_id) {
-    case C4_CHAIN_MAINNET: {
-      fork_epochs = eth_mainnet_fork_epochs;
-      break;
-    }
-    default: return C4_FORK_ALTAIR;
+// depth of the merkle tree of a container with the number of fields
+#define FIELDS_DEPTH(n)               ((n) <= 8 ? 3 : (n) <= 16 ? 4 : (n) <= 32 ? 5 : (n) <= 64 ? 6 : 7)
+#define GINDEX(parent, fields, index) ((((uint64_t) (parent)) << FIELDS_DEPTH(fields)) + (index))
+// the executionPayload is the 10th field of the BeaconBlockBody
+#define PAYLOAD_GINDEX(body_fields, payload_fields, index) GINDEX(GINDEX(1, body_fields, 9), payload_fields, index)
+
+// the gindexes are calculated at compile time from the number of fields of the BeaconBlockBody, ExecutionPayload and BeaconState
+#define FORK_GINDEXES(body_fields, payload_fields, state_fields)                        \
+  {                                                                                     \
+    .state_root          = PAYLOAD_GINDEX(body_fields, payload_fields, 2),              \
+    .receipts_root       = PAYLOAD_GINDEX(body_fields, payload_fields, 3),              \
+    .block_number        = PAYLOAD_GINDEX(body_fields, payload_fields, 6),              \
+    .block_hash          = PAYLOAD_GINDEX(body_fields, payload_fields, 12),             \
+    .transactions        = (PAYLOAD_GINDEX(body_fields, payload_fields, 13) * 2) << 20, \
+    .next_sync_committee = GINDEX(1, state_fields, 23),                                 \
   }
 
-  while (fork_epochs && fork_epochs[i] && epoch >= fork_epochs[i]) i++;
+static const c4_gindexes_t fork_gindexes[] = {
+    [C4_FORK_PHASE0]    = {0},
+    [C4_FORK_ALTAIR]    = {.next_sync_committee = GINDEX(1, 24, 23)},
+    [C4_FORK_BELLATRIX] = FORK_GINDEXES(10, 14, 25),
+    [C4_FORK_CAPELLA]   = FORK_GINDEXES(11, 15, 28),
+    [C4_FORK_DENEB]     = FORK_GINDEXES(12, 17, 28),
+    [C4_FORK_ELECTRA]   = FORK_GINDEXES(13, 17, 37),
+    [C4_FORK_FULU]      = FORK_GINDEXES(13, 17, 38),
+};
+
+fork_id_t c4_chain_fork_id(chain_id_t chain_id, uint64_t epoch) {
+  const chain_spec_t* spec = chain_spec(chain_id);
+  if (!spec) return C4_FORK_ALTAIR;
+
+  // most epochs are in the latest fork, so the search starts there
+  uint32_t i = spec->fork_count;
+  while (i && epoch < spec->fork_epochs[i - 1]) i--;
   return (fork_id_t) i;
 }
+
+const c4_gindexes_t* c4_fork_gindexes(fork_id_t fork) {
+  return fork_gindexes + (fork > C4_FORK_FULU ? C4_FORK_FULU : fork);
+}
+
+const c4_gindexes_t* c4_chain_gindexes(chain_id_t chain_id, uint64_t slot) {
+  // without a known fork schedule we use the deneb layout, which is the one the proofer creates
+  if (!chain_spec(chain_id)) return fork_gindexes + C4_FORK_DENEB;
+  return c4_fork_gindexes(c4_chain_fork_id(chain_id, slot >> 5));
+}
@@ -42,8 +42,27 @@ typedef enum {
   C4_FORK_FULU      = 6
 } fork_id_t;
 
+/** the gindexes of the fields used in proofs, which depend on the container layouts of a fork */
+typedef struct {
+  uint64_t state_root;          /**< executionPayload.stateRoot within the BeaconBlockBody */
+  uint64_t receipts_root;       /**< executionPayload.receiptsRoot within the BeaconBlockBody */
+  uint64_t block_number;        /**< executionPayload.blockNumber within the BeaconBlockBody */
+  uint64_t block_hash;          /**< executionPayload.blockHash within the BeaconBlockBody */
+  uint64_t transactions;        /**< executionPayload.transactions[0] within the BeaconBlockBody */
+  uint64_t next_sync_committee; /**< nextSyncCommittee within the BeaconState */
+} c4_gindexes_t;
+
+#define C4_DOMAIN_SYNC_COMMITTEE 7
+
 bool      c4_chain_genesis_validators_root(chain_id_t chain_id, bytes32_t genesis_validators_root);
 fork_id_t c4_chain_fork_id(chain_id_t chain_id, uint64_t epoch);
+/** writes the domain of the type (like C4_DOMAIN_SYNC_COMMITTEE) for the fork of the chain from the precomputed fork data roots */
+bool      c4_chain_domain(chain_id_t chain_id, fork_id_t fork, uint32_t domain_type, bytes32_t domain);
+
+/** returns the gindexes for the layout of the fork */
+const c4_gindexes_t* c4_fork_gindexes(fork_id_t fork);
+/** returns the gindexes for the layout of the fork active at the slot */
+const c4_gindexes_t* c4_chain_gindexes(chain_id_t chain_id, uint64_t slot);
 
 #ifdef __cplusplus
 }
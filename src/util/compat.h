@@ -44,4 +44,18 @@
 #endif
 #endif /* EMBEDDED */
 
+/* Atomic pointer access for data which is built lazily and published once.
+   Targets without threads (EMBEDDED, WASM) use plain access. */
+#if defined(EMBEDDED) || defined(__EMSCRIPTEN__)
+#define c4_atomic_load_ptr(ptr)                 (*(ptr))
+#define c4_atomic_cas_ptr(ptr, expected, value) (*(ptr) == (expected) ? (*(ptr) = (value), 1) : 0)
+#elif defined(_MSC_VER)
+#include <intrin.h>
+#define c4_atomic_load_ptr(ptr)                 _InterlockedCompareExchangePointer((void* volatile*) (ptr), NULL, NULL)
+#define c4_atomic_cas_ptr(ptr, expected, value) (_InterlockedCompareExchangePointer((void* volatile*) (ptr), (value), (expected)) == (void*) (expected))
+#else
+#define c4_atomic_load_ptr(ptr)                 __atomic_load_n((ptr), __ATOMIC_ACQUIRE)
+#define c4_atomic_cas_ptr(ptr, expected, value) __sync_bool_compare_and_swap((ptr), (expected), (value))
+#endif
+
 #endif /* UTIL_COMPAT_H */
\ No newline at end of file
@@ -6,13 +6,10 @@
 #include "sha3.h"
 #include <stdlib.h> // For malloc and free
 #include <string.h>
-
-void sha256(bytes_t data, uint8_t* out) {
-  SHA256_CTX ctx;
-  sha256_Init(&ctx);
-  sha256_Update(&ctx, data.data, data.len);
-  sha256_Final(&ctx, out);
-}
+#ifdef BLS_THREADS
+#include <pthread.h>
+#include <unistd.h>
+#endif
 
 void keccak(bytes_t data, uint8_t* out) {
   SHA3_CTX ctx;
@@ -21,14 +18,6 @@ void keccak(bytes_t data, uint8_t* out) {
   keccak_Final(&ctx, out);
 }
 
-void sha256_merkle(bytes_t data1, bytes_t data2, uint8_t* out) {
-  SHA256_CTX ctx;
-  sha256_Init(&ctx);
-  sha256_Update(&ctx, data1.data, data1.len);
-  sha256_Update(&ctx, data2.data, data2.len);
-  sha256_Final(&ctx, out);
-}
-
 static const uint8_t blst_dst[]   = "BLS_SIG_BLS12381G2_XMD:SHA-256_SSWU_RO_POP_";
 static const size_t  blst_dst_len = sizeof(blst_dst) - 1;
 #ifdef BLS_DESERIALIZE
@@ -43,58 +32,233 @@ bytes_t blst_deserialize_p1_affine(uint8_t* compressed_pubkeys, int num_public_k
   return bytes((uint8_t*) pubkeys, num_public_keys * sizeof(blst_p1_affine));
 }
 #endif
-bool blst_verify(bytes32_t       message_hash,    /**< 32 bytes hashed message */
-                 bls_signature_t signature,       /**< 96 bytes signature */
-                 uint8_t*        public_keys,     /**< 48 bytes public key array */
-                 int             num_public_keys, /**< number of public keys */
-                 bytes_t         pubkeys_used,
-                 bool            deserialized // if true the publickeys are already deserialized (96 bytes(p1_affine))
-) {                                           /**< num_public_keys.len = num_public_keys/8 and indicates with the bits set which of the public keys are part of the signature */
 
+static bool load_pubkey(uint8_t* public_keys, int index, bool deserialized, blst_p1_affine* pubkey) {
+  if (!deserialized) return blst_p1_deserialize(pubkey, public_keys + index * 48) == BLST_SUCCESS;
+  *pubkey = ((blst_p1_affine*) public_keys)[index];
+  return true;
+}
+
+bool blst_aggregate_pubkeys(uint8_t* public_keys, int num_public_keys, bytes_t pubkeys_used, bool deserialized, uint8_t* aggregated_pubkey, uint8_t* out) {
   if (pubkeys_used.len != num_public_keys / 8) return false;
 
-  // generate the aggregated pubkey
-  blst_p2_affine sig;
+  // with most keys participating, the absent keys are subtracted from the aggregate of all keys instead of adding all others
+  int used = 0;
+  for (int i = 0; i < num_public_keys; i++) used += (pubkeys_used.data[i / 8] >> (i % 8)) & 1;
+  if (!used) return false;
+  bool subtract = aggregated_pubkey && used > num_public_keys / 2;
+
   blst_p1_affine pubkey_aggregated;
+  blst_p1_affine pubkey_affine;
   blst_p1        pubkey_sum;
   bool           first_key = true;
+  if (subtract) {
+    if (!load_pubkey(aggregated_pubkey, 0, deserialized, &pubkey_affine)) return false;
+    blst_p1_from_affine(&pubkey_sum, &pubkey_affine);
+    first_key = false;
+  }
   for (int i = 0; i < num_public_keys; i++) {
-    if (pubkeys_used.data[i / 8] & (1 << (i % 8))) {
-      blst_p1_affine pubkey_affine;
-      if (deserialized)
-        pubkey_affine = ((blst_p1_affine*) public_keys)[i];
-      else if (blst_p1_deserialize(&pubkey_affine, public_keys + i * 48) != BLST_SUCCESS)
-        return false;
-
-      if (first_key) {
-        blst_p1_from_affine(&pubkey_sum, &pubkey_affine);
-        first_key = false;
-      }
-      else
-        blst_p1_add_or_double_affine(&pubkey_sum, &pubkey_sum, &pubkey_affine);
+    if (((pubkeys_used.data[i / 8] >> (i % 8)) & 1) == subtract) continue;
+    if (!load_pubkey(public_keys, i, deserialized, &pubkey_affine)) return false;
+    if (subtract) blst_fp_cneg(&pubkey_affine.y, &pubkey_affine.y, true);
+
+    if (first_key) {
+      blst_p1_from_affine(&pubkey_sum, &pubkey_affine);
+      first_key = false;
     }
+    else
+      blst_p1_add_or_double_affine(&pubkey_sum, &pubkey_sum, &pubkey_affine);
   }
   blst_p1_to_affine(&pubkey_aggregated, &pubkey_sum);
+  memcpy(out, &pubkey_aggregated, sizeof(blst_p1_affine));
+  return true;
+}
 
-  // deserialize signature
-  if (blst_p2_deserialize(&sig, signature) != BLST_SUCCESS) return false;
+// adds the signature to the pairing, multiplied with the scalar if given
+static bool pairing_add(blst_pairing* ctx, bls_batch_item_t* item, const uint8_t* scalar) {
+  blst_p1_affine pubkey;
+  blst_p2_affine sig;
+  memcpy(&pubkey, item->pubkey, sizeof(blst_p1_affine));
+  if (blst_p2_deserialize(&sig, item->signature) != BLST_SUCCESS) return false;
+  if (scalar)
+    return blst_pairing_mul_n_aggregate_pk_in_g1(ctx, &pubkey, &sig, scalar, 64, item->message, 32, NULL, 0) == BLST_SUCCESS;
+  return blst_pairing_aggregate_pk_in_g1(ctx, &pubkey, &sig, item->message, 32, NULL, 0) == BLST_SUCCESS;
+}
+
+// a part of a batch, which is aggregated into its own pairing context
+typedef struct pairing_job {
+  bls_batch_item_t*   items;
+  int                 offset;  // the index of the first item within the batch, which is part of its weight
+  int                 len;     // the number of items
+  const uint8_t*      seed;    // the hash of all items or NULL if the items are not weighted
+  blst_pairing*       ctx;     // the pairing context of this job
+  bool                valid;   // false if a signature could not be added
+  int*                pending; // the number of unfinished jobs of the batch
+  struct pairing_job* next;    // the next job in the queue of the pool
+} pairing_job_t;
+
+// runs the miller loops of the items of the job and commits them to its context
+static void pairing_run(pairing_job_t* job) {
+  uint8_t   input[36] = {0}; // the seed followed by the index of the item
+  bytes32_t scalar    = {0};
+  if (job->seed) memcpy(input, job->seed, 32);
+  blst_pairing_init(job->ctx, true, blst_dst, blst_dst_len);
+  job->valid = true;
+  for (int i = 0; i < job->len && job->valid; i++) {
+    if (job->seed) {
+      uint32_to_le(input + 32, (uint32_t) (job->offset + i));
+      sha256(bytes(input, sizeof(input)), scalar);
+      scalar[0] |= 1; // never zero
+    }
+    job->valid = pairing_add(job->ctx, job->items + i, job->seed ? scalar : NULL);
+  }
+  if (job->valid) blst_pairing_commit(job->ctx);
+}
 
-  // Pairing...
-  blst_pairing* ctx = (blst_pairing*) malloc(blst_pairing_sizeof());
-  if (!ctx) return false;
-  blst_pairing_init(ctx, true, blst_dst, blst_dst_len);
-  if (blst_pairing_aggregate_pk_in_g1(ctx, &pubkey_aggregated, &sig, message_hash, 32, NULL, 0) != BLST_SUCCESS) {
-    free(ctx);
+#ifdef BLS_THREADS
+#define BLS_MIN_ITEMS_PER_THREAD 4
+#define BLS_MAX_THREADS          64
+
+static uint32_t pool_size = 0; // the configured number of threads or 0 for the number of cpus
+
+// the worker threads are started with the first batch large enough and wait for the jobs of all batches
+static struct {
+  pthread_mutex_t lock;
+  pthread_cond_t  work;    // signaled when jobs are queued
+  pthread_cond_t  done;    // signaled when the last job of a batch is finished
+  pairing_job_t*  queue;   // the jobs waiting for a thread
+  int             workers; // the number of started threads
+} pool = {.lock = PTHREAD_MUTEX_INITIALIZER, .work = PTHREAD_COND_INITIALIZER, .done = PTHREAD_COND_INITIALIZER};
+
+void blst_set_threads(uint32_t threads) {
+  pool_size = threads;
+}
+
+static int pool_threads(int len) {
+  long threads = pool_size ? (long) pool_size : sysconf(_SC_NPROCESSORS_ONLN);
+  if (threads > len / BLS_MIN_ITEMS_PER_THREAD) threads = len / BLS_MIN_ITEMS_PER_THREAD;
+  if (threads > BLS_MAX_THREADS) threads = BLS_MAX_THREADS;
+  return threads < 1 ? 1 : (int) threads;
+}
+
+// takes the next job from the queue and runs it. The lock is held before and after.
+static bool pool_run_next() {
+  pairing_job_t* job = pool.queue;
+  if (!job) return false;
+  pool.queue = job->next;
+  pthread_mutex_unlock(&pool.lock);
+  pairing_run(job);
+  pthread_mutex_lock(&pool.lock);
+  if (--*job->pending == 0) pthread_cond_broadcast(&pool.done);
+  return true;
+}
+
+static void* pool_worker(void* arg) {
+  (void) arg;
+  pthread_mutex_lock(&pool.lock);
+  while (true) {
+    if (!pool_run_next()) pthread_cond_wait(&pool.work, &pool.lock);
+  }
+  return NULL;
+}
+
+// queues all jobs but the first, which runs on the calling thread. Afterwards it helps with the queue until all jobs are done.
+static void pool_run(pairing_job_t* jobs, int len) {
+  int pending = len - 1;
+  pthread_mutex_lock(&pool.lock);
+  for (int i = 1; i < len; i++) {
+    jobs[i].pending = &pending;
+    jobs[i].next    = pool.queue;
+    pool.queue      = jobs + i;
+  }
+  while (pool.workers < len - 1) {
+    pthread_t thread;
+    if (pthread_create(&thread, NULL, pool_worker, NULL)) break; // the calling thread runs the remaining jobs
+    pthread_detach(thread);
+    pool.workers++;
+  }
+  pthread_cond_broadcast(&pool.work);
+  pthread_mutex_unlock(&pool.lock);
+
+  pairing_run(jobs);
+
+  pthread_mutex_lock(&pool.lock);
+  while (pending) {
+    if (!pool_run_next()) pthread_cond_wait(&pool.done, &pool.lock);
+  }
+  pthread_mutex_unlock(&pool.lock);
+}
+#else
+void blst_set_threads(uint32_t threads) {
+  (void) threads;
+}
+#define pool_threads(len) 1
+#endif
+
+static bool pairing_verify(bls_batch_item_t* items, int len, bool weighted) {
+  bytes32_t seed    = {0};
+  int       threads = pool_threads(len);
+  int       chunk   = (len + threads - 1) / threads;
+  size_t    size    = blst_pairing_sizeof();
+  bool      valid   = true;
+  threads           = (len + chunk - 1) / chunk;
+
+  pairing_job_t* jobs = (pairing_job_t*) calloc(threads, sizeof(pairing_job_t));
+  uint8_t*       ctxs = (uint8_t*) malloc(threads * size);
+  if (!jobs || !ctxs) {
+    free(jobs);
+    free(ctxs);
     return false;
   }
-  blst_pairing_commit(ctx);
-  bool result = blst_pairing_finalverify(ctx, NULL);
+  if (weighted) sha256(bytes((uint8_t*) items, len * sizeof(bls_batch_item_t)), seed);
+  for (int i = 0; i < threads; i++) {
+    jobs[i].items  = items + i * chunk;
+    jobs[i].offset = i * chunk;
+    jobs[i].len    = len - i * chunk < chunk ? len - i * chunk : chunk;
+    jobs[i].seed   = weighted ? seed : NULL;
+    jobs[i].ctx    = (blst_pairing*) (ctxs + i * size);
+  }
 
-  // cleanup
-  free(ctx);
+#ifdef BLS_THREADS
+  if (threads > 1)
+    pool_run(jobs, threads);
+  else
+#endif
+    pairing_run(jobs);
+
+  // the miller loops of all jobs are merged, so only one final exponentiation is needed
+  for (int i = 0; i < threads && valid; i++)
+    valid = jobs[i].valid && (i == 0 || blst_pairing_merge(jobs[0].ctx, jobs[i].ctx) == BLST_SUCCESS);
+  valid = valid && blst_pairing_finalverify(jobs[0].ctx, NULL);
+
+  free(ctxs);
+  free(jobs);
+  return valid;
+}
+
+bool blst_verify_batch(bls_batch_item_t* items, int len, bool* valid) {
+  bool result = len > 0 && pairing_verify(items, len, len > 1);
+  if (!valid) return result;
+  for (int i = 0; i < len; i++)
+    valid[i] = result || (len > 1 && pairing_verify(items + i, 1, false));
   return result;
 }
 
+bool blst_verify(bytes32_t       message_hash,      /**< 32 bytes hashed message */
+                 bls_signature_t signature,         /**< 96 bytes signature */
+                 uint8_t*        public_keys,       /**< 48 bytes public key array */
+                 int             num_public_keys,   /**< number of public keys */
+                 bytes_t         pubkeys_used,      /**< num_public_keys.len = num_public_keys/8 and indicates with the bits set which of the public keys are part of the signature */
+                 bool            deserialized,      /**< if true the publickeys are already deserialized (96 bytes(p1_affine)) */
+                 uint8_t*        aggregated_pubkey  /**< optional aggregate of all public keys in the same format */
+) {
+  bls_batch_item_t item = {0};
+  if (!blst_aggregate_pubkeys(public_keys, num_public_keys, pubkeys_used, deserialized, aggregated_pubkey, item.pubkey)) return false;
+  memcpy(item.message, message_hash, 32);
+  memcpy(item.signature, signature, 96);
+  return pairing_verify(&item, 1, false);
+}
+
 bool secp256k1_recover(const bytes32_t digest, bytes_t signature, uint8_t* pubkey) {
   uint8_t pub[65] = {0};
   if (ecdsa_recover_pub_from_sig(&secp256k1, pub, signature.data, digest, signature.data[64] % 27))
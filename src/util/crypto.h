@@ -7,6 +7,7 @@ extern "C" {
 
 #include "bytes.h"
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 
 typedef uint8_t address_t[20];
@@ -14,19 +15,56 @@ typedef uint8_t bytes32_t[32];
 typedef uint8_t bls_pubkey_t[48];
 typedef uint8_t bls_signature_t[96];
 
+/** a signature to be verified within a batch */
+typedef struct {
+  bytes32_t       message;    /**< 32 bytes hashed message */
+  bls_signature_t signature;  /**< 96 bytes signature */
+  uint8_t         pubkey[96]; /**< the aggregated public key as deserialized p1_affine */
+} bls_batch_item_t;
+
 void keccak(bytes_t data, uint8_t* out);
 void sha256(bytes_t data, uint8_t* out);
 void sha256_merkle(bytes_t data1, bytes_t data2, uint8_t* out);
+
+/**
+ * hashes n messages of 64 bytes each (usually two 32 byte merkle nodes) and writes the n digests of 32 bytes to out.
+ * in and out may point to the same buffer, so a whole level of a merkle tree can be reduced in place.
+ */
+void sha256_pairs(const uint8_t* in, size_t n, uint8_t* out);
+
+/** returns the name of the sha256 backend selected for this cpu (portable, sha-ni, avx2, sha-ni+avx2 or armv8) */
+const char* sha256_backend();
 #ifdef BLS_DESERIALIZE
 bytes_t blst_deserialize_p1_affine(uint8_t* compressed_pubkeys, int num_public_keys);
 #endif
 
-bool blst_verify(bytes32_t       message,         /**< 32 bytes hashed message */
-                 bls_signature_t signature,       /**< 96 bytes signature */
-                 uint8_t*        public_keys,     /**< 48 bytes public key array */
-                 int             num_public_keys, /**< number of public keys */
-                 bytes_t         pibkey_bitmask,  /**< num_public_keys.len = num_public_keys/8 and indicates with the bits set which of the public keys are part of the signature */
-                 bool            deserialized);
+bool blst_verify(bytes32_t       message,           /**< 32 bytes hashed message */
+                 bls_signature_t signature,         /**< 96 bytes signature */
+                 uint8_t*        public_keys,       /**< 48 bytes public key array */
+                 int             num_public_keys,   /**< number of public keys */
+                 bytes_t         pibkey_bitmask,    /**< num_public_keys.len = num_public_keys/8 and indicates with the bits set which of the public keys are part of the signature */
+                 bool            deserialized,      /**< if true the public keys are already deserialized (96 bytes p1_affine) */
+                 uint8_t*        aggregated_pubkey  /**< optional aggregate of all public keys in the same format. If set, absent keys are subtracted from it, when more than half of the keys signed. */
+);
+
+/**
+ * aggregates the public keys with the bits set in the bitmask and writes the result as deserialized p1_affine (96 bytes) to out.
+ * The parameters are the same as for blst_verify.
+ */
+bool blst_aggregate_pubkeys(uint8_t* public_keys, int num_public_keys, bytes_t pibkey_bitmask, bool deserialized, uint8_t* aggregated_pubkey, uint8_t* out);
+
+/**
+ * verifies all signatures with one multi pairing and a single final exponentiation. Each signature is weighted with a 64 bit
+ * factor derived from the hash of all items, so invalid signatures can not cancel each other out.
+ * Only if the batch fails, each signature is verified on its own and the result is written to valid (if not NULL).
+ */
+bool blst_verify_batch(bls_batch_item_t* items, int len, bool* valid);
+
+/**
+ * sets the number of threads used for the miller loops of large batches. 0 (default) uses the number of cpus and 1 disables threads.
+ * Without BLS_THREADS (embedded and wasm builds), all batches are verified on the calling thread.
+ */
+void blst_set_threads(uint32_t threads);
 
 bool secp256k1_recover(const bytes32_t digest, bytes_t signature, uint8_t* pubkey);
 
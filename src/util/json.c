@@ -5,15 +5,144 @@
 #define json(jtype, data, length) \
   (json_t) { .type = jtype, .start = data, .len = length }
 
+// Scanning for structural characters uses simd kernels, which classify a whole vector of bytes at once:
+//
+//   - x86 AVX2 (32 bytes, if the compiler targets it) or SSE2 (16 bytes)
+//   - ARMv8 NEON (16 bytes)
+//   - WASM SIMD128 (16 bytes, if built with -msimd128)
+//
+// Since the text is terminated by a 0 or an end pointer, the vectors are loaded aligned, so a load never crosses
+// a page boundary, even though it may read some bytes beyond the terminator. Embedded builds only use the scalar loops.
+
+#if !defined(EMBEDDED) && defined(__GNUC__)
+#if defined(__AVX2__)
+#define JSON_SIMD "avx2"
+#include <immintrin.h>
+#define JSON_VEC_LEN 32
+typedef __m256i json_vec_t;
+#define vec_load(p)  _mm256_load_si256((const __m256i*) (p))
+#define vec_set(c)   _mm256_set1_epi8(c)
+#define vec_eq(a, b) _mm256_cmpeq_epi8(a, b)
+#define vec_or(a, b) _mm256_or_si256(a, b)
+#define vec_mask(v)  ((uint32_t) _mm256_movemask_epi8(v))
+#elif defined(__SSE2__)
+#define JSON_SIMD "sse2"
+#include <emmintrin.h>
+#define JSON_VEC_LEN 16
+typedef __m128i json_vec_t;
+#define vec_load(p)  _mm_load_si128((const __m128i*) (p))
+#define vec_set(c)   _mm_set1_epi8(c)
+#define vec_eq(a, b) _mm_cmpeq_epi8(a, b)
+#define vec_or(a, b) _mm_or_si128(a, b)
+#define vec_mask(v)  ((uint32_t) _mm_movemask_epi8(v))
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#define JSON_SIMD "neon"
+#include <arm_neon.h>
+#define JSON_VEC_LEN 16
+typedef uint8x16_t json_vec_t;
+#define vec_load(p)  vld1q_u8((const uint8_t*) (p))
+#define vec_set(c)   vdupq_n_u8((uint8_t) (c))
+#define vec_eq(a, b) vceqq_u8(a, b)
+#define vec_or(a, b) vorrq_u8(a, b)
+static inline uint32_t vec_mask(uint8x16_t v) {
+  static const uint8_t bits[16] = {1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128};
+  uint8x16_t           masked   = vandq_u8(v, vld1q_u8(bits));
+  return vaddv_u8(vget_low_u8(masked)) | ((uint32_t) vaddv_u8(vget_high_u8(masked)) << 8);
+}
+#elif defined(__wasm_simd128__)
+#define JSON_SIMD "wasm-simd128"
+#include <wasm_simd128.h>
+#define JSON_VEC_LEN 16
+typedef v128_t json_vec_t;
+#define vec_load(p)  wasm_v128_load(p)
+#define vec_set(c)   wasm_i8x16_splat(c)
+#define vec_eq(a, b) wasm_i8x16_eq(a, b)
+#define vec_or(a, b) wasm_v128_or(a, b)
+#define vec_mask(v)  ((uint32_t) wasm_i8x16_bitmask(v))
+#endif
+#endif
+
+// the aligned loads may touch bytes outside of the allocation, which is fine for the cpu, but not for asan.
+#if defined(JSON_SIMD) && defined(__has_feature)
+#if __has_feature(address_sanitizer)
+#define JSON_NO_SANITIZE __attribute__((no_sanitize_address))
+#endif
+#endif
+#if defined(JSON_SIMD) && !defined(JSON_NO_SANITIZE) && defined(__SANITIZE_ADDRESS__)
+#define JSON_NO_SANITIZE __attribute__((no_sanitize_address))
+#endif
+#ifndef JSON_NO_SANITIZE
+#define JSON_NO_SANITIZE
+#endif
+
+#ifdef JSON_SIMD
+#define VEC_ALL_BITS ((uint32_t) (((uint64_t) 1 << JSON_VEC_LEN) - 1))
+
+// finds the first vector with a set bit in the mask created by the classify-expression for the vector v.
+#define VEC_SCAN(pos, end, classify)                                                          \
+  do {                                                                                        \
+    const char* block = (const char*) ((uintptr_t) (pos) & ~(uintptr_t) (JSON_VEC_LEN - 1)); \
+    json_vec_t  v     = vec_load(block);                                                      \
+    uint32_t    mask  = (classify) & (VEC_ALL_BITS << ((pos) - block));                       \
+    while (!mask) {                                                                           \
+      block += JSON_VEC_LEN;                                                                  \
+      if ((end) && block >= (end)) return (end);                                              \
+      v    = vec_load(block);                                                                 \
+      mask = (classify);                                                                      \
+    }                                                                                         \
+    pos = block + __builtin_ctz(mask);                                                        \
+  } while (0)
+#endif
+
+const char* json_scan_backend() {
+#ifdef JSON_SIMD
+  return JSON_SIMD;
+#else
+  return "scalar";
+#endif
+}
+
+static inline bool is_whitespace(char c) {
+  return c == ' ' || c == '\n' || c == '\r' || c == '\t' || c == '\v' || c == '\f';
+}
+
+// returns the first position, which is not a whitespace. If end is set, it stops there.
+JSON_NO_SANITIZE static const char* scan_whitespace(const char* pos, const char* end) {
+  // most values are not preceded by any whitespace at all
+  if ((end && pos >= end) || !is_whitespace(*pos)) return pos;
+#ifdef JSON_SIMD
+  json_vec_t space = vec_set(' '), lf = vec_set('\n'), cr = vec_set('\r'), tab = vec_set('\t'), vt = vec_set('\v'), ff = vec_set('\f');
+  VEC_SCAN(pos, end, ~vec_mask(vec_or(vec_or(vec_or(vec_eq(v, space), vec_eq(v, lf)), vec_or(vec_eq(v, cr), vec_eq(v, tab))), vec_or(vec_eq(v, vt), vec_eq(v, ff)))) & VEC_ALL_BITS);
+#else
+  while ((!end || pos < end) && is_whitespace(*pos)) pos++;
+#endif
+  return end && pos > end ? end : pos;
+}
+
+// returns the first position holding one of the 4 chars or the terminating 0. If end is set, it stops there.
+JSON_NO_SANITIZE static const char* scan_chars(const char* pos, const char* end, char c0, char c1, char c2, char c3) {
+  if (end && pos >= end) return end;
+#ifdef JSON_SIMD
+  json_vec_t v0 = vec_set(c0), v1 = vec_set(c1), v2 = vec_set(c2), v3 = vec_set(c3), zero = vec_set(0);
+  VEC_SCAN(pos, end, vec_mask(vec_or(vec_or(vec_or(vec_eq(v, v0), vec_eq(v, v1)), vec_or(vec_eq(v, v2), vec_eq(v, v3))), vec_eq(v, zero))));
+#else
+  while ((!end || pos < end) && *pos && *pos != c0 && *pos != c1 && *pos != c2 && *pos != c3) pos++;
+#endif
+  return end && pos > end ? end : pos;
+}
+
 static const char* next_non_whitespace_token(const char* data) {
-  while (*data && isspace(*data)) data++;
+  data = scan_whitespace(data, NULL);
   return *data ? data : NULL;
 }
 
+// jumps from one quote, backslash or bracket to the next, skipping everything else.
 static const char* find_end(const char* pos, char start, char end) {
   int  level     = 1;
   bool in_string = start == '"';
   for (; *pos; pos++) {
+    pos = in_string ? scan_chars(pos, NULL, '"', '\\', '"', '\\') : scan_chars(pos, NULL, '"', '\\', start, end);
+    if (!*pos) return NULL;
     if (in_string && *pos == '\\') {
       if (!(*(++pos))) return NULL;
       continue;
@@ -83,7 +212,364 @@ json_t json_parse(const char* data) {
   return invalid;
 }
 
+// structural index
+
+#define JSON_INDEX_MAX_DEPTH 64
+
+typedef struct {
+  uint32_t    offset;      // position of the value within the text
+  uint32_t    len;         // length of the value
+  uint32_t    parent;      // tape position of the container
+  uint32_t    next;        // tape position following the value and all its children
+  uint32_t    children;    // position of the first child within the children list
+  uint32_t    count;       // number of children
+  uint32_t    name_offset; // position of the property name (without quotes) within the text
+  uint32_t    name_len;    // length of the property name
+  json_type_t type;
+} json_tape_t;
+
+struct json_index {
+  const char*  text;       // start of the indexed text
+  json_tape_t* tape;       // all values in document order
+  uint32_t     len;        // number of values
+  uint32_t*    children;   // tape positions of the children of all containers
+  uint32_t*    names;      // hash table of the properties with their tape position (0 = empty)
+  uint32_t     names_mask; // size of the hash table - 1
+};
+
+static inline uint32_t name_hash(uint32_t parent, const char* name, size_t len) {
+  uint32_t hash = 2166136261u ^ (parent * 0x9E3779B1u);
+  for (size_t i = 0; i < len; i++) hash = (hash ^ (uint8_t) name[i]) * 16777619u;
+  return hash;
+}
+
+static inline json_t tape_value(const json_index_t* index, uint32_t pos) {
+  const json_tape_t* entry = index->tape + pos;
+  return (json_t) {.type = entry->type, .start = index->text + entry->offset, .len = entry->len, .index = index, .pos = pos};
+}
+
+// returns the position of the closing quote of a string starting after the opening quote
+static const char* string_end(const char* pos, const char* end) {
+  for (; pos < end; pos++) {
+    pos = scan_chars(pos, end, '"', '\\', '"', '\\');
+    if (pos == end || !*pos) return NULL;
+    if (*pos == '\\')
+      pos++;
+    else
+      return pos;
+  }
+  return NULL;
+}
+
+static json_tape_t* tape_add(json_index_t* index, uint32_t* capacity) {
+  if (index->len == *capacity) {
+    json_tape_t* tape = realloc(index->tape, (*capacity ? *capacity * 2 : 64) * sizeof(json_tape_t));
+    if (!tape) return NULL;
+    *capacity   = *capacity ? *capacity * 2 : 64;
+    index->tape = tape;
+  }
+  json_tape_t* entry = index->tape + index->len++;
+  memset(entry, 0, sizeof(json_tape_t));
+  return entry;
+}
+
+// scans the text once and writes all values in document order to the tape
+static bool index_scan(json_index_t* index, const char* start, const char* end) {
+  uint32_t    stack[JSON_INDEX_MAX_DEPTH];
+  int         depth    = 0;
+  uint32_t    capacity = 0;
+  const char* pos      = scan_whitespace(start, end);
+
+  while (pos < end) {
+    uint32_t name_offset = 0, name_len = 0;
+    if (depth && index->tape[stack[depth - 1]].type == JSON_TYPE_OBJECT) {
+      const char* name_end = *pos == '"' ? string_end(pos + 1, end) : NULL;
+      if (!name_end) return false;
+      name_offset = pos + 1 - start;
+      name_len    = name_end - pos - 1;
+      pos         = scan_whitespace(name_end + 1, end);
+      if (pos == end || *pos != ':') return false;
+      pos = scan_whitespace(pos + 1, end);
+      if (pos == end) return false;
+    }
+
+    uint32_t     tape_pos = index->len;
+    json_tape_t* entry    = tape_add(index, &capacity);
+    if (!entry) return false;
+    entry->offset      = pos - start;
+    entry->name_offset = name_offset;
+    entry->name_len    = name_len;
+    if (depth) {
+      entry->parent = stack[depth - 1];
+      index->tape[entry->parent].count++;
+    }
+
+    const char* value_end = NULL;
+    switch (*pos) {
+      case '{':
+      case '[':
+        if (depth == JSON_INDEX_MAX_DEPTH) return false;
+        entry->type    = *pos == '{' ? JSON_TYPE_OBJECT : JSON_TYPE_ARRAY;
+        stack[depth++] = tape_pos;
+        pos            = scan_whitespace(pos + 1, end);
+        if (pos == end) return false;
+        if (*pos != '}' && *pos != ']') continue; // scan the first child
+        break;
+      case '"':
+        entry->type = JSON_TYPE_STRING;
+        value_end   = string_end(pos + 1, end);
+        break;
+      case 't':
+        entry->type = JSON_TYPE_BOOLEAN;
+        value_end   = end - pos >= 4 && strncmp(pos, "true", 4) == 0 ? pos + 3 : NULL;
+        break;
+      case 'f':
+        entry->type = JSON_TYPE_BOOLEAN;
+        value_end   = end - pos >= 5 && strncmp(pos, "false", 5) == 0 ? pos + 4 : NULL;
+        break;
+      case 'n':
+        entry->type = JSON_TYPE_NULL;
+        value_end   = end - pos >= 4 && strncmp(pos, "null", 4) == 0 ? pos + 3 : NULL;
+        break;
+      default: {
+        const char* p = pos;
+        while (p < end && (isdigit(*p) || *p == '.' || *p == '-' || *p == 'e' || *p == 'E')) p++;
+        entry->type = JSON_TYPE_NUMBER;
+        value_end   = p > pos ? p - 1 : NULL;
+      }
+    }
+
+    if (entry->type != JSON_TYPE_OBJECT && entry->type != JSON_TYPE_ARRAY) {
+      if (!value_end) return false;
+      entry->len  = value_end - pos + 1;
+      entry->next = index->len;
+      pos         = scan_whitespace(value_end + 1, end);
+    }
+
+    // close all containers ending here
+    while (depth && pos < end && (*pos == '}' || *pos == ']')) {
+      json_tape_t* container = index->tape + stack[--depth];
+      if (*pos != (container->type == JSON_TYPE_OBJECT ? '}' : ']')) return false;
+      container->len  = pos - start - container->offset + 1;
+      container->next = index->len;
+      pos             = scan_whitespace(pos + 1, end);
+    }
+
+    if (!depth) return true;
+    if (pos == end || *pos != ',') return false;
+    pos = scan_whitespace(pos + 1, end);
+  }
+  return false;
+}
+
+// builds the children lists and the property table from the tape
+static bool index_link(json_index_t* index) {
+  json_tape_t* tape   = index->tape;
+  uint32_t     cursor = 0;
+  uint32_t     props  = 0;
+  uint32_t     size   = 16;
+  for (uint32_t i = 0; i < index->len; i++) {
+    tape[i].children = cursor;
+    cursor += tape[i].count;
+    tape[i].count = 0;
+  }
+  index->children = malloc((cursor ? cursor : 1) * sizeof(uint32_t));
+  if (!index->children) return false;
+  for (uint32_t i = 1; i < index->len; i++) {
+    json_tape_t* parent                                 = tape + tape[i].parent;
+    index->children[parent->children + parent->count++] = i;
+    if (parent->type == JSON_TYPE_OBJECT) props++;
+  }
+
+  while (size < props * 2) size <<= 1;
+  index->names      = calloc(size, sizeof(uint32_t));
+  index->names_mask = size - 1;
+  if (!index->names) return false;
+  for (uint32_t i = 1; i < index->len; i++) {
+    if (tape[tape[i].parent].type != JSON_TYPE_OBJECT) continue;
+    const char* name = index->text + tape[i].name_offset;
+    uint32_t    slot = name_hash(tape[i].parent, name, tape[i].name_len) & index->names_mask;
+    for (; index->names[slot]; slot = (slot + 1) & index->names_mask) {
+      const json_tape_t* other = tape + index->names[slot];
+      if (other->parent == tape[i].parent && other->name_len == tape[i].name_len && memcmp(index->text + other->name_offset, name, other->name_len) == 0) break;
+    }
+    if (!index->names[slot]) index->names[slot] = i; // like json_get, the first property wins
+  }
+  return true;
+}
+
+json_t json_parse_indexed(const char* data, size_t len, json_index_t** index) {
+  if (*index) return tape_value(*index, 0);
+  if (!data || !len) return json(JSON_TYPE_INVALID, data, 0);
+  if (len > UINT32_MAX) return json_parse(data);
+
+  json_index_t* idx = calloc(1, sizeof(json_index_t));
+  if (!idx) return json_parse(data);
+  idx->text = scan_whitespace(data, data + len);
+  if (!index_scan(idx, idx->text, data + len) || !index_link(idx)) {
+    json_index_free(idx);
+    return json_parse(data);
+  }
+  *index = idx;
+  return tape_value(idx, 0);
+}
+
+void json_index_free(json_index_t* index) {
+  if (!index) return;
+  free(index->tape);
+  free(index->children);
+  free(index->names);
+  free(index);
+}
+
+static inline void stream_copy(buffer_t* buf, const char* start, const char* end) {
+  if (end > start) buffer_append(buf, bytes((uint8_t*) start, end - start));
+}
+
+// passes the complete value to the callback
+static void stream_emit(json_stream_t* stream) {
+  buffer_append(&stream->value, bytes(NULL, 1));
+  stream->value.data.len--;
+  stream->in_value = false;
+  stream->on_value(stream->ctx, json_parse((char*) stream->value.data.data));
+  stream->count++;
+  buffer_reset(&stream->value);
+}
+
+// checks whether the text received so far ends with "<property>":
+static bool stream_at_property(json_stream_t* stream) {
+  const char* start = (const char*) stream->text.data.data;
+  const char* pos   = start + stream->text.data.len;
+  size_t      len   = strlen(stream->property);
+  while (pos > start && is_whitespace(pos[-1])) pos--;
+  if (pos == start || *(--pos) != ':') return false;
+  while (pos > start && is_whitespace(pos[-1])) pos--;
+  return (size_t) (pos - start) >= len + 2 && pos[-1] == '"' && pos[-2 - (int) len] == '"' && memcmp(pos - 1 - len, stream->property, len) == 0;
+}
+
+void json_stream_append(json_stream_t* stream, const char* data, size_t len) {
+  const char* end = data + len;
+  const char* run = data; // the start of the bytes not copied yet
+  if (!stream->property) {
+    stream_copy(&stream->text, data, end);
+    return;
+  }
+
+  for (const char* pos = data; pos < end; pos++) {
+    if (stream->in_string) {
+      if (stream->escaped) {
+        stream->escaped = false;
+        continue;
+      }
+      pos = scan_chars(pos, end, '"', '\\', '"', '\\');
+      if (pos == end) break;
+      if (*pos == '\\')
+        stream->escaped = true;
+      else if (*pos == '"') {
+        stream->in_string = false;
+        if (stream->in_value && stream->depth == 2) {
+          stream_copy(&stream->value, run, pos + 1);
+          run = pos + 1;
+          stream_emit(stream);
+        }
+      }
+      continue;
+    }
+
+    char c = *pos;
+    if (stream->in_array && stream->depth == 2 && !stream->in_value) {
+      if (c == ',') { // the separators are dropped
+        stream_copy(&stream->text, run, pos);
+        run = pos + 1;
+        continue;
+      }
+      if (c != ']' && !is_whitespace(c)) {
+        stream_copy(&stream->text, run, pos);
+        run              = pos;
+        stream->in_value = true;
+      }
+    }
+    else if (stream->in_value && stream->depth == 2 && (c == ',' || c == ']' || is_whitespace(c))) { // end of a number or literal
+      stream_copy(&stream->value, run, pos);
+      run = c == ',' ? pos + 1 : pos;
+      stream_emit(stream);
+      if (c == ',') continue;
+    }
+
+    switch (c) {
+      case '"':
+        stream->in_string = true;
+        break;
+      case '[':
+        if (stream->depth == 1) {
+          stream_copy(&stream->text, run, pos);
+          run              = pos;
+          stream->in_array = stream_at_property(stream);
+        }
+        stream->depth++;
+        break;
+      case '{':
+        stream->depth++;
+        break;
+      case ']':
+      case '}':
+        if (stream->depth) stream->depth--;
+        if (stream->in_value && stream->depth == 2) {
+          stream_copy(&stream->value, run, pos + 1);
+          run = pos + 1;
+          stream_emit(stream);
+        }
+        else if (stream->in_array && stream->depth == 1)
+          stream->in_array = false;
+        break;
+      default:
+        break;
+    }
+  }
+  stream_copy(stream->in_value ? &stream->value : &stream->text, run, end);
+}
+
+void json_stream_free(json_stream_t* stream) {
+  buffer_free(&stream->text);
+  buffer_free(&stream->value);
+  stream->text  = (buffer_t) {0};
+  stream->value = (buffer_t) {0};
+}
+
+// finds the property within the object using the hash table of the index
+static json_t index_get(json_t parent, const char* property) {
+  const json_index_t* index = parent.index;
+  size_t              len   = strlen(property);
+  for (uint32_t slot = name_hash(parent.pos, property, len) & index->names_mask; index->names[slot]; slot = (slot + 1) & index->names_mask) {
+    const json_tape_t* entry = index->tape + index->names[slot];
+    if (entry->parent == parent.pos && entry->name_len == len && memcmp(index->text + entry->name_offset, property, len) == 0)
+      return tape_value(index, index->names[slot]);
+  }
+  return json(JSON_TYPE_NOT_FOUND, parent.start, 0);
+}
+
+// returns the next value of a container using the index
+static json_t index_next_value(json_t val, bytes_t* property_name, json_next_t type) {
+  const json_index_t* index = val.index;
+  uint32_t            pos   = val.pos + 1; // the first child directly follows its container
+  if (type == JSON_NEXT_FIRST) {
+    if (!index->tape[val.pos].count) return json(JSON_TYPE_NOT_FOUND, val.start, 0);
+  }
+  else {
+    pos = index->tape[val.pos].next;
+    if (!val.pos || pos >= index->tape[index->tape[val.pos].parent].next) return json(JSON_TYPE_NOT_FOUND, val.start, 0);
+  }
+
+  const json_tape_t* entry = index->tape + pos;
+  if (property_name && index->tape[entry->parent].type == JSON_TYPE_OBJECT) {
+    property_name->data = (uint8_t*) index->text + entry->name_offset;
+    property_name->len  = entry->name_len;
+  }
+  return tape_value(index, pos);
+}
+
 json_t json_next_value(json_t val, bytes_t* property_name, json_next_t type) {
+  if (val.index) return index_next_value(val, property_name, type);
   const char* start = next_non_whitespace_token(val.start + (type == JSON_NEXT_FIRST ? 1 : val.len));
   if (!start) return json(JSON_TYPE_INVALID, start, 0);
   if (type != JSON_NEXT_FIRST) {
@@ -115,6 +601,7 @@ json_t json_next_value(json_t val, bytes_t* property_name, json_next_t type) {
 
 json_t json_get(json_t parent, const char* property) {
   if (parent.type != JSON_TYPE_OBJECT) return json(JSON_TYPE_INVALID, parent.start, 0);
+  if (parent.index) return index_get(parent, property);
   bytes_t property_name = NULL_BYTES;
   size_t  len           = strlen(property);
   json_for_each_property(parent, val, property_name) {
@@ -125,6 +612,10 @@ json_t json_get(json_t parent, const char* property) {
 
 json_t json_at(json_t parent, size_t index) {
   if (parent.type != JSON_TYPE_ARRAY) return json(JSON_TYPE_INVALID, parent.start, 0);
+  if (parent.index) {
+    const json_tape_t* entry = parent.index->tape + parent.pos;
+    return index < entry->count ? tape_value(parent.index, parent.index->children[entry->children + index]) : json(JSON_TYPE_NOT_FOUND, parent.start, 0);
+  }
   size_t i = 0;
   json_for_each_value(parent, val) {
     if (index == i++) return val;
@@ -134,6 +625,7 @@ json_t json_at(json_t parent, size_t index) {
 
 size_t json_len(json_t parent) {
   if (parent.type != JSON_TYPE_ARRAY) return 0;
+  if (parent.index) return parent.index->tape[parent.pos].count;
   size_t i = 0;
   json_for_each_value(parent, val) i++;
   return i;
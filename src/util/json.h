@@ -19,10 +19,15 @@ typedef enum json_type_t {
   JSON_TYPE_NOT_FOUND = -1
 } json_type_t;
 
+/** a structural index (tape) of a json document, which allows constant time access to elements and properties */
+typedef struct json_index json_index_t;
+
 typedef struct json_t {
-  const char* start;
-  size_t      len;
-  json_type_t type;
+  const char*         start;
+  size_t              len;
+  json_type_t         type;
+  const json_index_t* index; // the structural index of the document or NULL, if the text needs to be scanned
+  uint32_t            pos;   // the position of the value within the index
 } json_t;
 
 typedef enum json_next_t {
@@ -56,7 +61,58 @@ void     buffer_add_json(buffer_t* buffer, json_t data);
 #define json_get_uint8(val, name)      json_as_uint8(json_get(val, name))
 #define json_get_bytes(val, name, buf) json_as_bytes(json_get(val, name), buf)
 
+/**
+ * parses len bytes of data and creates a structural index in one pass, which is attached to the returned value.
+ * All values taken from it carry the index, so json_get, json_at and json_len are constant time.
+ * If *index is already set, the value is taken from it without scanning the text again.
+ * The index references the text, which must stay valid until the index is freed.
+ * If the data is not valid json, *index stays NULL and the value is parsed without an index.
+ */
+json_t json_parse_indexed(const char* data, size_t len, json_index_t** index);
+void   json_index_free(json_index_t* index);
+
+/**
+ * splits a json text, which is passed in chunks, into the values of the array of one property of the root object,
+ * like the result of a json-rpc response. Each value is passed to on_value as soon as it is complete,
+ * so only the incomplete value and the text outside of the array are kept in memory.
+ */
+typedef void (*json_stream_cb)(void* ctx, json_t value);
+typedef struct {
+  const char*    property;  // the name of the property of the root object holding the array (NULL to keep the complete text)
+  json_stream_cb on_value;  // called for each complete value of the array
+  void*          ctx;       // passed to on_value
+  buffer_t       text;      // the text received without the values of the array
+  buffer_t       value;     // the incomplete value
+  uint32_t       count;     // the number of values passed to on_value
+  uint32_t       depth;     // the current nesting level
+  bool           in_string; // within a string
+  bool           escaped;   // after a backslash within a string
+  bool           in_array;  // within the array of the property
+  bool           in_value;  // within a value of the array
+} json_stream_t;
+
+void json_stream_append(json_stream_t* stream, const char* data, size_t len);
+void json_stream_free(json_stream_t* stream);
+
+// returns the name of the simd backend used to scan for structural characters ("avx2", "sse2", "neon", "wasm-simd128" or "scalar")
+const char* json_scan_backend();
+
 const char* json_validate(json_t val, const char* def, const char* error_prefix);
+
+/**
+ * a type definition like "{hash:bytes32,logs:[{address:address,topics:[bytes32]}]}" compiled into a tree,
+ * so validating only walks the data instead of parsing the definition again for each value.
+ */
+typedef struct json_schema json_schema_t;
+json_schema_t* json_schema_compile(const char* def);
+const char*    json_schema_validate(const json_schema_t* schema, json_t val, const char* error_prefix);
+void           json_schema_free(json_schema_t* schema);
+/**
+ * returns the schema of a constant definition, which is compiled on first use and published to the slot (usually a static at the call site).
+ * Concurrent first calls all get the same schema. The cached schemas are freed with json_schema_cache_free, when no thread uses them anymore.
+ */
+const json_schema_t* json_schema_cached(json_schema_t** slot, const char* def);
+void                 json_schema_cache_free();
 #define json_for_each_property(parent, val, property_name)                    \
   for (json_t val = json_next_value(parent, &property_name, JSON_NEXT_FIRST); \
        val.type != JSON_TYPE_NOT_FOUND && val.type != JSON_TYPE_INVALID;      \
@@ -1,6 +1,8 @@
 #include "bytes.h"
+#include "compat.h"
 #include "json.h"
 #include <ctype.h>
+#include <stdlib.h>
 #include <string.h>
 
 #define TEST_DEF "{tests:[{name?:bytes32,type?:address,len?:blocknumber}]}"
@@ -55,58 +57,208 @@ static const char* next_type(const char* pos, const char** next, int* len) {
   return next_name(pos, next, len);
 }
 
-static const char* check_array(json_t val, const char* def, const char* error_prefix) {
-  if (val.type != JSON_TYPE_ARRAY) ERROR("%sExpected array", error_prefix);
+typedef enum {
+  SCHEMA_ARRAY,
+  SCHEMA_OBJECT,
+  SCHEMA_BYTES32,
+  SCHEMA_ADDRESS,
+  SCHEMA_HEXUINT,
+  SCHEMA_BYTES,
+  SCHEMA_UINT,
+  SCHEMA_BOOL,
+  SCHEMA_BLOCK,
+  SCHEMA_UNKNOWN
+} schema_type_t;
+
+// a compiled type definition. Arrays hold the types of their elements (the last one is used for all remaining elements),
+// objects hold their properties. Errors within the definition are kept and reported when validating like before.
+struct json_schema {
+  schema_type_t   type;
+  bool            invalid;  // array or object: the definition is malformed after the children
+  bool            optional; // property: may be missing or null
+  char*           name;     // property: the name
+  const char*     def;      // unknown type: the remaining definition used for the error
+  uint32_t        len;      // number of children
+  json_schema_t*  children; // element types or properties
+  char*           text;     // root: the copy of the definition all nodes point to
+  json_schema_t** slot;     // root of a cached schema: the slot it was published to
+  json_schema_t*  next;     // root of a cached schema: the next cached schema
+};
+
+// all schemas published with json_schema_cached, so they can be freed
+static json_schema_t* cached_schemas = NULL;
+
+static json_schema_t* add_child(json_schema_t* node) {
+  node->children = realloc(node->children, (node->len + 1) * sizeof(json_schema_t));
+  json_schema_t* child = node->children + node->len++;
+  memset(child, 0, sizeof(json_schema_t));
+  return child;
+}
+
+static void compile_type(json_schema_t* node, const char* def);
+
+static void compile_array(json_schema_t* node, const char* def) {
   const char* next     = NULL;
   int         item_len = 0;
-  int         idx      = 0;
-  const char* item_def = next_type(def + 1, &next, &item_len);
-  if (!next) ERROR("%sExpected array", error_prefix);
-  while (*next && isspace(*next)) next++;
-  json_for_each_value(val, item) {
-    const char* err = json_validate(item, item_def, "");
-    if (err)
-      ERROR("%s at elemtent (idx: %d ) : %s", error_prefix, idx, err);
-    if (*next == ',') {
-      item_def = next_type(next + 1, &next, &item_len);
-      while (*next && isspace(*next)) next++;
+  node->type           = SCHEMA_ARRAY;
+  while (true) {
+    const char* item_def = next_type(def + 1, &next, &item_len);
+    if (!item_def) {
+      node->invalid = true;
+      return;
     }
-    idx++;
+    compile_type(add_child(node), item_def);
+    while (*next && isspace(*next)) next++;
+    if (*next != ',') return;
+    def = next;
   }
-  return NULL;
 }
 
-static const char* check_object(json_t ob, const char* def, const char* error_prefix) {
-  if (ob.type != JSON_TYPE_OBJECT) ERROR("%sExpected object", error_prefix);
+static void compile_object(json_schema_t* node, const char* def) {
   const char* next     = def;
-  const char* name     = NULL;
   int         name_len = 0;
   int         item_len = 0;
-  while ((name = next_name(def + 1, &next, &name_len))) {
-    if (!next) ERROR("%sExpected object", error_prefix);
-    bool optional = next && *next == '?';
+  node->type           = SCHEMA_OBJECT;
+  while (true) {
+    const char* name     = next_name(def + 1, &next, &name_len);
+    bool        optional = *next == '?';
     if (optional) next++;
     while (*next && isspace(*next)) next++;
-    if (*next != ':') ERROR("%sExpected in def :", error_prefix);
+    if (*next != ':') {
+      node->invalid = true;
+      return;
+    }
     next++;
     while (*next && isspace(*next)) next++;
-    const char* item_def  = next_type(next, &next, &item_len);
-    bytes_t     prop_name = NULL_BYTES;
-    bool        found     = false;
-    json_for_each_property(ob, val, prop_name) {
-      if (prop_name.len == name_len && prop_name.data && memcmp(prop_name.data, name, name_len) == 0) {
-        found = true;
-        if (optional && val.type == JSON_TYPE_NULL) break;
-        const char* err = json_validate(val, item_def, error_prefix ? error_prefix : "");
-        if (err) ERROR("%s.%j%s%s", error_prefix, (json_t) {.type = JSON_TYPE_OBJECT, .start = name, .len = name_len}, *err == '.' ? "" : ":", err);
-        break;
-      }
+    const char* item_def = next_type(next, &next, &item_len);
+    if (!item_def) {
+      node->invalid = true;
+      return;
     }
-    if (!found && !optional) ERROR("%smissing property %j", error_prefix, (json_t) {.type = JSON_TYPE_OBJECT, .start = name, .len = name_len});
+    json_schema_t* prop = add_child(node);
+    compile_type(prop, item_def);
+    prop->optional = optional;
+    prop->name     = calloc(1, name_len + 1);
+    memcpy(prop->name, name, name_len);
     while (*next && isspace(*next)) next++;
-    if (*next != ',') return NULL;
+    if (*next != ',') return;
     def = next;
   }
+}
+
+static void compile_type(json_schema_t* node, const char* def) {
+  if (*def == '[')
+    compile_array(node, def);
+  else if (*def == '{')
+    compile_object(node, def);
+  else if (strncmp(def, "bytes32", 7) == 0)
+    node->type = SCHEMA_BYTES32;
+  else if (strncmp(def, "address", 7) == 0)
+    node->type = SCHEMA_ADDRESS;
+  else if (strncmp(def, "hexuint", 7) == 0)
+    node->type = SCHEMA_HEXUINT;
+  else if (strncmp(def, "bytes", 5) == 0)
+    node->type = SCHEMA_BYTES;
+  else if (strncmp(def, "uint", 4) == 0)
+    node->type = SCHEMA_UINT;
+  else if (strncmp(def, "bool", 4) == 0)
+    node->type = SCHEMA_BOOL;
+  else if (strncmp(def, "block", 5) == 0)
+    node->type = SCHEMA_BLOCK;
+  else {
+    node->type = SCHEMA_UNKNOWN;
+    node->def  = def;
+  }
+}
+
+json_schema_t* json_schema_compile(const char* def) {
+  json_schema_t* schema = calloc(1, sizeof(json_schema_t));
+  schema->text          = strdup(def);
+  compile_type(schema, schema->text);
+  return schema;
+}
+
+const json_schema_t* json_schema_cached(json_schema_t** slot, const char* def) {
+  json_schema_t* schema = (json_schema_t*) c4_atomic_load_ptr(slot);
+  if (schema) return schema;
+
+  // compiled without a lock. If another thread publishes its schema first, we use theirs.
+  schema = json_schema_compile(def);
+  if (!c4_atomic_cas_ptr(slot, NULL, schema)) {
+    json_schema_free(schema);
+    return (json_schema_t*) c4_atomic_load_ptr(slot);
+  }
+
+  schema->slot = slot;
+  do schema->next = (json_schema_t*) c4_atomic_load_ptr(&cached_schemas);
+  while (!c4_atomic_cas_ptr(&cached_schemas, schema->next, schema));
+  return schema;
+}
+
+void json_schema_cache_free() {
+  json_schema_t* schema = cached_schemas;
+  cached_schemas        = NULL;
+  while (schema) {
+    json_schema_t* next = schema->next;
+    *schema->slot       = NULL;
+    json_schema_free(schema);
+    schema = next;
+  }
+}
+
+static void free_children(json_schema_t* node) {
+  for (uint32_t i = 0; i < node->len; i++) {
+    free_children(node->children + i);
+    free(node->children[i].name);
+  }
+  free(node->children);
+}
+
+void json_schema_free(json_schema_t* schema) {
+  if (!schema) return;
+  free_children(schema);
+  free(schema->text);
+  free(schema);
+}
+
+static const char* validate(const json_schema_t* schema, json_t val, const char* error_prefix);
+
+static const char* check_array(const json_schema_t* schema, json_t val, const char* error_prefix) {
+  if (val.type != JSON_TYPE_ARRAY) ERROR("%sExpected array", error_prefix);
+  if (schema->invalid) ERROR("%sExpected array", error_prefix);
+  int idx = 0;
+  json_for_each_value(val, item) {
+    const char* err = validate(schema->children + (idx < (int) schema->len ? idx : (int) schema->len - 1), item, "");
+    if (err) {
+      buffer_t buf = {0};
+      bprintf(&buf, "%s at elemtent (idx: %d ) : %s", error_prefix, idx, err);
+      free((char*) err);
+      return (const char*) buf.data.data;
+    }
+    idx++;
+  }
+  return NULL;
+}
+
+static const char* check_object(const json_schema_t* schema, json_t ob, const char* error_prefix) {
+  if (ob.type != JSON_TYPE_OBJECT) ERROR("%sExpected object", error_prefix);
+  for (uint32_t i = 0; i < schema->len; i++) {
+    const json_schema_t* prop = schema->children + i;
+    json_t               val  = json_get(ob, prop->name);
+    if (val.type == JSON_TYPE_NOT_FOUND) {
+      if (prop->optional) continue;
+      ERROR("%smissing property %s", error_prefix, prop->name);
+    }
+    if (prop->optional && val.type == JSON_TYPE_NULL) continue;
+    const char* err = validate(prop, val, error_prefix);
+    if (err) {
+      buffer_t buf = {0};
+      bprintf(&buf, "%s.%s%s%s", error_prefix, prop->name, *err == '.' ? "" : ":", err);
+      free((char*) err);
+      return (const char*) buf.data.data;
+    }
+  }
+  if (schema->invalid) ERROR("%sExpected in def :", error_prefix);
   return NULL;
 }
 
@@ -128,15 +280,28 @@ static const char* check_block(json_t val, const char* error_prefix) {
   if (strncmp("\"latest\"", val.start, 8) == 0 || strncmp("\"safe\"", val.start, 6) == 0 || strncmp("\"finalized\"", val.start, 11) == 0) return NULL;
   return check_hex(val, 0, true, error_prefix);
 }
+static const char* validate(const json_schema_t* schema, json_t val, const char* error_prefix) {
+  switch (schema->type) {
+    case SCHEMA_ARRAY: return check_array(schema, val, error_prefix);
+    case SCHEMA_OBJECT: return check_object(schema, val, error_prefix);
+    case SCHEMA_BYTES32: return check_hex(val, 32, false, error_prefix);
+    case SCHEMA_ADDRESS: return check_hex(val, 20, false, error_prefix);
+    case SCHEMA_HEXUINT: return check_hex(val, 0, true, error_prefix);
+    case SCHEMA_BYTES: return check_hex(val, 0, false, error_prefix);
+    case SCHEMA_UINT: return val.type == JSON_TYPE_NUMBER ? NULL : strdup("Expected uint");
+    case SCHEMA_BOOL: return val.type == JSON_TYPE_BOOLEAN ? NULL : strdup("Expected boolean");
+    case SCHEMA_BLOCK: return check_block(val, error_prefix);
+    default: ERROR("%sUnknown type %s", error_prefix, schema->def);
+  }
+}
+
+const char* json_schema_validate(const json_schema_t* schema, json_t val, const char* error_prefix) {
+  return validate(schema, val, error_prefix ? error_prefix : "");
+}
+
 const char* json_validate(json_t val, const char* def, const char* error_prefix) {
-  if (*def == '[') return check_array(val, def, error_prefix ? error_prefix : "");
-  if (*def == '{') return check_object(val, def, error_prefix ? error_prefix : "");
-  if (strncmp(def, "bytes32", 7) == 0) return check_hex(val, 32, false, error_prefix ? error_prefix : "");
-  if (strncmp(def, "address", 7) == 0) return check_hex(val, 20, false, error_prefix);
-  if (strncmp(def, "hexuint", 7) == 0) return check_hex(val, 0, true, error_prefix);
-  if (strncmp(def, "bytes", 5) == 0) return check_hex(val, 0, false, error_prefix);
-  if (strncmp(def, "uint", 4) == 0) return val.type == JSON_TYPE_NUMBER ? NULL : strdup("Expected uint");
-  if (strncmp(def, "bool", 4) == 0) return val.type == JSON_TYPE_BOOLEAN ? NULL : strdup("Expected boolean");
-  if (strncmp(def, "block", 5) == 0) return check_block(val, error_prefix);
-  ERROR("%sUnknown type %s", error_prefix ? error_prefix : "", def);
+  json_schema_t* schema = json_schema_compile(def);
+  const char*    err    = json_schema_validate(schema, val, error_prefix);
+  json_schema_free(schema);
+  return err;
 }
@@ -10,131 +10,151 @@
 #define NODE_LEAF      2
 #define NODE_EXTENSION 3
 
-static int patricia_match_nibbles(uint8_t* a, uint8_t* b) {
-  for (int i = 0;; i++) {
-    if (a[i] == 0xff || b[i] == 0xff || a[i] != b[i]) return i;
-  }
-  return -1;
+typedef enum {
+  WALK_ERROR = 0, // the node is invalid
+  WALK_VALUE = 1, // the value was found or the path was proven not to exist
+  WALK_HASH  = 2, // the path continues in the node with the hash
+} walk_t;
+
+static inline uint8_t path_nibble(bytes_t path, uint32_t i) {
+  return (path.data[i >> 1] >> ((i & 1) ? 0 : 4)) & 0xf;
 }
 
-static int count_nibbles(uint8_t* a) {
-  for (int n = 0;; n++) {
-    if (a[n] == 0xFF) return n;
+// follows the path through the items of a node and its embedded nodes by comparing the nibbles in place.
+// The value is set to NULL_BYTES, if the path does not exist and ref to the hash of the next node for WALK_HASH.
+static walk_t walk_node(bytes_t list, bytes_t path, uint32_t* offset, bytes_t* ref, bytes_t* value) {
+  uint32_t   len = path.len * 2;
+  rlp_item_t items[NODE_BRANCH];
+  rlp_item_t child;
+  *value = NULL_BYTES;
+
+  for (int depth = 0; depth < MAX_DEPTH; depth++) {
+    int count = rlp_decode_list(list, items, NODE_BRANCH);
+    if (count == NODE_BRANCH) {
+      if (*offset == len) {
+        if (items[16].type != RLP_ITEM) return WALK_ERROR;
+        if (items[16].data.len) *value = items[16].data;
+        return WALK_VALUE;
+      }
+      child = items[path_nibble(path, (*offset)++)];
+      if (child.type == RLP_ITEM && child.data.len == 0) return WALK_VALUE; // no child
+    }
+    else if (count == NODE_LEAF) {
+      bytes_t node_path = items[0].data;
+      if (items[0].type != RLP_ITEM || !node_path.len) return WALK_ERROR;
+      bool     is_leaf = node_path.data[0] & 0x20;
+      uint32_t odd     = (node_path.data[0] & 0x10) >> 4;
+      uint32_t n       = node_path.len * 2 - 2 + odd;
+      for (uint32_t i = 0; i < n; i++, (*offset)++) {
+        if (*offset == len || path_nibble(node_path, i + 2 - odd) != path_nibble(path, *offset)) return WALK_VALUE; // the path differs
+      }
+      if (is_leaf) {
+        if (*offset == len) {
+          if (items[1].type != RLP_ITEM) return WALK_ERROR;
+          *value = items[1].data;
+        }
+        return WALK_VALUE;
+      }
+      child = items[1];
+    }
+    else
+      return WALK_ERROR;
+
+    if (child.type == RLP_LIST)
+      list = child.data; // embedded node
+    else if (child.type == RLP_ITEM && child.data.len == 32) {
+      *ref = child.data;
+      return WALK_HASH;
+    }
+    else
+      return WALK_ERROR;
   }
+  return WALK_ERROR;
 }
 
-static uint8_t* patricia_to_nibbles(bytes_t p, bool prefix) {
-  size_t   count   = 0;
-  uint8_t* nibbles = malloc(1 + (p.len << 1));
-  for (size_t i = 0; i < p.len; i++) {
-    nibbles[count++] = p.data[i] >> 4;
-    nibbles[count++] = p.data[i] & 0x0F;
-    if (prefix && i == 0)
-      nibbles[0] = nibbles[(count = nibbles[0] & 1 ? 1 : 0)];
+int patricia_verify(bytes32_t root, bytes_t* p, ssz_ob_t proof, bytes_t* expected) {
+  uint32_t  proof_len = ssz_len(proof);
+  uint32_t  offset    = 0;
+  walk_t    result    = WALK_HASH;
+  bytes_t   value     = NULL_BYTES;
+  bytes_t   ref       = {0};
+  bytes32_t node_hash = {0};
+
+  if (!proof_len || proof_len > MAX_DEPTH) return 0;
+  for (uint32_t i = 0; i < proof_len; i++) {
+    bytes_t witness = ssz_at(proof, i).bytes;
+    bytes_t list    = {0};
+    keccak(witness, node_hash);
+    if (i == 0)
+      memcpy(root, node_hash, 32);
+    else if (result != WALK_HASH || memcmp(ref.data, node_hash, 32)) // each witness must be the node referenced by the previous one
+      return 0;
+    if (rlp_decode(&witness, 0, &list) != RLP_LIST) return 0;
+    if ((result = walk_node(list, *p, &offset, &ref, &value)) == WALK_ERROR) return 0;
   }
+  if (result != WALK_VALUE) return 0; // the proof ends before the path does
 
-  nibbles[count] = 0xFF;
-  return nibbles;
+  if (!expected) return value.data == NULL;
+  if (expected->data == NULL) {
+    if (value.data) *expected = value;
+    return 1;
+  }
+  return value.data && bytes_eq(*expected, value);
 }
 
-static int handle_node(bytes_t* raw, uint8_t** k, bytes_t* expected_val, int last_node, bytes_t* last_val, uint8_t* next_hash, size_t* depth) {
-  bytes_t val;
-  bytes_t node;
+typedef struct {
+  bytes32_t hash;
+  uint32_t  index;
+} proof_node_t;
 
-  if (MAX_DEPTH < (++(*depth))) return 0;
-
-  rlp_decode(raw, 0, &node);
-  switch ((int) rlp_decode(&node, -1, NULL)) {
-
-    case NODE_BRANCH:
-      if (**k == 0xFF) {
-        if (!last_node || rlp_decode(&node, 16, &node) != RLP_ITEM) return 0;
-        *last_val = node;
-        return 1;
-      }
+static int cmp_proof_nodes(const void* a, const void* b) {
+  return memcmp(((const proof_node_t*) a)->hash, ((const proof_node_t*) b)->hash, 32);
+}
 
-      if (rlp_decode(&node, **k, &val) == RLP_LIST) {
-        rlp_decode(&node, (**k) - 1, &node);
-        *k += 1;
-        node = bytes(node.data + node.len, val.data + val.len - node.data);
-        return handle_node(&node, k, expected_val, *(*k + 1) == 0xFF, last_val, next_hash, depth);
-      }
-      else if (val.len != 32)
-        memset(next_hash, 0, 32);
-      else
-        memcpy(next_hash, val.data, 32);
-      *k += 1;
-      return 1;
-
-    case NODE_LEAF:
-      if (rlp_decode(&node, 0, &val) != RLP_ITEM)
-        return 0;
-      else {
-        uint8_t* pn      = patricia_to_nibbles(val, 1);
-        int      match   = patricia_match_nibbles(pn, *k);
-        int      np_len  = count_nibbles(pn);
-        int      is_leaf = *val.data & 32;
-        free(pn);
-
-        if (np_len != match) return expected_val == NULL && last_node;
-
-        *k += np_len;
-        if (rlp_decode(&node, 1, &val) == RLP_LIST) {
-          rlp_decode(&node, 0, &node);
-          node.data += node.len;
-          node.len = val.data + val.len - node.data;
-
-          return handle_node(&node, k, expected_val, k && *k && *(k + 1) == NULL, last_val, next_hash, depth);
-        }
-        else if (**k == 0xFF) {
-          if (!last_node || (expected_val == NULL && is_leaf)) return 0;
-        }
-        else if (is_leaf && expected_val != NULL)
-          return 0;
+// follows the path from the root node by looking up each referenced node by its hash.
+static bool find_value(ssz_ob_t proof, proof_node_t* nodes, uint32_t count, bytes_t path, bytes_t* value) {
+  uint32_t     offset = 0;
+  proof_node_t key    = {0};
+  bytes_t      ref    = {0};
+  bytes_t      raw    = ssz_at(proof, 0).bytes;
+  bytes_t      list   = {0};
+
+  for (int depth = 0; depth < MAX_DEPTH; depth++) {
+    if (rlp_decode(&raw, 0, &list) != RLP_LIST) return false;
+    switch (walk_node(list, path, &offset, &ref, value)) {
+      case WALK_VALUE:
+        return true;
+      case WALK_HASH: {
+        memcpy(key.hash, ref.data, 32);
+        proof_node_t* found = bsearch(&key, nodes, count, sizeof(proof_node_t), cmp_proof_nodes);
+        if (!found) return false;
+        raw = ssz_at(proof, found->index).bytes;
+        break;
       }
-
-      *last_val = val;
-      memcpy(next_hash, val.data, (val.len >= 32) ? 32 : val.len);
-      break;
-
-    default:
-      return (last_node && expected_val == NULL);
+      default:
+        return false;
+    }
   }
-  return 1;
+  return false;
 }
 
-int patricia_verify(bytes32_t root, bytes_t* p, ssz_ob_t proof, bytes_t* expected) {
-  int       result     = 1;
-  uint8_t*  nibbles    = patricia_to_nibbles(*p, 0);
-  uint8_t*  key        = nibbles;
-  bytes_t   last_value = NULL_BYTES;
-  bytes32_t expected_hash;
-  bytes32_t node_hash;
-
-  //  memcpy(expected_hash, root->data, 32);
+bool patricia_verify_multi(bytes32_t root, ssz_ob_t proof, bytes_t* paths, bytes_t* values, uint32_t len) {
+  uint32_t count = ssz_len(proof);
+  if (!count) return false;
 
-  uint32_t proof_len = ssz_len(proof);
-  size_t   depth     = 0;
-  for (uint32_t i = 0; i < proof_len; i++) {
-    ssz_ob_t witness = ssz_at(proof, i);
-    keccak(witness.bytes, node_hash);
-    if (i == 0) {
-      memcpy(expected_hash, node_hash, 32);
-      memcpy(root, node_hash, 32);
-    }
-    else if (memcmp(expected_hash, node_hash, 32))
-      break;
-    if (!(result = handle_node(&witness.bytes, &key, expected, i + 1 == proof_len, &last_value, expected_hash, &depth))) break;
+  // each node is hashed exactly once and looked up by its hash
+  proof_node_t* nodes = malloc(count * sizeof(proof_node_t));
+  for (uint32_t i = 0; i < count; i++) {
+    keccak(ssz_at(proof, i).bytes, nodes[i].hash);
+    nodes[i].index = i;
   }
+  memcpy(root, nodes[0].hash, 32);
+  qsort(nodes, count, sizeof(proof_node_t), cmp_proof_nodes);
 
-  if (result && expected) {
-    if (expected->data == NULL) {
-      if (last_value.data) *expected = last_value;
-    }
-    else if (last_value.data == NULL || expected->len != last_value.len || memcmp(expected->data, last_value.data, last_value.len))
-      result = 0;
-  }
+  bool result = true;
+  for (uint32_t i = 0; i < len && result; i++)
+    result = find_value(proof, nodes, count, paths[i], values + i);
 
-  if (nibbles) free(nibbles);
+  free(nodes);
   return result;
 }
@@ -12,8 +12,18 @@ typedef struct node node_t;
 
 int patricia_verify(bytes32_t root, bytes_t* p, ssz_ob_t proof, bytes_t* expected);
 
+// verifies a proof created by patricia_create_multi_proof and sets the root and the value for each path.
+// Values of paths, which are proven not to exist, are set to NULL_BYTES.
+bool patricia_verify_multi(bytes32_t root, ssz_ob_t proof, bytes_t* paths, bytes_t* values, uint32_t len);
+
 ssz_ob_t patricia_create_merkle_proof(node_t* root, bytes_t path);
+// creates one proof for all paths, which contains each node only once in depth-first order starting with the root.
+ssz_ob_t patricia_create_multi_proof(node_t* root, bytes_t* paths, uint32_t len);
 void     patricia_set_value(node_t** root, bytes_t path, bytes_t value);
+// builds the trie for all keys at once, which hashes each node only once. For duplicate keys the last value wins.
+// All nodes and paths are allocated in one block, which is freed with patricia_node_free(root).
+// The values are not copied and must stay valid as long as the trie, which must not be modified with patricia_set_value.
+node_t*  patricia_build(bytes_t* keys, bytes_t* values, uint32_t len);
 void     patricia_node_free(node_t* node);
 bytes_t  patricia_get_root(node_t* node);
 
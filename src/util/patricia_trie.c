@@ -25,6 +25,7 @@ typedef struct node {
   uint8_t      hash[32];
   uint32_t     hash_len;
   struct node* parent;
+  struct node* arena; // the first node of the arena, if the node was created by patricia_build
   node_type_t  type;
   union {
     struct {
@@ -45,20 +46,37 @@ typedef struct node {
   } values;
 } node_t;
 
+// embedded nodes are stored with their full encoding, so the child is either a hash or this encoding.
+static inline bytes_t child_ref(node_t* node) {
+  return node ? bytes(node->hash, node->hash_len) : NULL_BYTES;
+}
+
 static void rlp_add_child(buffer_t* buf, node_t* node) {
-  if (!node)
-    rlp_add_item(buf, NULL_BYTES);
-  else if (node->hash_len == 32)
-    rlp_add_item(buf, bytes(node->hash, 32));
-  else {
-    bytes_t decoded = {0};
-    bytes_t data    = bytes(node->hash, node->hash_len);
-    rlp_decode(&data, 0, &decoded);
-    rlp_add_list(buf, decoded);
-  }
+  if (node && node->hash_len < 32)
+    buffer_append(buf, child_ref(node));
+  else
+    rlp_add_item(buf, child_ref(node));
+}
+
+static inline uint32_t child_len(node_t* node) {
+  return node && node->hash_len < 32 ? node->hash_len : rlp_item_len(child_ref(node));
+}
+
+// the length of the payload, so the list header is written before the items.
+static uint32_t node_payload_len(node_t* node) {
+  if (node->type == NODE_TYPE_LEAF)
+    return rlp_item_len(node->values.leaf.path) + rlp_item_len(node->values.leaf.value);
+  if (node->type == NODE_TYPE_EXTENSION)
+    return rlp_item_len(node->values.extension.path) + child_len(node->values.extension.child);
+  uint32_t len = rlp_item_len(node->values.branch.value);
+  for (int i = 0; i < 16; i++) len += child_len(node->values.branch.children[i]);
+  return len;
 }
 
 static void serialize_node(node_t* node, buffer_t* buf) {
+  uint32_t len = node_payload_len(node);
+  buffer_grow(buf, rlp_list_len(len));
+  rlp_add_list_header(buf, len);
   if (node->type == NODE_TYPE_LEAF) {
     rlp_add_item(buf, node->values.leaf.path);
     rlp_add_item(buf, node->values.leaf.value);
@@ -77,7 +95,6 @@ static void serialize_node(node_t* node, buffer_t* buf) {
 static void node_update_hash(node_t* node, bool follow_parent, ssz_builder_t* builder) {
   buffer_t buf = {0};
   serialize_node(node, &buf);
-  rlp_to_list(&buf);
   node->hash_len = buf.data.len;
   if (builder) ssz_add_dynamic_list_bytes(builder, 0, buf.data);
   if (node->hash_len >= 32) {
@@ -93,6 +110,11 @@ static void node_update_hash(node_t* node, bool follow_parent, ssz_builder_t* bu
 
 void patricia_node_free(node_t* node) {
   if (!node) return;
+  if (node->arena) {
+    // the whole trie lives in one allocation starting with the root
+    if (node->arena == node) free(node);
+    return;
+  }
   if (node->type == NODE_TYPE_BRANCH) {
     for (int i = 0; i < 16; i++)
       patricia_node_free(node->values.branch.children[i]);
@@ -122,15 +144,19 @@ static nibbles_t path_to_nibbles(bytes_t path, bool include_prefix) {
   return bytes(nibbles, nibbles_len);
 }
 
-static bytes_t nibbles_to_path(nibbles_t nibbles, bool is_leaf) {
-  uint8_t* path = calloc((nibbles.len >> 1) + 1, 1);
-  path[0]       = ((is_leaf << 1) + (nibbles.len & 1)) << 4;
-  int pos       = (nibbles.len & 1) ? 1 : 2;
+// writes the compact encoded path into the zeroed memory of (nibbles.len >> 1) + 1 bytes.
+static bytes_t write_path(nibbles_t nibbles, bool is_leaf, uint8_t* path) {
+  path[0] = ((is_leaf << 1) + (nibbles.len & 1)) << 4;
+  int pos = (nibbles.len & 1) ? 1 : 2;
   for (int i = 0; i < nibbles.len; i++, pos++)
     path[pos >> 1] |= pos % 2 ? nibbles.data[i] : (nibbles.data[i] << 4);
   return bytes(path, (nibbles.len >> 1) + 1);
 }
 
+static bytes_t nibbles_to_path(nibbles_t nibbles, bool is_leaf) {
+  return write_path(nibbles, is_leaf, calloc((nibbles.len >> 1) + 1, 1));
+}
+
 static node_t* create_leaf(node_t* parent, nibbles_t nibbles, bytes_t value) {
   node_t* leaf            = calloc(1, sizeof(node_t));
   leaf->type              = NODE_TYPE_LEAF;
@@ -313,20 +339,133 @@ void patricia_set_value(node_t** root, bytes_t path, bytes_t value) {
   free(nibbles.data);
 }
 
-ssz_ob_t patricia_create_merkle_proof(node_t* root, bytes_t path) {
-  ssz_def_t     def     = SSZ_LIST("bytes", ssz_bytes_list, 1024);
-  ssz_builder_t builder = {0};
-  buffer_t      buf     = {0};
-  nibbles_t     nibbles = path_to_nibbles(path, false);
-  int           offset  = 0;
-  int           len     = 0;
-  builder.def           = &def;
-  while (root && offset <= nibbles.len) {
-    // add the node
-    if (root->hash_len >= 32)
-      node_update_hash(root, false, &builder);
-    len++;
+typedef struct {
+  nibbles_t key;
+  bytes_t   value;
+  uint32_t  index;
+} build_entry_t;
+
+// bump allocator for the nodes and paths of a trie created by patricia_build.
+typedef struct {
+  node_t*  nodes;
+  uint32_t used;
+  uint8_t* paths;
+} build_arena_t;
+
+static node_t* arena_node(build_arena_t* arena, node_t* parent) {
+  node_t* node = arena->nodes + arena->used++;
+  node->parent = parent;
+  node->arena  = arena->nodes;
+  return node;
+}
 
+static bytes_t arena_path(build_arena_t* arena, nibbles_t nibbles, bool is_leaf) {
+  bytes_t path = write_path(nibbles, is_leaf, arena->paths);
+  arena->paths += path.len;
+  return path;
+}
+
+static int cmp_entries(const void* a, const void* b) {
+  const build_entry_t* x   = (const build_entry_t*) a;
+  const build_entry_t* y   = (const build_entry_t*) b;
+  uint32_t             len = x->key.len < y->key.len ? x->key.len : y->key.len;
+  int                  c   = memcmp(x->key.data, y->key.data, len);
+  if (c) return c;
+  if (x->key.len != y->key.len) return x->key.len < y->key.len ? -1 : 1;
+  return x->index < y->index ? -1 : 1;
+}
+
+// builds the node for sorted entries, which all share the first offset nibbles.
+// Since the children are complete before the node is created, each node is hashed exactly once.
+static node_t* build_node(build_arena_t* arena, node_t* parent, build_entry_t* entries, uint32_t len, uint32_t offset) {
+  node_t* node = arena_node(arena, parent);
+  if (len == 1) {
+    node->type              = NODE_TYPE_LEAF;
+    node->values.leaf.path  = arena_path(arena, remaining_nibbles(entries->key, offset), true);
+    node->values.leaf.value = entries->value;
+  }
+  else {
+    // since the entries are sorted, the common prefix of the first and the last key is shared by all
+    nibbles_t first  = entries[0].key;
+    nibbles_t last   = entries[len - 1].key;
+    uint32_t  common = offset;
+    while (common < first.len && common < last.len && first.data[common] == last.data[common]) common++;
+
+    node_t* branch = node;
+    if (common > offset) {
+      node->type                   = NODE_TYPE_EXTENSION;
+      node->values.extension.path  = arena_path(arena, slice_nibbles(first, offset, common - offset), false);
+      node->values.extension.child = arena_node(arena, node);
+      branch                       = node->values.extension.child;
+    }
+    branch->type = NODE_TYPE_BRANCH;
+
+    // a key ending here is the value of the branch and always sorted first
+    if (first.len == common) {
+      branch->values.branch.value = entries->value;
+      entries++;
+      len--;
+    }
+
+    for (uint32_t i = 0, n = 0; i < len; i = n) {
+      uint8_t nibble = entries[i].key.data[common];
+      for (n = i + 1; n < len && entries[n].key.data[common] == nibble; n++);
+      branch->values.branch.children[nibble] = build_node(arena, branch, entries + i, n - i, common + 1);
+    }
+    if (branch != node) node_update_hash(branch, false, NULL);
+  }
+  node_update_hash(node, false, NULL);
+  return node;
+}
+
+node_t* patricia_build(bytes_t* keys, bytes_t* values, uint32_t len) {
+  if (!len) return NULL;
+  uint32_t total = 0;
+  for (uint32_t i = 0; i < len; i++) total += keys[i].len * 2;
+
+  // the sorted entries and their nibbles are only needed while building
+  build_entry_t* entries = malloc(len * sizeof(build_entry_t) + total + 1);
+  uint8_t*       nibbles = (uint8_t*) (entries + len);
+  for (uint32_t i = 0; i < len; i++) {
+    for (uint32_t n = 0; n < keys[i].len; n++) {
+      *(nibbles++) = keys[i].data[n] >> 4;
+      *(nibbles++) = keys[i].data[n] & 0xf;
+    }
+    entries[i] = (build_entry_t) {.key = bytes(nibbles - keys[i].len * 2, keys[i].len * 2), .value = values[i], .index = i};
+  }
+  qsort(entries, len, sizeof(build_entry_t), cmp_entries);
+
+  // for duplicate keys, the last value wins just like with patricia_set_value
+  uint32_t count = 0;
+  for (uint32_t i = 0; i < len; i++) {
+    if (count && bytes_eq(entries[count - 1].key, entries[i].key))
+      entries[count - 1] = entries[i];
+    else
+      entries[count++] = entries[i];
+  }
+
+  // a trie with n leafs has at most n-1 branches with one extension each.
+  // The extensions of one key never overlap, so all paths fit into the nibbles of the keys plus one byte per node.
+  uint32_t      max_nodes = count * 3;
+  build_arena_t arena     = {.nodes = calloc(1, max_nodes * sizeof(node_t) + total + max_nodes)};
+  arena.paths             = (uint8_t*) (arena.nodes + max_nodes);
+  node_t* root            = build_node(&arena, NULL, entries, count, 0);
+  free(entries);
+  return root;
+}
+
+#define MAX_PROOF_DEPTH 64
+
+// the returned proofs keep a reference to their definition
+static const ssz_def_t PROOF_DEF = SSZ_LIST("bytes", ssz_bytes_list, 1024);
+
+// collects the nodes along the path starting with the root.
+static uint32_t path_nodes(node_t* root, bytes_t path, node_t** nodes) {
+  nibbles_t nibbles = path_to_nibbles(path, false);
+  int       offset  = 0;
+  uint32_t  len     = 0;
+  while (root && offset <= nibbles.len && len < MAX_PROOF_DEPTH) {
+    nodes[len++] = root;
     if (offset == nibbles.len) break;
     if (root->type == NODE_TYPE_BRANCH) {
       root = root->values.branch.children[nibbles.data[offset]];
@@ -343,12 +482,62 @@ ssz_ob_t patricia_create_merkle_proof(node_t* root, bytes_t path) {
     }
   }
   free(nibbles.data);
+  return len;
+}
 
+// adds the serialized node to the proof. Embedded nodes are already part of their parent.
+static uint32_t add_proof_node(ssz_builder_t* builder, node_t* node, bool is_root) {
+  if (node->hash_len < 32 && !is_root) return 0;
+  node_update_hash(node, false, builder);
+  return 1;
+}
+
+static ssz_ob_t proof_to_bytes(ssz_builder_t* builder, uint32_t len) {
   // fix offsets in builder
-  for (int i = 0; i < len; i++)
-    uint32_to_le(builder.fixed.data.data + i * 4, uint32_from_le(builder.fixed.data.data + i * 4) + len * 4);
+  for (uint32_t i = 0; i < len; i++)
+    uint32_to_le(builder->fixed.data.data + i * 4, uint32_from_le(builder->fixed.data.data + i * 4) + len * 4);
+  return ssz_builder_to_bytes(builder);
+}
 
-  return ssz_builder_to_bytes(&builder);
+ssz_ob_t patricia_create_merkle_proof(node_t* root, bytes_t path) {
+  ssz_builder_t builder                = {.def = &PROOF_DEF};
+  node_t*       nodes[MAX_PROOF_DEPTH] = {0};
+  uint32_t      count                  = path_nodes(root, path, nodes);
+  uint32_t      len                    = 0;
+  for (uint32_t i = 0; i < count; i++)
+    len += add_proof_node(&builder, nodes[i], false);
+  return proof_to_bytes(&builder, len);
+}
+
+static int cmp_paths(const void* a, const void* b) {
+  const bytes_t* x   = (const bytes_t*) a;
+  const bytes_t* y   = (const bytes_t*) b;
+  int            c   = memcmp(x->data, y->data, x->len < y->len ? x->len : y->len);
+  return c ? c : (int) x->len - (int) y->len;
+}
+
+ssz_ob_t patricia_create_multi_proof(node_t* root, bytes_t* paths, uint32_t len) {
+  ssz_builder_t builder                   = {.def = &PROOF_DEF};
+  node_t*       nodes[2][MAX_PROOF_DEPTH] = {0};
+  uint32_t      counts[2]                 = {0};
+  uint32_t      proof_len                 = 0;
+  bytes_t*      sorted                    = malloc(len * sizeof(bytes_t));
+  memcpy(sorted, paths, len * sizeof(bytes_t));
+  qsort(sorted, len, sizeof(bytes_t), cmp_paths);
+
+  // with sorted paths, the nodes a path shares with any previous path are the ones it shares with its predecessor.
+  // So skipping the common nodes of the last path adds each node exactly once in depth-first order.
+  for (uint32_t i = 0; i < len; i++) {
+    node_t** current = nodes[i & 1];
+    node_t** last    = nodes[(i + 1) & 1];
+    uint32_t common  = 0;
+    counts[i & 1]    = path_nodes(root, sorted[i], current);
+    while (i && common < counts[i & 1] && common < counts[(i + 1) & 1] && current[common] == last[common]) common++;
+    for (uint32_t n = common; n < counts[i & 1]; n++)
+      proof_len += add_proof_node(&builder, current[n], n == 0);
+  }
+  free(sorted);
+  return proof_to_bytes(&builder, proof_len);
 }
 
 bytes_t patricia_get_root(node_t* node) {
@@ -1,50 +1,57 @@
 #include "rlp.h"
 
-static int check_range(bytes_t* target, bytes_t* src, size_t new_len, uint8_t* new_start, rlp_type_t result_type) {
-  if (!target) return RLP_OUT_OF_RANGE;
-  *target = bytes(new_start, new_len);
-  return (new_start >= src->data && (new_start + new_len) >= src->data && (new_start + new_len) <= (src->data + src->len)) ? result_type : RLP_OUT_OF_RANGE;
+// decodes the header of the first item in data. Returns the type or RLP_OUT_OF_RANGE if the item exceeds the data.
+static rlp_type_t decode_item(bytes_t data, bytes_t* item) {
+  uint8_t    c      = data.data[0];
+  size_t     header = 1;
+  size_t     len    = 0;
+  rlp_type_t type   = c < 0xc0 ? RLP_ITEM : RLP_LIST;
+  if (c < 0x80) {
+    header = 0;
+    len    = 1;
+  }
+  else if (c < 0xb8 || (c >= 0xc0 && c < 0xf8))
+    len = c - (c < 0xc0 ? 0x80 : 0xc0);
+  else {
+    header += c - (c < 0xc0 ? 0xb7 : 0xf7);
+    if (header > data.len || header > 1 + sizeof(uint32_t)) return RLP_OUT_OF_RANGE;
+    for (size_t n = 1; n < header; n++) len = (len << 8) | data.data[n];
+  }
+  *item = bytes(data.data + header, len);
+  return header <= data.len && len <= data.len - header ? type : RLP_OUT_OF_RANGE;
+}
+
+rlp_type_t rlp_next(bytes_t* data, bytes_t* item) {
+  bytes_t    tmp  = {0};
+  rlp_type_t type = data->len ? decode_item(*data, &tmp) : RLP_NOT_FOUND;
+  if (type < 0) return type;
+  data->len -= tmp.data + tmp.len - data->data;
+  data->data = tmp.data + tmp.len;
+  if (item) *item = tmp;
+  return type;
+}
+
+int rlp_decode_list(bytes_t list, rlp_item_t* items, int max) {
+  int n = 0;
+  for (; list.len; n++) {
+    if (n == max) return RLP_OUT_OF_RANGE;
+    if ((items[n].type = rlp_next(&list, &items[n].data)) < 0) return RLP_OUT_OF_RANGE;
+  }
+  return n;
 }
 
 rlp_type_t rlp_decode(bytes_t* src, int index, bytes_t* target) {
-  size_t pos = 0, src_idx = 0;
-  for (; src_idx < src->len; src_idx++, pos++) {
-    uint8_t c = src->data[src_idx];
-    if (c < 0x80) {
-      if ((int) pos == index)
-        return check_range(target, src, 1, src->data + src_idx, 1);
-    }
-    else if (c < 0xb8) {
-      if ((int) pos == index)
-        return check_range(target, src, c - 0x80, src->data + src_idx + 1, RLP_ITEM);
-      src_idx += c - 0x80;
-    }
-    else if (c < 0xc0) {
-      size_t len, n;
-      for (len = 0, n = 0; n < (uint8_t) (c - 0xB7); n++)
-        len |= (*(src->data + src_idx + 1 + n)) << (8 * ((c - 0xb7) - n - 1));
-      if ((int) pos == index) return check_range(target, src, len, src->data + src_idx + c - 0xb7 + 1, RLP_ITEM);
-      src_idx += len + c - 0xb7;
-    }
-    else if (c < 0xf8) {
-      size_t len = c - 0xc0;
-      if ((int) pos == index)
-        return check_range(target, src, len, src->data + src_idx + 1, RLP_LIST);
-      src_idx += len;
-    }
-    else {
-      size_t len = 0;
-      for (size_t i = 0; i < (uint8_t) (c - 0xF7); i++)
-        len |= (*(src->data + src_idx + 1 + i)) << (8 * ((c - 0xf7) - i - 1));
-      if ((int) pos == index)
-        return check_range(target, src, len, src->data + src_idx + c - 0xf7 + 1, RLP_LIST);
-      src_idx += len + c - 0xf7;
+  bytes_t data = *src;
+  bytes_t item = {0};
+  for (int pos = 0; data.len; pos++) {
+    rlp_type_t type = rlp_next(&data, &item);
+    if (pos == index || type < 0) {
+      if (target) *target = item;
+      return pos == index && target ? type : RLP_OUT_OF_RANGE;
     }
+    if (index < 0 && !data.len) return (rlp_type_t) (pos + 1);
   }
-
-  if (index < 0) return src_idx == src->len ? (rlp_type_t) pos : RLP_OUT_OF_RANGE;
-
-  return (src_idx > src->len) ? RLP_OUT_OF_RANGE : RLP_NOT_FOUND;
+  return index < 0 ? RLP_SUCCESS : RLP_NOT_FOUND;
 }
 
 static void encode_length(buffer_t* buf, uint32_t len, uint8_t offset) {
@@ -82,6 +89,25 @@ void rlp_add_list(buffer_t* buf, bytes_t data) {
   buffer_append(buf, data);
 }
 
+void rlp_add_list_header(buffer_t* buf, uint32_t len) {
+  encode_length(buf, len, 0xc0);
+}
+
+static inline uint32_t header_len(uint32_t len) {
+  if (len < 56) return 1;
+  if (len < 0x100) return 2;
+  if (len < 0x10000) return 3;
+  return len < 0x1000000 ? 4 : 5;
+}
+
+uint32_t rlp_item_len(bytes_t data) {
+  return data.len == 1 && data.data[0] < 0x80 ? 1 : header_len(data.len) + data.len;
+}
+
+uint32_t rlp_list_len(uint32_t len) {
+  return header_len(len) + len;
+}
+
 void rlp_add_uint(buffer_t* buf, bytes_t data) {
   while (data.len && data.data[0] == 0) {
     data.data++;
@@ -19,15 +19,32 @@ typedef enum {
   RLP_LIST         = 2
 } rlp_type_t;
 
+typedef struct {
+  bytes_t    data; // the payload of the item
+  rlp_type_t type; // RLP_ITEM or RLP_LIST
+} rlp_item_t;
+
 rlp_type_t rlp_decode(bytes_t* data, int index, bytes_t* target);
+// decodes the next item and moves data behind it, so all items of a list are read in one pass.
+// returns RLP_NOT_FOUND at the end of the data or RLP_OUT_OF_RANGE for invalid data.
+rlp_type_t rlp_next(bytes_t* data, bytes_t* item);
+// decodes all items of the list at once. returns the number of items or RLP_OUT_OF_RANGE if invalid or more than max.
+int rlp_decode_list(bytes_t list, rlp_item_t* items, int max);
 uint64_t   rlp_get_uint64(bytes_t data, int index);
 
 void rlp_add_uint64(buffer_t* buf, uint64_t value);
 void rlp_add_uint(buffer_t* buf, bytes_t data);
 void rlp_add_item(buffer_t* buf, bytes_t data);
 void rlp_add_list(buffer_t* buf, bytes_t data);
+// writes the header of a list, whose payload of len bytes is added right after it.
+void rlp_add_list_header(buffer_t* buf, uint32_t len);
+// turns the content of the buffer into a list. This moves the whole payload, so use rlp_add_list_header if the length is known.
 void rlp_to_list(buffer_t* buf);
 
+// the length of an encoded item or list, so headers can be written before their payload.
+uint32_t rlp_item_len(bytes_t data);
+uint32_t rlp_list_len(uint32_t len);
+
 #ifdef __cplusplus
 }
 #endif
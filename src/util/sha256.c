@@ -0,0 +1,356 @@
+#include "crypto.h"
+#include "sha2.h"
+#include <string.h>
+
+// SHA-256 with accelerated backends, which are selected at runtime depending on the cpu:
+//
+//   - x86 SHA extensions (SHA-NI)
+//   - x86 AVX2, hashing 8 pairs at once (only used for sha256_pairs)
+//   - ARMv8 crypto extensions
+//
+// Embedded and wasm builds only use the portable implementation from libs/crypto/sha2.c.
+
+#if !defined(EMBEDDED) && !defined(__EMSCRIPTEN__) && defined(__GNUC__)
+#if defined(__x86_64__) || defined(__i386__)
+#define SHA256_X86
+#include <cpuid.h>
+#include <immintrin.h>
+#define SHANI_TARGET __attribute__((target("sha,sse4.1,ssse3")))
+#define AVX2_TARGET  __attribute__((target("avx2")))
+#elif defined(__aarch64__)
+#define SHA256_ARM
+#include <arm_neon.h>
+#if defined(__linux__)
+#include <sys/auxv.h>
+#ifndef HWCAP_SHA2
+#define HWCAP_SHA2 (1 << 6)
+#endif
+#endif
+#if defined(__clang__)
+#define ARM_TARGET __attribute__((target("crypto")))
+#else
+#define ARM_TARGET __attribute__((target("+crypto")))
+#endif
+#endif
+#endif
+
+// compresses n blocks of 64 bytes into the state
+typedef void (*sha256_compress_t)(uint32_t* state, const uint8_t* data, size_t blocks);
+// hashes n messages of 64 bytes each into n digests
+typedef void (*sha256_pairs_t)(const uint8_t* in, size_t n, uint8_t* out);
+
+static const uint32_t SHA256_IV[8] = {
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19};
+
+static inline uint32_t be32(const uint8_t* p) {
+  return ((uint32_t) p[0] << 24) | ((uint32_t) p[1] << 16) | ((uint32_t) p[2] << 8) | p[3];
+}
+
+static inline void write_be32(uint8_t* p, uint32_t v) {
+  p[0] = v >> 24;
+  p[1] = v >> 16;
+  p[2] = v >> 8;
+  p[3] = v;
+}
+
+static inline void write_digest(const uint32_t* state, uint8_t* out) {
+  for (int i = 0; i < 8; i++) write_be32(out + i * 4, state[i]);
+}
+
+// portable backend
+
+static void compress_portable(uint32_t* state, const uint8_t* data, size_t blocks) {
+  uint32_t words[16];
+  for (; blocks; blocks--, data += 64) {
+    for (int i = 0; i < 16; i++) words[i] = be32(data + i * 4);
+    sha256_Transform(state, words, state);
+  }
+}
+
+static void pairs_portable(const uint8_t* in, size_t n, uint8_t* out) {
+  static const uint32_t pad[16] = {0x80000000, [15] = 512};
+  uint32_t              state[8];
+  for (size_t i = 0; i < n; i++) {
+    memcpy(state, SHA256_IV, sizeof(state));
+    compress_portable(state, in + i * 64, 1);
+    sha256_Transform(state, pad, state);
+    write_digest(state, out + i * 32);
+  }
+}
+
+#if defined(SHA256_X86) || defined(SHA256_ARM)
+// the second block of a 64 byte message only contains the padding (0x80 ... length 512 bits).
+static const uint8_t SHA256_PAD_64[64] = {0x80, [62] = 0x02};
+
+static const uint32_t SHA256_K[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2};
+#endif
+
+#ifdef SHA256_X86
+
+SHANI_TARGET static void compress_shani(uint32_t* state, const uint8_t* data, size_t blocks) {
+  const __m128i mask = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+  __m128i       tmp  = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*) state), 0xB1);      // CDAB
+  __m128i       s1   = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*) (state + 4)), 0x1B); // EFGH
+  __m128i       s0   = _mm_alignr_epi8(tmp, s1, 8);                                           // ABEF
+  s1                 = _mm_blend_epi16(s1, tmp, 0xF0);                                        // CDGH
+
+  for (; blocks; blocks--, data += 64) {
+    __m128i abef = s0, cdgh = s1, w[4], msg;
+    for (int i = 0; i < 16; i++) {
+      if (i < 4)
+        w[i] = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*) (data + i * 16)), mask);
+      else
+        w[i & 3] = _mm_sha256msg2_epu32(_mm_add_epi32(_mm_sha256msg1_epu32(w[i & 3], w[(i + 1) & 3]),
+                                                      _mm_alignr_epi8(w[(i + 3) & 3], w[(i + 2) & 3], 4)),
+                                        w[(i + 3) & 3]);
+      msg = _mm_add_epi32(w[i & 3], _mm_loadu_si128((const __m128i*) (SHA256_K + i * 4)));
+      s1  = _mm_sha256rnds2_epu32(s1, s0, msg);
+      s0  = _mm_sha256rnds2_epu32(s0, s1, _mm_shuffle_epi32(msg, 0x0E));
+    }
+    s0 = _mm_add_epi32(s0, abef);
+    s1 = _mm_add_epi32(s1, cdgh);
+  }
+
+  tmp = _mm_shuffle_epi32(s0, 0x1B);                                       // FEBA
+  s1  = _mm_shuffle_epi32(s1, 0xB1);                                       // DCHG
+  _mm_storeu_si128((__m128i*) state, _mm_blend_epi16(tmp, s1, 0xF0));      // DCBA
+  _mm_storeu_si128((__m128i*) (state + 4), _mm_alignr_epi8(s1, tmp, 8)); // HGFE
+}
+
+static void pairs_shani(const uint8_t* in, size_t n, uint8_t* out) {
+  uint32_t state[8];
+  for (size_t i = 0; i < n; i++) {
+    memcpy(state, SHA256_IV, sizeof(state));
+    compress_shani(state, in + i * 64, 1);
+    compress_shani(state, SHA256_PAD_64, 1);
+    write_digest(state, out + i * 32);
+  }
+}
+
+// message schedule of the padding block of a 64 byte message with the round constants already added.
+static const uint32_t SHA256_PAD_64_KW[64] = {
+    0xc28a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf374,
+    0x649b69c1, 0xf0fe4786, 0x0fe1edc6, 0x240cf254, 0x4fe9346f, 0x6cc984be, 0x61b9411e, 0x16f988fa,
+    0xf2c65152, 0xa88e5a6d, 0xb019fc65, 0xb9d99ec7, 0x9a1231c3, 0xe70eeaa0, 0xfdb1232b, 0xc7353eb0,
+    0x3069bad5, 0xcb976d5f, 0x5a0f118f, 0xdc1eeefd, 0x0a35b689, 0xde0b7a04, 0x58f4ca9d, 0xe15d5b16,
+    0x007f3e86, 0x37088980, 0xa507ea32, 0x6fab9537, 0x17406110, 0x0d8cd6f1, 0xcdaa3b6d, 0xc0bbbe37,
+    0x83613bda, 0xdb48a363, 0x0b02e931, 0x6fd15ca7, 0x521afaca, 0x31338431, 0x6ed41a95, 0x6d437890,
+    0xc39c91f2, 0x9eccabbd, 0xb5c9a0e6, 0x532fb63c, 0xd2c741c6, 0x07237ea3, 0xa4954b68, 0x4c191d76};
+
+#define ROTR8(x, n) _mm256_or_si256(_mm256_srli_epi32(x, n), _mm256_slli_epi32(x, 32 - (n)))
+#define ADD8(a, b)  _mm256_add_epi32(a, b)
+#define XOR8(a, b)  _mm256_xor_si256(a, b)
+
+// runs the 64 rounds for 8 lanes, where kw holds the message schedule with the round constants already added
+AVX2_TARGET static inline void rounds_x8(__m256i* s, const __m256i* kw) {
+  __m256i a = s[0], b = s[1], c = s[2], d = s[3], e = s[4], f = s[5], g = s[6], h = s[7];
+  for (int t = 0; t < 64; t++) {
+    __m256i t1 = ADD8(ADD8(h, XOR8(XOR8(ROTR8(e, 6), ROTR8(e, 11)), ROTR8(e, 25))),
+                      ADD8(XOR8(_mm256_and_si256(e, f), _mm256_andnot_si256(e, g)), kw[t]));
+    __m256i t2 = ADD8(XOR8(XOR8(ROTR8(a, 2), ROTR8(a, 13)), ROTR8(a, 22)),
+                      XOR8(_mm256_and_si256(a, XOR8(b, c)), _mm256_and_si256(b, c)));
+    h          = g;
+    g          = f;
+    f          = e;
+    e          = ADD8(d, t1);
+    d          = c;
+    c          = b;
+    b          = a;
+    a          = ADD8(t1, t2);
+  }
+  s[0] = ADD8(s[0], a);
+  s[1] = ADD8(s[1], b);
+  s[2] = ADD8(s[2], c);
+  s[3] = ADD8(s[3], d);
+  s[4] = ADD8(s[4], e);
+  s[5] = ADD8(s[5], f);
+  s[6] = ADD8(s[6], g);
+  s[7] = ADD8(s[7], h);
+}
+
+// hashes 8 messages of 64 bytes at once, each lane of the vectors holds one message
+AVX2_TARGET static void pairs_avx2_x8(const uint8_t* in, uint8_t* out) {
+  const __m256i bswap = _mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12,
+                                         3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+  const __m256i lanes = _mm256_setr_epi32(0, 16, 32, 48, 64, 80, 96, 112);
+  __m256i       w[64], kw[64], s[8];
+  uint32_t      words[8];
+
+  for (int t = 0; t < 16; t++)
+    w[t] = _mm256_shuffle_epi8(_mm256_i32gather_epi32((const int*) (in + t * 4), lanes, 4), bswap);
+  for (int t = 16; t < 64; t++) {
+    __m256i s0 = XOR8(XOR8(ROTR8(w[t - 15], 7), ROTR8(w[t - 15], 18)), _mm256_srli_epi32(w[t - 15], 3));
+    __m256i s1 = XOR8(XOR8(ROTR8(w[t - 2], 17), ROTR8(w[t - 2], 19)), _mm256_srli_epi32(w[t - 2], 10));
+    w[t]       = ADD8(ADD8(w[t - 16], s0), ADD8(w[t - 7], s1));
+  }
+  for (int t = 0; t < 64; t++) kw[t] = ADD8(w[t], _mm256_set1_epi32((int) SHA256_K[t]));
+  for (int i = 0; i < 8; i++) s[i] = _mm256_set1_epi32((int) SHA256_IV[i]);
+  rounds_x8(s, kw);
+
+  for (int t = 0; t < 64; t++) kw[t] = _mm256_set1_epi32((int) SHA256_PAD_64_KW[t]);
+  rounds_x8(s, kw);
+
+  for (int i = 0; i < 8; i++) {
+    _mm256_storeu_si256((__m256i*) words, s[i]);
+    for (int lane = 0; lane < 8; lane++) write_be32(out + lane * 32 + i * 4, words[lane]);
+  }
+}
+
+// used for the pairs left over after the batches of 8
+static sha256_pairs_t pairs_avx2_rest = pairs_portable;
+
+static void pairs_avx2(const uint8_t* in, size_t n, uint8_t* out) {
+  for (; n >= 8; n -= 8, in += 512, out += 256) pairs_avx2_x8(in, out);
+  if (n) pairs_avx2_rest(in, n, out);
+}
+
+static void cpu_features(bool* sha, bool* avx2) {
+  unsigned int eax, ebx, ecx, edx;
+  *sha = *avx2 = false;
+  if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx)) return;
+  bool sse41 = ecx & (1 << 19), ssse3 = ecx & (1 << 9);
+  bool avx   = (ecx & (1 << 27)) && (ecx & (1 << 28)); // OSXSAVE + AVX
+  if (avx) {
+    uint32_t xcr0_lo, xcr0_hi;
+    __asm__("xgetbv" : "=a"(xcr0_lo), "=d"(xcr0_hi) : "c"(0));
+    avx = (xcr0_lo & 6) == 6; // the os saves the ymm registers
+  }
+  if (__get_cpuid_max(0, NULL) < 7) return;
+  __cpuid_count(7, 0, eax, ebx, ecx, edx);
+  *sha  = (ebx & (1 << 29)) && sse41 && ssse3;
+  *avx2 = (ebx & (1 << 5)) && avx;
+}
+
+#endif
+
+#ifdef SHA256_ARM
+
+ARM_TARGET static void compress_arm(uint32_t* state, const uint8_t* data, size_t blocks) {
+  uint32x4_t s0 = vld1q_u32(state), s1 = vld1q_u32(state + 4);
+
+  for (; blocks; blocks--, data += 64) {
+    uint32x4_t abcd = s0, efgh = s1, w[4], kw, tmp;
+    for (int i = 0; i < 4; i++)
+      w[i] = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(data + i * 16)));
+    for (int i = 0; i < 16; i++) {
+      kw = vaddq_u32(w[i & 3], vld1q_u32(SHA256_K + i * 4));
+      if (i < 12) w[i & 3] = vsha256su1q_u32(vsha256su0q_u32(w[i & 3], w[(i + 1) & 3]), w[(i + 2) & 3], w[(i + 3) & 3]);
+      tmp = s0;
+      s0  = vsha256hq_u32(s0, s1, kw);
+      s1  = vsha256h2q_u32(s1, tmp, kw);
+    }
+    s0 = vaddq_u32(s0, abcd);
+    s1 = vaddq_u32(s1, efgh);
+  }
+
+  vst1q_u32(state, s0);
+  vst1q_u32(state + 4, s1);
+}
+
+static void pairs_arm(const uint8_t* in, size_t n, uint8_t* out) {
+  uint32_t state[8];
+  for (size_t i = 0; i < n; i++) {
+    memcpy(state, SHA256_IV, sizeof(state));
+    compress_arm(state, in + i * 64, 1);
+    compress_arm(state, SHA256_PAD_64, 1);
+    write_digest(state, out + i * 32);
+  }
+}
+
+static bool cpu_has_sha2() {
+#if defined(__ARM_FEATURE_SHA2) || defined(__ARM_FEATURE_CRYPTO) || defined(__APPLE__)
+  return true;
+#elif defined(__linux__)
+  return (getauxval(AT_HWCAP) & HWCAP_SHA2) != 0;
+#else
+  return false;
+#endif
+}
+
+#endif
+
+static sha256_compress_t sha256_compress   = compress_portable;
+static sha256_pairs_t    sha256_pairs_impl = pairs_portable;
+static const char*       sha256_name       = "portable";
+
+#if defined(SHA256_X86) || defined(SHA256_ARM)
+// picks the backend once when the library is loaded, so there is no race when hashing from different threads.
+__attribute__((constructor)) static void sha256_select_backend() {
+#ifdef SHA256_X86
+  bool sha, avx2;
+  cpu_features(&sha, &avx2);
+  if (sha) {
+    sha256_compress   = compress_shani;
+    sha256_pairs_impl = pairs_shani;
+    pairs_avx2_rest   = pairs_shani;
+    sha256_name       = "sha-ni";
+  }
+  // for whole batches 8 lanes in avx2 are still faster than hashing one pair after the other with sha-ni
+  if (avx2) {
+    sha256_pairs_impl = pairs_avx2;
+    sha256_name       = sha ? "sha-ni+avx2" : "avx2";
+  }
+#else
+  if (cpu_has_sha2()) {
+    sha256_compress   = compress_arm;
+    sha256_pairs_impl = pairs_arm;
+    sha256_name       = "armv8";
+  }
+#endif
+}
+#endif
+
+const char* sha256_backend() {
+  return sha256_name;
+}
+
+void sha256_pairs(const uint8_t* in, size_t n, uint8_t* out) {
+  sha256_pairs_impl(in, n, out);
+}
+
+void sha256(bytes_t data, uint8_t* out) {
+  if (sha256_compress == compress_portable) {
+    sha256_Raw(data.data, data.len, out);
+    return;
+  }
+
+  uint32_t state[8];
+  uint8_t  last[128] = {0};
+  size_t   blocks    = data.len / 64;
+  size_t   rest      = data.len % 64;
+  size_t   tail      = rest < 56 ? 64 : 128;
+  uint64_t bits      = (uint64_t) data.len << 3;
+
+  memcpy(state, SHA256_IV, sizeof(state));
+  sha256_compress(state, data.data, blocks);
+  if (rest) memcpy(last, data.data + blocks * 64, rest);
+  last[rest] = 0x80;
+  for (int i = 0; i < 8; i++) last[tail - 1 - i] = (uint8_t) (bits >> (i * 8));
+  sha256_compress(state, last, tail / 64);
+  write_digest(state, out);
+}
+
+void sha256_merkle(bytes_t data1, bytes_t data2, uint8_t* out) {
+  if (data1.len == 32 && data2.len == 32) {
+    uint8_t pair[64];
+    memcpy(pair, data1.data, 32);
+    memcpy(pair + 32, data2.data, 32);
+    sha256_pairs_impl(pair, 1, out);
+    return;
+  }
+
+  SHA256_CTX ctx;
+  sha256_Init(&ctx);
+  sha256_Update(&ctx, data1.data, data1.len);
+  sha256_Update(&ctx, data2.data, data2.len);
+  sha256_Final(&ctx, out);
+}
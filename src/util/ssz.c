@@ -1,4 +1,5 @@
 #include "ssz.h"
+#include "compat.h"
 #include "crypto.h"
 #include "json.h"
 #include "state.h"
@@ -6,6 +7,7 @@
 #include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
+#include <stdlib.h>
 #include <string.h>
 
 // predefined types
@@ -18,36 +20,143 @@ static bool is_basic_type(const ssz_def_t* def) {
   return def->type == SSZ_TYPE_UINT || def->type == SSZ_TYPE_BOOLEAN || def->type == SSZ_TYPE_NONE;
 }
 
+#define LAYOUT_BUCKETS 256
+
+// layouts are keyed by the definition of the container. Only static definitions are cached, since local ones may reuse an address.
+static ssz_layout_t* layout_cache[LAYOUT_BUCKETS] = {0};
+
+static inline uint32_t layout_bucket(const ssz_def_t* def) {
+  return (uint32_t) ((((uintptr_t) def >> 3) * 2654435761u) >> 8) & (LAYOUT_BUCKETS - 1);
+}
+
+uint32_t ssz_name_hash(const char* name) {
+  uint32_t hash = 2166136261u;
+  for (; name && *name; name++) hash = (hash ^ (uint8_t) *name) * 16777619u;
+  return hash;
+}
+
+static ssz_layout_t* create_layout(const ssz_def_t* def) {
+  uint32_t      len    = def->def.container.len;
+  ssz_layout_t* layout = calloc(1, sizeof(ssz_layout_t) + len * sizeof(ssz_field_layout_t));
+  layout->def          = def;
+  layout->len          = len;
+  layout->fields       = (ssz_field_layout_t*) (layout + 1);
+
+  ssz_field_layout_t* last_dynamic = NULL;
+  for (uint32_t i = 0; i < len; i++) {
+    const ssz_def_t*    el    = def->def.container.elements + i;
+    ssz_field_layout_t* field = layout->fields + i;
+    field->offset             = layout->fixed_length;
+    field->dynamic            = ssz_is_dynamic(el);
+    field->length             = ssz_fixed_length(el);
+    field->name_hash          = ssz_name_hash(el->name);
+    if (field->dynamic) {
+      if (last_dynamic) last_dynamic->next_offset = field->offset;
+      last_dynamic    = field;
+      layout->dynamic = true;
+    }
+    layout->fixed_length += field->length;
+  }
+  layout->always_valid = !layout->dynamic;
+  for (uint32_t i = 0; i < len && layout->always_valid; i++)
+    layout->always_valid = ssz_is_always_valid(def->def.container.elements + i);
+  return layout;
+}
+
+const ssz_layout_t* ssz_layout(const ssz_def_t* def) {
+  if (!def || def->type != SSZ_TYPE_CONTAINER || def->def.container.local) return NULL;
+  ssz_layout_t** bucket = layout_cache + layout_bucket(def);
+  ssz_layout_t*  head   = (ssz_layout_t*) c4_atomic_load_ptr(bucket);
+  for (ssz_layout_t* l = head; l; l = l->next) {
+    if (l->def == def) return l;
+  }
+
+  // build it outside of any lock. If another thread publishes the same layout first, we use theirs.
+  ssz_layout_t* layout = create_layout(def);
+  while (true) {
+    layout->next = head;
+    if (c4_atomic_cas_ptr(bucket, head, layout)) return layout;
+    head = (ssz_layout_t*) c4_atomic_load_ptr(bucket);
+    for (ssz_layout_t* l = head; l; l = l->next) {
+      if (l->def == def) {
+        free(layout);
+        return l;
+      }
+    }
+  }
+}
+
+const ssz_layout_t* ssz_layout_of(const ssz_def_t* def, ssz_layout_t** owned) {
+  *owned = NULL;
+  if (!def || def->type != SSZ_TYPE_CONTAINER) return NULL;
+  if (!def->def.container.local) return ssz_layout(def);
+  *owned = create_layout(def);
+  return *owned;
+}
+
+void ssz_layout_cache_free() {
+  for (int i = 0; i < LAYOUT_BUCKETS; i++) {
+    ssz_layout_t* l = layout_cache[i];
+    layout_cache[i] = NULL;
+    while (l) {
+      ssz_layout_t* next = l->next;
+      free(l);
+      l = next;
+    }
+  }
+}
+
+bool ssz_is_always_valid(const ssz_def_t* def) {
+  switch (def->type) {
+    case SSZ_TYPE_UINT:
+    case SSZ_TYPE_BIT_VECTOR:
+    case SSZ_TYPE_NONE:
+      return true;
+    case SSZ_TYPE_VECTOR:
+      return !ssz_is_dynamic(def->def.vector.type) && ssz_is_always_valid(def->def.vector.type);
+    case SSZ_TYPE_CONTAINER: {
+      ssz_layout_t* owned = NULL;
+      bool          valid = ssz_layout_of(def, &owned)->always_valid;
+      free(owned);
+      return valid;
+    }
+    default:
+      return false;
+  }
+}
+
 // checks if a definition has a dynamic length
 bool ssz_is_dynamic(const ssz_def_t* def) {
   if (def->type == SSZ_TYPE_CONTAINER) {
-    for (int i = 0; i < def->def.container.len; i++) {
-      if (ssz_is_dynamic(def->def.container.elements + i))
-        return true;
-    }
+    ssz_layout_t* owned   = NULL;
+    bool          dynamic = ssz_layout_of(def, &owned)->dynamic;
+    free(owned);
+    return dynamic;
   }
-
   return def->type == SSZ_TYPE_LIST || def->type == SSZ_TYPE_BIT_LIST || def->type == SSZ_TYPE_UNION;
 }
 // gets the length of a type for the fixed part.
 size_t ssz_fixed_length(const ssz_def_t* def) {
-  if (ssz_is_dynamic(def))
-    return 4;
   switch (def->type) {
     case SSZ_TYPE_UINT:
       return def->def.uint.len;
     case SSZ_TYPE_BOOLEAN:
       return 1;
     case SSZ_TYPE_CONTAINER: {
-      size_t len = 0;
-      for (int i = 0; i < def->def.container.len; i++)
-        len += ssz_fixed_length(def->def.container.elements + i);
+      ssz_layout_t*       owned  = NULL;
+      const ssz_layout_t* layout = ssz_layout_of(def, &owned);
+      size_t              len    = layout->dynamic ? 4 : layout->fixed_length;
+      free(owned);
       return len;
     }
     case SSZ_TYPE_VECTOR:
       return def->def.vector.len * ssz_fixed_length(def->def.vector.type);
     case SSZ_TYPE_BIT_VECTOR:
       return (def->def.vector.len + 7) >> 3;
+    case SSZ_TYPE_LIST:
+    case SSZ_TYPE_BIT_LIST:
+    case SSZ_TYPE_UNION:
+      return 4;
     default:
       return 0;
   }
@@ -66,44 +175,32 @@ static bool failure(char* fnt) {
     return failure(fmt);                              \
   } while (0)
 
-bool ssz_is_valid(ssz_ob_t ob, bool recursive, c4_state_t* state) {
+// checks the length and offsets of the object itself without looking into its children.
+static bool is_valid_self(ssz_ob_t ob, c4_state_t* state) {
   switch (ob.def->type) {
     case SSZ_TYPE_BOOLEAN:
       if (ob.bytes.len != 1 || ob.bytes.data[0] > 1) THROW_INVALID("invalid boolean value");
       return true;
     case SSZ_TYPE_VECTOR:
       if (ob.bytes.len != ob.def->def.vector.len * ssz_fixed_length(ob.def->def.vector.type)) THROW_INVALID("Invalid bytelength for vector");
-      if (recursive && ob.def->def.vector.type->type != SSZ_TYPE_UINT) {
-        for (int i = 0; i < ob.def->def.vector.len; i++) {
-          ssz_ob_t el = ssz_at(ob, i);
-          if (!ssz_is_valid(el, recursive, state)) return false;
-        }
-      }
       return true;
     case SSZ_TYPE_LIST:
       if (ssz_is_dynamic(ob.def->def.vector.type)) {
         if (ob.bytes.len == 0) return true;
         if (ob.bytes.len < 4) THROW_INVALID("Invalid bytelength for list");
         uint32_t first_offset = uint32_from_le(ob.bytes.data);
-        if (first_offset >= ob.bytes.len || first_offset < 4) THROW_INVALID("Invalid first offset for list");
+        if (first_offset >= ob.bytes.len || first_offset < 4 || first_offset % 4) THROW_INVALID("Invalid first offset for list");
         uint32_t offset = first_offset;
-        for (int i = 4; i < first_offset; i += 4) {
+        for (uint32_t i = 4; i < first_offset; i += 4) {
           uint32_t next_offset = uint32_from_le(ob.bytes.data + i);
           if (next_offset >= ob.bytes.len || next_offset < offset) THROW_INVALID("Invalid  offset for list");
-          if (recursive && !ssz_is_valid(ssz_ob(*ob.def->def.vector.type, bytes(ob.bytes.data + offset, next_offset - offset)), recursive, state)) return false;
           offset = next_offset;
         }
-        if (recursive && !ssz_is_valid(ssz_ob(*ob.def->def.vector.type, bytes(ob.bytes.data + offset, ob.bytes.len - offset)), recursive, state)) return false;
         return true;
       }
-      int fixed_length = ssz_fixed_length(ob.def->def.vector.type);
+      uint32_t fixed_length = ssz_fixed_length(ob.def->def.vector.type);
       if (ob.bytes.len % fixed_length != 0 ||
           ob.bytes.len > ob.def->def.vector.len * fixed_length) THROW_INVALID("Invalid length for list");
-      if (recursive && ob.def->type != SSZ_TYPE_UINT) {
-        for (int i = 0; i < ob.bytes.len; i += fixed_length) {
-          if (!ssz_is_valid(ssz_ob(*ob.def->def.vector.type, bytes(ob.bytes.data + i, fixed_length)), recursive, state)) return false;
-        }
-      }
       return true;
     case SSZ_TYPE_BIT_VECTOR:
       return ob.bytes.len == (ob.def->def.vector.len + 7) >> 3;
@@ -111,46 +208,107 @@ bool ssz_is_valid(ssz_ob_t ob, bool recursive, c4_state_t* state) {
       return ob.bytes.len <= (ob.def->def.vector.len + 7) >> 3;
     case SSZ_TYPE_UINT:
       return ob.bytes.len == ob.def->def.uint.len;
-    case SSZ_TYPE_CONTAINER:
-      if (ssz_is_dynamic(ob.def) ? (ob.bytes.len < ssz_fixed_length(ob.def)) : (ob.bytes.len != ssz_fixed_length(ob.def))) THROW_INVALID("Invalid length for container");
-      if (recursive) {
-        ssz_ob_t last_ob     = {0};
-        uint32_t last_offset = 0;
-        uint32_t pos         = 0;
-        for (int i = 0; i < ob.def->def.container.len; i++) {
-          const ssz_def_t* def = ob.def->def.container.elements + i;
-          if (ssz_is_dynamic(def)) {
-            uint32_t offset = uint32_from_le(ob.bytes.data + pos);
-            if (offset > ob.bytes.len || offset < pos + 4 || last_offset > offset) THROW_INVALID("Invalid offset for container");
-            if (last_ob.def) {
-              last_ob.bytes = bytes(ob.bytes.data + last_offset, offset - last_offset);
-              if (!ssz_is_valid(last_ob, recursive, state)) return false;
-            }
-            last_ob.def = def;
-            last_offset = offset;
-            pos += 4;
-          }
-          else {
-            uint32_t len = ssz_fixed_length(def);
-            if (!ssz_is_valid(ssz_ob(*def, bytes(ob.bytes.data + pos, len)), recursive, state)) return false;
-            pos += len;
-          }
-        }
-        if (last_ob.def) {
-          last_ob.bytes = bytes(ob.bytes.data + last_offset, ob.bytes.len - last_offset);
-          if (!ssz_is_valid(last_ob, recursive, state)) return false;
-        }
+    case SSZ_TYPE_CONTAINER: {
+      ssz_layout_t*       owned       = NULL;
+      const ssz_layout_t* layout      = ssz_layout_of(ob.def, &owned);
+      bool                length_ok   = layout->dynamic ? (ob.bytes.len >= layout->fixed_length) : (ob.bytes.len == layout->fixed_length);
+      bool                offsets_ok  = true;
+      uint32_t            last_offset = 0;
+      for (uint32_t i = 0; i < layout->len && layout->dynamic && length_ok && offsets_ok; i++) {
+        const ssz_field_layout_t* field = layout->fields + i;
+        if (!field->dynamic) continue;
+        uint32_t offset = uint32_from_le(ob.bytes.data + field->offset);
+        offsets_ok      = offset <= ob.bytes.len && offset >= field->offset + 4 && last_offset <= offset;
+        last_offset     = offset;
       }
+      free(owned);
+      if (!length_ok) THROW_INVALID("Invalid length for container");
+      if (!offsets_ok) THROW_INVALID("Invalid offset for container");
       return true;
+    }
     case SSZ_TYPE_UNION:
       if (ob.bytes.len == 0 || ob.bytes.data[0] >= ob.def->def.container.len) THROW_INVALID("Invalid selector for union");
-      if (recursive && ob.def->def.container.elements[ob.bytes.data[0]].type != SSZ_TYPE_NONE && !ssz_is_valid(ssz_ob(ob.def->def.container.elements[ob.bytes.data[0]], bytes(ob.bytes.data + 1, ob.bytes.len - 1)), recursive, state)) return false;
       return true;
     default:
       return true;
   }
 }
 
+// the number of children, which need to be validated. Elements, which are valid for any bytes of their fixed length, are skipped.
+static uint32_t children_to_validate(ssz_ob_t ob) {
+  switch (ob.def->type) {
+    case SSZ_TYPE_VECTOR:
+      return ssz_is_always_valid(ob.def->def.vector.type) ? 0 : ob.def->def.vector.len;
+    case SSZ_TYPE_LIST:
+      return ssz_is_always_valid(ob.def->def.vector.type) ? 0 : ssz_len(ob);
+    case SSZ_TYPE_CONTAINER: {
+      ssz_layout_t* owned        = NULL;
+      bool          always_valid = ssz_layout_of(ob.def, &owned)->always_valid;
+      free(owned);
+      return always_valid ? 0 : ob.def->def.container.len;
+    }
+    case SSZ_TYPE_UNION:
+      return ob.def->def.container.elements[ob.bytes.data[0]].type != SSZ_TYPE_NONE;
+    default:
+      return 0;
+  }
+}
+
+// returns the child at the index of an object, which passed is_valid_self.
+static ssz_ob_t validation_child(ssz_ob_t ob, uint32_t index) {
+  if (ob.def->type == SSZ_TYPE_UNION)
+    return ssz_ob(ob.def->def.container.elements[ob.bytes.data[0]], bytes(ob.bytes.data + 1, ob.bytes.len - 1));
+  if (ob.def->type != SSZ_TYPE_CONTAINER) return ssz_at(ob, index);
+
+  ssz_layout_t*            owned = NULL;
+  const ssz_field_layout_t field = ssz_layout_of(ob.def, &owned)->fields[index];
+  const ssz_def_t*         def   = ob.def->def.container.elements + index;
+  free(owned);
+  if (!field.dynamic) return ssz_ob(*def, bytes(ob.bytes.data + field.offset, field.length));
+  uint32_t offset = uint32_from_le(ob.bytes.data + field.offset);
+  uint32_t end    = field.next_offset ? uint32_from_le(ob.bytes.data + field.next_offset) : ob.bytes.len;
+  return ssz_ob(*def, bytes(ob.bytes.data + offset, end - offset));
+}
+
+#define MAX_VALIDATION_DEPTH 32
+
+typedef struct {
+  ssz_ob_t ob;    // the object whose children are validated
+  uint32_t index; // the next child to validate
+  uint32_t len;   // the number of children
+} validation_frame_t;
+
+bool ssz_is_valid(ssz_ob_t ob, bool recursive, c4_state_t* state) {
+  if (!is_valid_self(ob, state)) return false;
+  if (!recursive) return true;
+
+  // walk the tree depth first with an explicit stack, so each byte range is only checked once
+  validation_frame_t stack[MAX_VALIDATION_DEPTH];
+  int                depth = 0;
+  uint32_t           len   = children_to_validate(ob);
+  if (len) stack[depth++] = (validation_frame_t) {.ob = ob, .index = 0, .len = len};
+
+  while (depth) {
+    validation_frame_t* frame = stack + depth - 1;
+    if (frame->index == frame->len) {
+      depth--;
+      continue;
+    }
+    if (frame->ob.def->type == SSZ_TYPE_CONTAINER && ssz_is_always_valid(frame->ob.def->def.container.elements + frame->index)) {
+      frame->index++;
+      continue;
+    }
+
+    ssz_ob_t child = validation_child(frame->ob, frame->index++);
+    if (!child.def) THROW_INVALID("Invalid element");
+    if (!is_valid_self(child, state)) return false;
+    if (!(len = children_to_validate(child))) continue;
+    if (depth == MAX_VALIDATION_DEPTH) THROW_INVALID("ssz object is nested too deep");
+    stack[depth++] = (validation_frame_t) {.ob = child, .index = 0, .len = len};
+  }
+  return true;
+}
+
 ssz_ob_t ssz_union(ssz_ob_t ob) {
   ssz_ob_t res = {0};
   // check if the object is valid
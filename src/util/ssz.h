@@ -43,6 +43,7 @@ struct ssz_def {
     struct ssz_container {
       const ssz_def_t* elements; /**< the elements in the container */
       uint32_t         len;      /**< the number of elements in the container or un*/
+      bool             local;    /**< the definition lives on the stack or heap, so its layout is not cached */
     } container;                 /**< container or union definitions */
     struct ssz_list {
       const ssz_def_t* type; /**< the type of the elements in the vector or list */
@@ -92,6 +93,22 @@ ssz_ob_t ssz_at(ssz_ob_t ob, uint32_t index);
 /** gets the value of a field with the given name. If the data is not a container or union or if the field is not found, it will return an empty object */
 ssz_ob_t ssz_get(ssz_ob_t* ob, const char* name);
 
+/** gets the field of a container by its index */
+ssz_ob_t ssz_get_field(ssz_ob_t* ob, int index);
+
+/** gets a fixed field of a container with a known position within the fixed part, as used by generated accessors.
+ * An empty object is returned if the object is not a container of the given elements. */
+static inline ssz_ob_t ssz_get_fixed_field(ssz_ob_t* ob, const ssz_def_t* elements, int index, uint32_t offset, uint32_t len) {
+  if (!ob->def || ob->def->type != SSZ_TYPE_CONTAINER || ob->def->def.container.elements != elements || !ob->bytes.data || ob->bytes.len < offset + len) return (ssz_ob_t) {0};
+  return (ssz_ob_t) {.def = elements + index, .bytes = bytes(ob->bytes.data + offset, len)};
+}
+
+/** gets a dynamic field of a container by its index, as used by generated accessors */
+static inline ssz_ob_t ssz_get_indexed_field(ssz_ob_t* ob, const ssz_def_t* elements, int index) {
+  if (!ob->def || ob->def->type != SSZ_TYPE_CONTAINER || ob->def->def.container.elements != elements) return (ssz_ob_t) {0};
+  return ssz_get_field(ob, index);
+}
+
 static inline uint64_t ssz_get_uint64(ssz_ob_t* ob, char* name) {
   return ssz_uint64(ssz_get(ob, name));
 }
@@ -113,6 +130,35 @@ uint8_t  ssz_union_selector(const ssz_def_t* union_types, size_t union_types_len
 
 // returns the length of the fixed part of the object
 size_t ssz_fixed_length(const ssz_def_t* def);
+
+/** the precomputed position of a field within the fixed part of a container */
+typedef struct {
+  uint32_t offset;      /**< position of the value (or its offset for dynamic fields) in the fixed part */
+  uint32_t length;      /**< length within the fixed part (4 for dynamic fields) */
+  uint32_t next_offset; /**< position of the offset of the next dynamic field or 0 if there is none */
+  uint32_t name_hash;   /**< fnv1a hash of the name of the field */
+  bool     dynamic;     /**< true if the field has a dynamic length */
+} ssz_field_layout_t;
+
+/** the layout of a container, which is built once per static definition and cached until ssz_layout_cache_free */
+typedef struct ssz_layout {
+  const ssz_def_t*    def;          /**< the definition of the container used as key */
+  uint32_t            len;          /**< number of fields */
+  uint32_t            fixed_length; /**< length of the fixed part */
+  bool                dynamic;      /**< true if any field is dynamic */
+  bool                always_valid; /**< true if any bytes of the fixed length are a valid value */
+  ssz_field_layout_t* fields;       /**< the layout of each field */
+  struct ssz_layout*  next;         /**< next entry in the cache bucket */
+} ssz_layout_t;
+
+/** the hash of a field name as used in the layout */
+uint32_t ssz_name_hash(const char* name);
+/** returns the cached layout of a static container definition or NULL for any other type or local definitions. The cache is thread safe. */
+const ssz_layout_t* ssz_layout(const ssz_def_t* def);
+/** returns the layout of any container. Layouts of local definitions (SSZ_LOCAL_CONTAINER) are built uncached and also written to owned, which must be freed. */
+const ssz_layout_t* ssz_layout_of(const ssz_def_t* def, ssz_layout_t** owned);
+/** frees all cached layouts. It must only be called, when no other thread uses ssz objects anymore. */
+void ssz_layout_cache_free();
 /** dumps the object to a file */
 void  ssz_dump_to_file(FILE* f, ssz_ob_t ob, bool include_name, bool write_unit_as_hex);
 char* ssz_dump_to_str(ssz_ob_t ob, bool include_name, bool write_unit_as_hex);
@@ -125,10 +171,30 @@ bytes_t  ssz_create_multi_proof(ssz_ob_t root, bytes32_t root_hash, int gindex_l
 gindex_t ssz_gindex(const ssz_def_t* def, int num_elements, ...);
 bytes_t  ssz_create_multi_proof_for_gindexes(ssz_ob_t root, bytes32_t root_hash, gindex_t* gindex, int gindex_len);
 
+/**
+ * a hashed view of a ssz object, which keeps the hashes of all nodes of its merkle tree.
+ * Once created, it does not reference the bytes of the object anymore and can be used
+ * to create any number of proofs without hashing the object again.
+ */
+typedef struct ssz_hashed ssz_hashed_t;
+
+/** hashes the object and keeps all nodes. The view must be freed with ssz_hashed_free */
+ssz_hashed_t* ssz_hashed_create(ssz_ob_t ob);
+/** writes the hash_tree_root of the object */
+void ssz_hashed_root(const ssz_hashed_t* view, bytes32_t out);
+/** writes the hash of the node with the gindex. returns false if the gindex is not part of the tree */
+bool ssz_hashed_get(const ssz_hashed_t* view, gindex_t gindex, bytes32_t out);
+/** creates a multi proof for the gindexes (same format as ssz_create_multi_proof_for_gindexes) */
+bytes_t ssz_hashed_multi_proof(const ssz_hashed_t* view, gindex_t* gindex, int gindex_len);
+void    ssz_hashed_free(ssz_hashed_t* view);
+
 // checks if a definition has a dynamic length
 bool ssz_is_dynamic(const ssz_def_t* def);
 bool ssz_is_type(ssz_ob_t* ob, const ssz_def_t* def);
+/** validates the lengths and offsets of the object. With recursive=true all children are checked in a single pass without recursion */
 bool ssz_is_valid(ssz_ob_t ob, bool recursive, c4_state_t* state);
+/** true if any bytes of the fixed length of the type are a valid value, so the value does not need to be validated */
+bool ssz_is_always_valid(const ssz_def_t* def);
 
 extern const ssz_def_t ssz_uint8;
 extern const ssz_def_t ssz_bytes32;
@@ -172,6 +238,15 @@ extern const ssz_def_t ssz_bytes_list;
     .def.container = {.elements = children,                         \
                       .len      = sizeof(children) / sizeof(ssz_def_t) } \
   }
+// a container defined on the stack or heap. Its layout is not cached, since another definition may reuse its address later.
+#define SSZ_LOCAL_CONTAINER(propname, children)                     \
+  {                                                                 \
+    .name          = propname,                                      \
+    .type          = SSZ_TYPE_CONTAINER,                            \
+    .def.container = {.elements = children,                         \
+                      .len      = sizeof(children) / sizeof(ssz_def_t), \
+                      .local    = true }                          \
+  }
 #define SSZ_UNION(propname, children)                               \
   {                                                                 \
     .name          = propname,                                      \
@@ -210,6 +285,43 @@ void     ssz_buffer_free(ssz_builder_t* buffer);
 // converts the ssz_buffer to bytes and the frees up the buffer
 // make sure to free the returned after using
 ssz_ob_t ssz_builder_to_bytes(ssz_builder_t* buffer);
+
+/**
+ * a node of a value tree, which is serialized in two phases: first the sizes of all nodes are calculated,
+ * then the value is written once into a single preallocated buffer. Nested containers and lists are never copied
+ * and the bytes of the leafs are only referenced, so they must stay valid until the tree is serialized.
+ */
+typedef struct ssz_node {
+  const ssz_def_t* def;      /**< the definition of the value */
+  bytes_t          bytes;    /**< the serialized value of a leaf (not copied) */
+  struct ssz_node* children; /**< the fields of a container, the elements of a list or the selected value of a union */
+  uint32_t         len;      /**< the number of children */
+  uint32_t         size;     /**< the serialized size as calculated by ssz_node_size */
+  uint64_t         uint;     /**< the value of a uint leaf without bytes or the selector of a union */
+} ssz_node_t;
+
+/** creates a new node for the given definition */
+#define ssz_node(def_ptr) \
+  (ssz_node_t) { .def = (def_ptr) }
+
+/** returns the field of a container node with the given name or NULL if there is no such field */
+ssz_node_t* ssz_node_get(ssz_node_t* node, const char* name);
+/** sets the serialized value of a field. Values shorter than a fixed field are padded with leading zeros like ssz_add_bytes does */
+void ssz_node_set_bytes(ssz_node_t* node, const char* name, bytes_t data);
+/** sets the value of a uint field with up to 8 bytes */
+void ssz_node_set_uint(ssz_node_t* node, const char* name, uint64_t value);
+/** allocates len elements of a list node and returns the first one */
+ssz_node_t* ssz_node_add_elements(ssz_node_t* list, uint32_t len);
+/** selects the type of a union node by name and returns the node of the value */
+ssz_node_t* ssz_node_select(ssz_node_t* node, const char* name);
+/** phase 1: calculates and stores the serialized size of the node and all its children */
+uint32_t ssz_node_size(ssz_node_t* node);
+/** phase 2: writes the node to out, which must hold at least the size calculated by ssz_node_size */
+void ssz_node_write(ssz_node_t* node, uint8_t* out);
+/** frees the children of the node, but not the referenced bytes */
+void ssz_node_free(ssz_node_t* node);
+/** serializes the node into a newly allocated buffer and frees the node. Make sure to free the returned bytes after using */
+ssz_ob_t ssz_node_to_bytes(ssz_node_t* node);
 #ifdef __cplusplus
 }
 #endif
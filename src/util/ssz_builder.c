@@ -28,14 +28,16 @@ void ssz_add_dynamic_list_bytes(ssz_builder_t* buffer, int num_elements, bytes_t
     buffer_append(&buffer->fixed, data);
 }
 void ssz_add_builders(ssz_builder_t* buffer, const char* name, ssz_builder_t data) {
-  ssz_ob_t element = ssz_builder_to_bytes(&data);
-  ssz_add_bytes(buffer, name, element.bytes);
-  free(element.bytes.data);
+  const ssz_def_t* def = find_def(buffer->def, name);
+  // the dynamic part directly follows the fixed part, so we can append both without joining them first.
+  ssz_add_bytes(buffer, name, data.fixed.data);
+  if (def) buffer_append(ssz_is_dynamic(def) ? &buffer->dynamic : &buffer->fixed, data.dynamic.data);
+  ssz_buffer_free(&data);
 }
 void ssz_add_dynamic_list_builders(ssz_builder_t* buffer, int num_elements, ssz_builder_t data) {
-  ssz_ob_t element = ssz_builder_to_bytes(&data);
-  ssz_add_dynamic_list_bytes(buffer, num_elements, element.bytes);
-  free(element.bytes.data);
+  ssz_add_dynamic_list_bytes(buffer, num_elements, data.fixed.data);
+  buffer_append(ssz_is_dynamic(buffer->def->def.vector.type) ? &buffer->dynamic : &buffer->fixed, data.dynamic.data);
+  ssz_buffer_free(&data);
 }
 
 void ssz_add_bytes(ssz_builder_t* buffer, const char* name, bytes_t data) {
@@ -45,10 +47,9 @@ void ssz_add_bytes(ssz_builder_t* buffer, const char* name, bytes_t data) {
   size_t    fixed_length = 0;
 
   if (ssz_is_dynamic(def)) {
-    size_t offset = 0;
-    for (int i = 0; i < buffer->def->def.container.len; i++)
-      offset += ssz_fixed_length(buffer->def->def.container.elements + i);
-    ssz_add_uint32(buffer, offset + buffer->dynamic.data.len);
+    ssz_layout_t* owned = NULL;
+    ssz_add_uint32(buffer, ssz_layout_of(buffer->def, &owned)->fixed_length + buffer->dynamic.data.len);
+    free(owned);
     bytes = &(buffer->dynamic);
   }
   else
@@ -114,6 +115,131 @@ ssz_ob_t ssz_builder_to_bytes(ssz_builder_t* buffer) {
   return (ssz_ob_t) {.def = buffer->def, .bytes = buffer->fixed.data};
 }
 
+// allocates the children of a node, each with the given definition or the elements of a container.
+static ssz_node_t* node_alloc_children(ssz_node_t* node, uint32_t len, const ssz_def_t* defs, bool same_def) {
+  ssz_node_free(node);
+  node->len      = len;
+  node->children = len ? calloc(len, sizeof(ssz_node_t)) : NULL;
+  for (uint32_t i = 0; i < len; i++) node->children[i].def = same_def ? defs : defs + i;
+  return node->children;
+}
+
+ssz_node_t* ssz_node_get(ssz_node_t* node, const char* name) {
+  if (!node || node->def->type != SSZ_TYPE_CONTAINER) return NULL;
+  if (!node->children) node_alloc_children(node, node->def->def.container.len, node->def->def.container.elements, false);
+  for (uint32_t i = 0; i < node->len; i++) {
+    if (strcmp(node->children[i].def->name, name) == 0) return node->children + i;
+  }
+  return NULL;
+}
+
+void ssz_node_set_bytes(ssz_node_t* node, const char* name, bytes_t data) {
+  ssz_node_t* field = ssz_node_get(node, name);
+  if (field) field->bytes = data;
+}
+
+void ssz_node_set_uint(ssz_node_t* node, const char* name, uint64_t value) {
+  ssz_node_t* field = ssz_node_get(node, name);
+  if (field) field->uint = value;
+}
+
+ssz_node_t* ssz_node_add_elements(ssz_node_t* list, uint32_t len) {
+  if (!list || (list->def->type != SSZ_TYPE_LIST && list->def->type != SSZ_TYPE_VECTOR)) return NULL;
+  return node_alloc_children(list, len, list->def->def.vector.type, true);
+}
+
+ssz_node_t* ssz_node_select(ssz_node_t* node, const char* name) {
+  const ssz_def_t* def = NULL;
+  if (!node || node->def->type != SSZ_TYPE_UNION) return NULL;
+  node->uint = ssz_union_selector(node->def->def.container.elements, node->def->def.container.len, name, &def);
+  return def ? node_alloc_children(node, 1, def, true) : NULL;
+}
+
+uint32_t ssz_node_size(ssz_node_t* node) {
+  const ssz_def_t* def = node->def;
+  if (!node->children && def->type == SSZ_TYPE_UNION)
+    node->size = node->bytes.len ? node->bytes.len : 1; // an empty union is serialized as NONE
+  else if (!node->children)
+    node->size = ssz_is_dynamic(def) ? node->bytes.len : (uint32_t) ssz_fixed_length(def);
+  else if (def->type == SSZ_TYPE_UNION)
+    node->size = 1 + ssz_node_size(node->children);
+  else if (def->type == SSZ_TYPE_CONTAINER) {
+    ssz_layout_t* owned = NULL;
+    node->size          = ssz_layout_of(def, &owned)->fixed_length;
+    free(owned);
+    for (uint32_t i = 0; i < node->len; i++) {
+      uint32_t size = ssz_node_size(node->children + i);
+      if (ssz_is_dynamic(node->children[i].def)) node->size += size;
+    }
+  }
+  else {
+    node->size = ssz_is_dynamic(def->def.vector.type) ? 4 * node->len : 0;
+    for (uint32_t i = 0; i < node->len; i++) node->size += ssz_node_size(node->children + i);
+  }
+  return node->size;
+}
+
+void ssz_node_write(ssz_node_t* node, uint8_t* out) {
+  const ssz_def_t* def = node->def;
+  if (!node->children) {
+    if (!node->bytes.data && def->type == SSZ_TYPE_UINT && def->def.uint.len <= 8) {
+      for (uint32_t i = 0; i < def->def.uint.len; i++) out[i] = (node->uint >> (i * 8)) & 0xFF;
+      return;
+    }
+    // like ssz_add_bytes, shorter values are padded with leading zeros
+    uint32_t len = node->bytes.data ? (node->bytes.len < node->size ? node->bytes.len : node->size) : 0;
+    memset(out, 0, node->size - len);
+    if (len) memcpy(out + node->size - len, node->bytes.data, len);
+  }
+  else if (def->type == SSZ_TYPE_UNION) {
+    out[0] = (uint8_t) node->uint;
+    ssz_node_write(node->children, out + 1);
+  }
+  else if (def->type == SSZ_TYPE_CONTAINER) {
+    ssz_layout_t*       owned  = NULL;
+    const ssz_layout_t* layout = ssz_layout_of(def, &owned);
+    uint32_t            pos    = layout->fixed_length;
+    for (uint32_t i = 0; i < node->len; i++) {
+      ssz_node_t* child = node->children + i;
+      if (!layout->fields[i].dynamic)
+        ssz_node_write(child, out + layout->fields[i].offset);
+      else {
+        uint32_to_le(out + layout->fields[i].offset, pos);
+        ssz_node_write(child, out + pos);
+        pos += child->size;
+      }
+    }
+    free(owned);
+  }
+  else if (ssz_is_dynamic(def->def.vector.type)) {
+    uint32_t pos = 4 * node->len;
+    for (uint32_t i = 0; i < node->len; i++) {
+      uint32_to_le(out + i * 4, pos);
+      ssz_node_write(node->children + i, out + pos);
+      pos += node->children[i].size;
+    }
+  }
+  else {
+    for (uint32_t i = 0; i < node->len; out += node->children[i].size, i++)
+      ssz_node_write(node->children + i, out);
+  }
+}
+
+void ssz_node_free(ssz_node_t* node) {
+  for (uint32_t i = 0; i < node->len; i++) ssz_node_free(node->children + i);
+  free(node->children);
+  node->children = NULL;
+  node->len      = 0;
+}
+
+ssz_ob_t ssz_node_to_bytes(ssz_node_t* node) {
+  uint32_t size = ssz_node_size(node);
+  bytes_t  data = bytes(malloc(size ? size : 1), size);
+  ssz_node_write(node, data.data);
+  ssz_node_free(node);
+  return (ssz_ob_t) {.def = node->def, .bytes = data};
+}
+
 ssz_ob_t ssz_from_json(json_t json, const ssz_def_t* def) {
   ssz_builder_t buf = {0};
   buf.def           = def;
@@ -12,34 +12,41 @@
 #include <stdint.h>
 #include <string.h>
 
+#ifdef PRECOMPILE_ZERO_HASHES
+#include "zero_hashes.h"
+#endif
+
 #define BYTES_PER_CHUNK 32
 
+typedef struct gindex_list gindex_list_t;
+
 typedef struct {
-  buffer_t* witnesses;
-  buffer_t* proof;
+  gindex_list_t* witnesses;
+  buffer_t*      proof;
 } merkle_proot_ctx_t;
 
 typedef struct {
   ssz_ob_t            ob;
   int                 max_depth;
-  int                 num_used_leafes;
-  int                 num_leafes;
+  uint64_t            num_used_leafes;
   gindex_t            root_gindex;
   gindex_t            last_gindex;
   merkle_proot_ctx_t* proof;
 } merkle_ctx_t;
 
-static inline uint32_t log2_ceil(uint32_t val) {
-  if (val < 2) return 0;
-
-  // Use MSVC intrinsic for counting leading zeros
-  unsigned long index;
+static inline int log2_floor64(uint64_t val) {
 #if defined(_MSC_VER)
-  _BitScanReverse(&index, val);
-  uint32_t floor_log2 = index;
+  unsigned long index;
+  _BitScanReverse64(&index, val);
+  return (int) index;
 #else
-  uint32_t floor_log2 = 31 - __builtin_clz(val);
+  return 63 - __builtin_clzll(val);
 #endif
+}
+
+static inline uint32_t log2_ceil(uint64_t val) {
+  if (val < 2) return 0;
+  uint32_t floor_log2 = (uint32_t) log2_floor64(val);
   return (val & (val - 1)) == 0 ? floor_log2 : floor_log2 + 1;
 }
 
@@ -72,7 +79,7 @@ gindex_t ssz_gindex(const ssz_def_t* def, int num_elements, ...) {
       }
     }
     else if (def->type == SSZ_TYPE_LIST) {
-      leafes = is_basic_type(def->def.vector.type) ? ((def->def.vector.len * ssz_fixed_length(def->def.vector.type) + 31) >> 5) * 2 : def->def.vector.len * 2;
+      leafes = is_basic_type(def->def.vector.type) ? (((uint64_t) def->def.vector.len * ssz_fixed_length(def->def.vector.type) + 31) >> 5) * 2 : (uint64_t) def->def.vector.len * 2;
       idx    = (uint64_t) va_arg(args, int);
     }
 
@@ -89,164 +96,166 @@ gindex_t ssz_gindex(const ssz_def_t* def, int num_elements, ...) {
   return gindex;
 }
 
-static int gindex_indexOf(buffer_t* index_list, gindex_t index) {
-  int       len              = index_list->data.len / sizeof(gindex_t);
-  gindex_t* index_list_array = (gindex_t*) index_list->data.data;
-  for (int i = 0; i < len; i++) {
-    if (index_list_array[i] == index) return i;
-  }
-  return -1;
+// a list of gindexes sorted descending, which is the order of the witnesses within a proof
+struct gindex_list {
+  gindex_t* data;
+  uint32_t  len;
+};
+
+static int cmp_gindex_desc(const void* a, const void* b) {
+  gindex_t ga = *(const gindex_t*) a, gb = *(const gindex_t*) b;
+  return ga < gb ? 1 : (ga > gb ? -1 : 0);
 }
 
-static void gindex_add(buffer_t* index_list, gindex_t index) {
-  int       len              = index_list->data.len / sizeof(gindex_t);
-  gindex_t* index_list_array = (gindex_t*) index_list->data.data;
-  for (int i = 0; i < len; i++) {
-    if (index_list_array[i] < index) {
-      buffer_splice(index_list, i * sizeof(gindex_t), 0, bytes((uint8_t*) &index, sizeof(gindex_t)));
-      return;
-    }
-    if (index_list_array[i] == index) return;
+// sorts the gindexes descending and removes duplicates. returns the new length.
+static uint32_t gindex_sort(gindex_t* list, uint32_t len) {
+  if (len < 2) return len;
+  qsort(list, len, sizeof(gindex_t), cmp_gindex_desc);
+  uint32_t n = 1;
+  for (uint32_t i = 1; i < len; i++) {
+    if (list[i] != list[n - 1]) list[n++] = list[i];
   }
-
-  buffer_append(index_list, bytes((uint8_t*) &index, sizeof(gindex_t)));
+  return n;
 }
 
-static void gindex_del(buffer_t* index_list, gindex_t index) {
-  int       len              = index_list->data.len / sizeof(gindex_t);
-  gindex_t* index_list_array = (gindex_t*) index_list->data.data;
-  for (int i = 0; i < len; i++) {
-    if (index_list_array[i] == index) {
-      buffer_splice(index_list, i * sizeof(gindex_t), sizeof(gindex_t), NULL_BYTES);
-      return;
-    }
+static int gindex_indexOf(const gindex_list_t* list, gindex_t gindex) {
+  uint32_t lo = 0, hi = list->len;
+  while (lo < hi) {
+    uint32_t mid = (lo + hi) >> 1;
+    if (list->data[mid] == gindex) return (int) mid;
+    if (list->data[mid] > gindex)
+      lo = mid + 1;
+    else
+      hi = mid;
   }
+  return -1;
 }
 
-static void ssz_add_multi_merkle_proof(gindex_t gindex, buffer_t* witnesses, buffer_t* calculated) {
-  if (gindex == 1) return;
-  while (gindex > 1) {
-    gindex_del(witnesses, gindex);
-    gindex_add(calculated, gindex);
-    gindex_t witness = (gindex & 1) ? gindex - 1 : gindex + 1;
-    if (gindex_indexOf(calculated, witness) != -1 || gindex_indexOf(witnesses, witness) != -1) break;
-    gindex_add(witnesses, witness);
-    gindex = gindex >> 1;
+// calculates the witnesses needed to prove the leafes. Those are the siblings of all nodes on the paths
+// from the leafes to the root, which are not on one of these paths themselves.
+static gindex_list_t gindex_witnesses(const gindex_t* leafes, uint32_t len) {
+  gindex_list_t paths     = {0};
+  gindex_list_t witnesses = {0};
+  uint32_t      total     = 0;
+  for (uint32_t i = 0; i < len; i++) total += leafes[i] > 1 ? log2_floor64(leafes[i]) : 0;
+  if (!total) return witnesses;
+
+  paths.data = malloc(total * sizeof(gindex_t));
+  for (uint32_t i = 0; i < len; i++) {
+    for (gindex_t gindex = leafes[i]; gindex > 1; gindex >>= 1) paths.data[paths.len++] = gindex;
   }
+  paths.len = gindex_sort(paths.data, paths.len);
+
+  witnesses.data = malloc(paths.len * sizeof(gindex_t));
+  for (uint32_t i = 0; i < paths.len; i++) {
+    gindex_t sibling = paths.data[i] ^ 1;
+    if (gindex_indexOf(&paths, sibling) < 0) witnesses.data[witnesses.len++] = sibling;
+  }
+  witnesses.len = gindex_sort(witnesses.data, witnesses.len);
+
+  free(paths.data);
+  return witnesses;
 }
 
 // gets the value of a field from a container
-static ssz_ob_t ssz_get_field(ssz_ob_t* ob, int index) {
+ssz_ob_t ssz_get_field(ssz_ob_t* ob, int index) {
   ssz_ob_t res = {0};
   // check if the object is valid
   if (!ob || !ob->def || ob->def->type != SSZ_TYPE_CONTAINER || !ob->bytes.data || !ob->bytes.len || index < 0 || index >= ob->def->def.container.len)
     return res;
 
-  // iterate over the fields of the container
-  size_t           pos = 0;
-  const ssz_def_t* def = NULL;
-  for (int i = 0; i < ob->def->def.container.len; i++) {
-    def        = ob->def->def.container.elements + i;
-    size_t len = ssz_fixed_length(def);
-
-    if (pos + len > ob->bytes.len) return res;
-
-    if (i == index) {
-      res.def = def;
-      if (ssz_is_dynamic(def)) {
-        uint32_t offset = uint32_from_le(ob->bytes.data + pos);
-        if (offset > ob->bytes.len) return res;
-        res.bytes.data = ob->bytes.data + offset;
-        res.bytes.len  = ob->bytes.len - offset;
-        pos += len;
-
-        // find next offset
-        for (int n = i + 1; n < ob->def->def.container.len; n++) {
-          if (ssz_is_dynamic(ob->def->def.container.elements + n)) {
-            if (pos + 4 > ob->bytes.len) return (ssz_ob_t) {0};
-
-            offset = uint32_from_le(ob->bytes.data + pos);
-            if (offset < ob->bytes.len)
-              res.bytes.len = ob->bytes.data + offset - res.bytes.data;
-            break;
-          }
-          pos += ssz_fixed_length(ob->def->def.container.elements + n);
-        }
-      }
-      else {
-        res.bytes.len  = len;
-        res.bytes.data = ob->bytes.data + pos;
-      }
-      if (def->type == SSZ_TYPE_UNION) {
-        if (res.bytes.len && def->def.container.len > res.bytes.data[0]) {
-          res.def = def->def.container.elements + res.bytes.data[0];
-          res.bytes.len--;
-          res.bytes.data++;
-        }
-        else
-          return (ssz_ob_t) {0};
-      }
-
-      return res;
+  ssz_layout_t*            owned = NULL;
+  const ssz_field_layout_t field = ssz_layout_of(ob->def, &owned)->fields[index];
+  const ssz_def_t*         def   = ob->def->def.container.elements + index;
+  free(owned);
+  if (field.offset + field.length > ob->bytes.len) return res;
+
+  res.def = def;
+  if (field.dynamic) {
+    uint32_t offset = uint32_from_le(ob->bytes.data + field.offset);
+    if (offset > ob->bytes.len) return res;
+    res.bytes.data = ob->bytes.data + offset;
+    res.bytes.len  = ob->bytes.len - offset;
+
+    // the end is defined by the offset of the next dynamic field
+    if (field.next_offset) {
+      if (field.next_offset + 4 > ob->bytes.len) return (ssz_ob_t) {0};
+      offset = uint32_from_le(ob->bytes.data + field.next_offset);
+      if (offset < ob->bytes.len)
+        res.bytes.len = ob->bytes.data + offset - res.bytes.data;
     }
-    pos += len;
   }
+  else {
+    res.bytes.len  = field.length;
+    res.bytes.data = ob->bytes.data + field.offset;
+  }
+  if (def->type == SSZ_TYPE_UNION) {
+    if (res.bytes.len && def->def.container.len > res.bytes.data[0]) {
+      res.def = def->def.container.elements + res.bytes.data[0];
+      res.bytes.len--;
+      res.bytes.data++;
+    }
+    else
+      return (ssz_ob_t) {0};
+  }
+
   return res;
 }
 
 ssz_ob_t ssz_get(ssz_ob_t* ob, const char* name) {
   if (ob->def->type != SSZ_TYPE_CONTAINER) return (ssz_ob_t) {0};
-  for (int i = 0; i < ob->def->def.container.len; i++) {
-    if (strcmp(ob->def->def.container.elements[i].name, name) == 0) return ssz_get_field(ob, i);
+  ssz_layout_t*       owned  = NULL;
+  const ssz_layout_t* layout = ssz_layout_of(ob->def, &owned);
+  uint32_t            hash   = ssz_name_hash(name);
+  int                 index  = -1;
+  for (int i = 0; i < layout->len && index < 0; i++) {
+    if (layout->fields[i].name_hash == hash && strcmp(ob->def->def.container.elements[i].name, name) == 0) index = i;
   }
-  return (ssz_ob_t) {0};
+  free(owned);
+  return index < 0 ? (ssz_ob_t) {0} : ssz_get_field(ob, index);
 }
 
+// turns the zero hash of the level below into the zero hash of the given height (0 = leafes)
+static inline void next_zero_hash(uint8_t* zero, int height) {
 #ifdef PRECOMPILE_ZERO_HASHES
-#define MAX_DEPTH 30
-static int     inited_zero_hashed = 0;
-static uint8_t ZERO_HASHES[MAX_DEPTH][32];
-static void    cached_zero_hash(int depth, uint8_t* out) {
-  if (depth < 0) {
-    memset(out, 0, 32);
-    return;
-  }
-  while (inited_zero_hashed < depth + 1) {
-    if (inited_zero_hashed == 0) {
-      bytes32_t zeros = {0};
-      sha256_merkle(bytes(zeros, 32), bytes(zeros, 32), ZERO_HASHES[inited_zero_hashed]);
-    }
-    else
-      sha256_merkle(bytes(ZERO_HASHES[inited_zero_hashed - 1], 32), bytes(ZERO_HASHES[inited_zero_hashed - 1], 32), ZERO_HASHES[inited_zero_hashed]);
-    inited_zero_hashed++;
-  }
-
-  memcpy(out, ZERO_HASHES[depth], 32);
+  // the table is constant, so it can be used by any thread without synchronization
+  memcpy(zero, ZERO_HASHES[height], 32);
+#else
+  sha256_merkle(bytes(zero, 32), bytes(zero, 32), zero);
+#endif
 }
 
+// writes the root of a tree with the given height, which has only zero leafes
+static void zero_hash(int height, uint8_t* out) {
+#ifdef PRECOMPILE_ZERO_HASHES
+  memcpy(out, ZERO_HASHES[height], 32);
+#else
+  memset(out, 0, 32);
+  for (int h = 1; h <= height; h++) next_zero_hash(out, h);
 #endif
+}
 
-static int calc_num_leafes(const ssz_ob_t* ob, bool only_used) {
+static uint64_t calc_num_leafes(const ssz_ob_t* ob, bool only_used) {
   const ssz_def_t* def = ob->def;
   switch (def->type) {
     case SSZ_TYPE_CONTAINER:
       return def->def.container.len;
     case SSZ_TYPE_VECTOR:
       if (is_basic_type(def->def.vector.type))
-        return (def->def.vector.len * ssz_fixed_length(def->def.vector.type) + 31) >> 5;
+        return ((uint64_t) def->def.vector.len * ssz_fixed_length(def->def.vector.type) + 31) >> 5;
       else
         return def->def.vector.len;
     case SSZ_TYPE_LIST: {
-      uint32_t len = only_used ? ssz_len(*ob) : def->def.vector.len;
+      uint64_t len = only_used ? ssz_len(*ob) : def->def.vector.len;
       if (is_basic_type(def->def.vector.type))
         return (len * ssz_fixed_length(def->def.vector.type) + 31) >> 5;
       else
         return len;
     }
     case SSZ_TYPE_BIT_LIST:
-      return (((only_used ? ssz_len(*ob) : def->def.vector.len) + 255) >> 8);
+      return (((uint64_t) (only_used ? ssz_len(*ob) : def->def.vector.len) + 255) >> 8);
     case SSZ_TYPE_BIT_VECTOR:
-      return (def->def.vector.len + 255) >> 8;
+      return ((uint64_t) def->def.vector.len + 255) >> 8;
     default:
       return 1;
   }
@@ -308,7 +317,7 @@ static void set_leaf(ssz_ob_t ob, int index, uint8_t* out, merkle_ctx_t* ctx) {
   }
 }
 
-static void merkle_hash(merkle_ctx_t* ctx, int index, int depth, uint8_t* out) {
+static void merkle_hash(merkle_ctx_t* ctx, uint64_t index, int depth, uint8_t* out) {
   uint8_t temp[64];
 
   // how many leafes do we have from depth?
@@ -317,26 +326,15 @@ static void merkle_hash(merkle_ctx_t* ctx, int index, int depth, uint8_t* out) {
 
   if (subtree_depth == 0) {
     if (ctx->proof) ctx->last_gindex = ssz_add_gindex(ctx->root_gindex, gindex); // global gindex
-    set_leaf(ctx->ob, index, out, ctx);
+    set_leaf(ctx->ob, (int) index, out, ctx);
   }
+  else if ((index << subtree_depth) >= ctx->num_used_leafes)
+    // the first leaf of the subtree is not used, so all leafes are zero
+    zero_hash(subtree_depth, out);
   else {
-
-#ifdef PRECOMPILE_ZERO_HASHES
-
-    int gindex_subtree_left_leaf = gindex << subtree_depth;                          // gindex of first leaf of the current subtree
-    int gindex_last_used_leaf    = (1 << ctx->max_depth) + ctx->num_used_leafes - 1; // gindex of last leaf of the used leafes
-    if (gindex_last_used_leaf < gindex_subtree_left_leaf && subtree_depth < MAX_DEPTH)
-      cached_zero_hash(subtree_depth - 1, out);
-    else {
-#endif
-
-      merkle_hash(ctx, index << 1, depth + 1, temp);
-      merkle_hash(ctx, (index << 1) + 1, depth + 1, temp + 32);
-
-      sha256(bytes(temp, 64), out);
-#ifdef PRECOMPILE_ZERO_HASHES
-    }
-#endif
+    merkle_hash(ctx, index << 1, depth + 1, temp);
+    merkle_hash(ctx, (index << 1) + 1, depth + 1, temp + 32);
+    sha256(bytes(temp, 64), out);
   }
 
   if (ctx->proof) {
@@ -346,18 +344,69 @@ static void merkle_hash(merkle_ctx_t* ctx, int index, int depth, uint8_t* out) {
                    gindex, index, depth, ctx->root_gindex, pos >= 0 ? "X" : " ", bytes(out, 32));
     //    fprintf(stderr, "gindex: %llu (i: %d  d:%d  r:%llu) %s", gindex, index, depth, ctx->root_gindex, pos >= 0 ? "X" : " ");
     //    print_hex(stderr, bytes(out, 32), " : ", "\n");
-    if (pos >= 0) {
-      buffer_grow(ctx->proof->proof, (ctx->proof->witnesses->data.len / sizeof(gindex_t)) * 32);
-      ctx->proof->proof->data.len = ctx->proof->witnesses->data.len / sizeof(gindex_t) * 32;
-      memcpy(ctx->proof->proof->data.data + pos * 32, out, 32);
+    if (pos >= 0) memcpy(ctx->proof->proof->data.data + pos * 32, out, 32);
+  }
+}
+
+// number of leafes a level may have before the level buffer is allocated on the heap
+#define MAX_INLINE_LEAFES 16
+
+// true if the chunks of the object are the serialized bytes themselves (packed basic types)
+static inline bool is_packed(const ssz_def_t* def) {
+  return def->type == SSZ_TYPE_BIT_VECTOR || ((def->type == SSZ_TYPE_VECTOR || def->type == SSZ_TYPE_LIST) && is_basic_type(def->def.vector.type));
+}
+
+// calculates the root breadth-first. All used leafes of a level are kept in one contiguous buffer
+// and reduced pairwise, padding with the zero hash of the level. Packed basic types are read directly
+// from the serialized bytes, so only the last incomplete pair needs to be copied.
+static void merkle_hash_levels(merkle_ctx_t* ctx, uint8_t* out) {
+  bytes32_t zero   = {0};
+  uint8_t   inline_level[(MAX_INLINE_LEAFES + 1) * 32];
+  uint8_t*  level  = inline_level;
+  uint32_t  count  = (uint32_t) ctx->num_used_leafes;
+  int       height = 0;
+
+  if (count == 0) {
+    // nothing used, so the root is the zero hash of the full depth
+    zero_hash(ctx->max_depth, out);
+    return;
+  }
+
+  if (is_packed(ctx->ob.def)) {
+    bytes_t  data  = ctx->ob.bytes;
+    uint32_t pairs = (count + 1) >> 1;
+    uint32_t full  = data.len / 64;
+    if (full > pairs) full = pairs;
+    if (pairs > MAX_INLINE_LEAFES) level = malloc((pairs + 1) * 32);
+    sha256_pairs(data.data, full, level);
+    if (full < pairs) {
+      uint8_t last[64] = {0};
+      memcpy(last, data.data + full * 64, data.len - full * 64);
+      sha256_pairs(last, 1, level + full * 32);
     }
+    count = pairs;
+    next_zero_hash(zero, ++height);
   }
+  else {
+    if (count > MAX_INLINE_LEAFES) level = malloc((count + 1) * 32);
+    for (uint32_t i = 0; i < count; i++)
+      set_leaf(ctx->ob, i, level + i * 32, NULL);
+  }
+
+  while (height < ctx->max_depth) {
+    if (count & 1) memcpy(level + (count++) * 32, zero, 32);
+    sha256_pairs(level, count >> 1, level); // reduces the level in place
+    count >>= 1;
+    next_zero_hash(zero, ++height);
+  }
+
+  memcpy(out, level, 32);
+  if (level != inline_level) free(level);
 }
 
 static inline void calc_leafes(merkle_ctx_t* ctx, ssz_ob_t ob) {
   ctx->max_depth       = log2_ceil(calc_num_leafes(&ob, false));
   ctx->num_used_leafes = calc_num_leafes(&ob, true);
-  ctx->num_leafes      = 1 << ctx->max_depth;
   ctx->ob              = ob;
 }
 
@@ -372,10 +421,12 @@ static void hash_tree_root(ssz_ob_t ob, uint8_t* out, merkle_ctx_t* parent) {
     ctx.root_gindex = ob.def->type == SSZ_TYPE_LIST ? parent->last_gindex * 2 : parent->last_gindex;
   }
 
-  if (ctx.num_leafes == 1)
+  if (ctx.max_depth == 0)
     set_leaf(ob, 0, out, NULL);
+  else if (ctx.proof)
+    merkle_hash(&ctx, 0, 0, out); // proofs need to visit each node with its gindex
   else
-    merkle_hash(&ctx, 0, 0, out);
+    merkle_hash_levels(&ctx, out);
 
   // mix_in_length s
   if (ob.def->type == SSZ_TYPE_LIST || ob.def->type == SSZ_TYPE_BIT_LIST) {
@@ -397,14 +448,12 @@ void ssz_hash_tree_root(ssz_ob_t ob, uint8_t* out) {
 
 bytes_t ssz_create_multi_proof_for_gindexes(ssz_ob_t root, bytes32_t root_hash, gindex_t* gindex, int gindex_len) {
 
-  buffer_t witnesses  = {0};
-  buffer_t calculated = {0};
-  buffer_t proof      = {0};
-
-  for (int i = 0; i < gindex_len; i++)
-    ssz_add_multi_merkle_proof(gindex[i], &witnesses, &calculated);
-
-  buffer_free(&calculated);
+  gindex_list_t witnesses = gindex_witnesses(gindex, (uint32_t) gindex_len);
+  buffer_t      proof     = {0};
+  if (witnesses.len) {
+    buffer_grow(&proof, witnesses.len * 32);
+    proof.data.len = witnesses.len * 32;
+  }
 
   merkle_proot_ctx_t proof_ctx = {
       .proof     = &proof,
@@ -418,7 +467,7 @@ bytes_t ssz_create_multi_proof_for_gindexes(ssz_ob_t root, bytes32_t root_hash,
 
   hash_tree_root(root, root_hash, &ctx);
 
-  buffer_free(&witnesses);
+  free(witnesses.data);
   return proof.data;
 }
 
@@ -440,108 +489,249 @@ bytes_t ssz_create_proof(ssz_ob_t root, bytes32_t root_hash, gindex_t gindex) {
   return ssz_create_multi_proof(root, root_hash, 1, gindex);
 }
 
-typedef struct {
-  bytes_t   witnesses_data;
-  gindex_t* witnesses_gindex;
-  uint32_t  witnesses_len;
-
-  bytes_t   leafes_data;
-  gindex_t* leafes_gindex;
-  uint32_t  leafes_len;
-} merkle_proof_data_t;
-
-static bytes_t merkle_get_data(merkle_proof_data_t* proof, gindex_t idx) {
-  for (uint32_t i = 0; i < proof->leafes_len; i++) {
-    if (proof->leafes_gindex[i] == idx)
-      return bytes_slice(proof->leafes_data, i * BYTES_PER_CHUNK, BYTES_PER_CHUNK);
-  }
-  for (uint32_t i = 0; i < proof->witnesses_len; i++) {
-    if (proof->witnesses_gindex[i] == idx)
-      return bytes_slice(proof->witnesses_data, i * BYTES_PER_CHUNK, BYTES_PER_CHUNK);
-  }
-  return NULL_BYTES;
-}
-
-static bool merkle_proof(merkle_proof_data_t* proof, gindex_t start, gindex_t end, bytes32_t out) {
-  bytes32_t tmp        = {0};
-  bytes_t   start_data = merkle_get_data(proof, start);
-  if (start_data.len != 32) return false;
-  memcpy(out, start_data.data, 32);
-
-  while (start > end) {
-    log_debug_full("%l: %x", start, bytes(out, 32));
-
-    /*
-    fprintf(stderr, "s: %llu ", start);
-    print_hex(stderr, bytes(out, 32), " : ", "\n");
-    */
-    gindex_t witness      = start & 1 ? start - 1 : start + 1;
-    bytes_t  witness_data = merkle_get_data(proof, witness);
-    if (witness_data.data == NULL) {
-      // how do we find the start for calculating this witness?
-      for (int i = 0; i < proof->leafes_len && witness_data.data == NULL; i++) {
-        gindex_t path = proof->leafes_gindex[i];
-        for (; path > 1; path >>= 1) {
-          if (path == witness && merkle_proof(proof, proof->leafes_gindex[i], witness, tmp)) {
-            witness_data = bytes(tmp, 32);
-            break;
-          }
-        }
-      }
-      if (witness_data.data == NULL) return false;
+// hashed view: keeps all node hashes of a merkle tree, so proofs can be served without hashing again.
+
+struct ssz_hashed {
+  int            depth;    // depth of the merkle tree (without the length mix-in of lists)
+  uint32_t       used;     // number of used leafes
+  bool           is_list;  // if true, the root mixes in the length
+  bytes32_t      length;   // the length chunk of lists
+  bytes32_t      root;     // the hash_tree_root
+  uint8_t*       nodes;    // all levels starting with the leafes, each level holds only the used nodes
+  ssz_hashed_t** children; // the views of leafes which are composite types themselves, or NULL
+};
+
+// number of used nodes in the level at the given height (0 = leafes)
+static inline uint32_t hashed_level_len(const ssz_hashed_t* view, int height) {
+  return view->used ? ((view->used - 1) >> height) + 1 : 0;
+}
+
+static inline uint8_t* hashed_level(const ssz_hashed_t* view, int height) {
+  uint8_t* level = view->nodes;
+  for (int h = 0; h < height; h++) level += hashed_level_len(view, h) * 32;
+  return level;
+}
+
+// a leaf needs its own view, if a proof may point into it
+static bool hashed_needs_view(ssz_ob_t ob) {
+  if (!ob.def || is_basic_type(ob.def) || ob.def->type == SSZ_TYPE_UNION) return false;
+  return ob.def->type == SSZ_TYPE_LIST || ob.def->type == SSZ_TYPE_BIT_LIST || calc_num_leafes(&ob, false) > 1;
+}
+
+static ssz_ob_t hashed_child(ssz_ob_t ob, uint32_t index) {
+  if (ob.def->type == SSZ_TYPE_CONTAINER)
+    return ssz_get(&ob, (char*) ob.def->def.container.elements[index].name);
+  if ((ob.def->type == SSZ_TYPE_VECTOR || ob.def->type == SSZ_TYPE_LIST) && !is_basic_type(ob.def->def.vector.type))
+    return ssz_at(ob, index);
+  return (ssz_ob_t) {0};
+}
+
+ssz_hashed_t* ssz_hashed_create(ssz_ob_t ob) {
+  if (!ob.def) return NULL;
+  ssz_hashed_t* view = calloc(1, sizeof(ssz_hashed_t));
+  view->depth        = log2_ceil(calc_num_leafes(&ob, false));
+  view->used         = (uint32_t) calc_num_leafes(&ob, true);
+  view->is_list      = ob.def->type == SSZ_TYPE_LIST || ob.def->type == SSZ_TYPE_BIT_LIST;
+
+  uint32_t total = 0;
+  for (int h = 0; h <= view->depth; h++) total += hashed_level_len(view, h);
+  view->nodes = total ? malloc(total * 32) : NULL;
+
+  // leafes
+  bool packed = is_packed(ob.def);
+  for (uint32_t i = 0; i < view->used; i++) {
+    uint8_t* leaf = view->nodes + i * 32;
+    ssz_ob_t child;
+    if (packed) {
+      uint32_t len = ob.bytes.len - i * 32;
+      memset(leaf, 0, 32);
+      memcpy(leaf, ob.bytes.data + i * 32, len > 32 ? 32 : len);
+    }
+    else if (hashed_needs_view(child = hashed_child(ob, i))) {
+      if (!view->children) view->children = calloc(view->used, sizeof(ssz_hashed_t*));
+      view->children[i] = ssz_hashed_create(child);
+      memcpy(leaf, view->children[i]->root, 32);
     }
-    if (start & 1)
-      sha256_merkle(witness_data, bytes(out, 32), out);
     else
-      sha256_merkle(bytes(out, 32), witness_data, out);
-    start >>= 1;
+      set_leaf(ob, i, leaf, NULL);
+  }
+
+  // all levels above
+  bytes32_t zero  = {0};
+  uint8_t*  level = view->nodes;
+  for (int h = 0; h < view->depth && view->used; h++) {
+    uint32_t len  = hashed_level_len(view, h);
+    uint8_t* next = level + len * 32;
+    sha256_pairs(level, len >> 1, next);
+    if (len & 1) {
+      uint8_t last[64];
+      memcpy(last, level + (len - 1) * 32, 32);
+      memcpy(last + 32, zero, 32);
+      sha256_pairs(last, 1, next + (len >> 1) * 32);
+    }
+    next_zero_hash(zero, h + 1);
+    level = next;
+  }
+
+  if (view->used)
+    memcpy(view->root, level, 32);
+  else
+    zero_hash(view->depth, view->root);
+
+  if (view->is_list) {
+    uint64_to_le(view->length, (uint64_t) ssz_len(ob));
+    sha256_merkle(bytes(view->root, 32), bytes(view->length, 32), view->root);
+  }
+  return view;
+}
+
+void ssz_hashed_root(const ssz_hashed_t* view, bytes32_t out) {
+  memcpy(out, view->root, 32);
+}
+
+bool ssz_hashed_get(const ssz_hashed_t* view, gindex_t gindex, bytes32_t out) {
+  while (view && gindex) {
+    if (gindex == 1) {
+      memcpy(out, view->root, 32);
+      return true;
+    }
+    int depth = log2_floor64(gindex);
+
+    if (view->is_list) {
+      // the data tree is the left child of the root, the length the right one
+      if (gindex == 3) {
+        memcpy(out, view->length, 32);
+        return true;
+      }
+      if ((gindex >> (depth - 1)) != 2) return false;
+      gindex ^= ((gindex_t) 1) << depth;
+      gindex |= ((gindex_t) 1) << --depth;
+    }
+
+    if (depth <= view->depth) {
+      int      height = view->depth - depth;
+      uint32_t index  = (uint32_t) (gindex - (((gindex_t) 1) << depth));
+      if (index < hashed_level_len(view, height))
+        memcpy(out, hashed_level(view, height) + index * 32, 32);
+      else
+        zero_hash(height, out);
+      return true;
+    }
+
+    // the gindex points into the subtree of a leaf
+    int      sub_depth = depth - view->depth;
+    uint32_t leaf      = (uint32_t) ((gindex >> sub_depth) - (((gindex_t) 1) << view->depth));
+    if (!view->children || leaf >= view->used) return false;
+    gindex = (gindex & ((((gindex_t) 1) << sub_depth) - 1)) | (((gindex_t) 1) << sub_depth);
+    view   = view->children[leaf];
   }
+  return false;
+}
+
+bytes_t ssz_hashed_multi_proof(const ssz_hashed_t* view, gindex_t* gindex, int gindex_len) {
+  gindex_list_t witnesses = gindex_witnesses(gindex, (uint32_t) gindex_len);
+  buffer_t      proof     = {0};
+  if (witnesses.len) {
+    buffer_grow(&proof, witnesses.len * 32);
+    proof.data.len = witnesses.len * 32;
+  }
+  for (uint32_t i = 0; i < witnesses.len; i++) {
+    if (!ssz_hashed_get(view, witnesses.data[i], proof.data.data + i * 32)) {
+      log_error("gindex %l is not part of the hashed view", witnesses.data[i]);
+      buffer_free(&proof);
+      break;
+    }
+  }
+
+  free(witnesses.data);
+  return proof.data;
+}
+
+void ssz_hashed_free(ssz_hashed_t* view) {
+  if (!view) return;
+  if (view->children) {
+    for (uint32_t i = 0; i < view->used; i++) ssz_hashed_free(view->children[i]);
+    free(view->children);
+  }
+  free(view->nodes);
+  free(view);
+}
+
+// open addressing map of all known nodes while verifying a multi proof
+typedef struct {
+  gindex_t* keys;   // 0 marks an empty slot
+  uint8_t** values; // points to the 32 bytes of the node
+  uint32_t  mask;
+} node_map_t;
+
+static inline uint32_t node_map_slot(const node_map_t* map, gindex_t gindex) {
+  uint32_t slot = (uint32_t) ((gindex * 0x9E3779B97F4A7C15ULL) >> 32) & map->mask;
+  while (map->keys[slot] && map->keys[slot] != gindex) slot = (slot + 1) & map->mask;
+  return slot;
+}
+
+static inline uint8_t* node_map_get(const node_map_t* map, gindex_t gindex) {
+  uint32_t slot = node_map_slot(map, gindex);
+  return map->keys[slot] ? map->values[slot] : NULL;
+}
+
+// adds the node, unless it is already known. returns true if it was added
+static inline bool node_map_add(node_map_t* map, gindex_t gindex, uint8_t* value) {
+  uint32_t slot = node_map_slot(map, gindex);
+  if (map->keys[slot]) return false;
+  map->keys[slot]   = gindex;
+  map->values[slot] = value;
   return true;
 }
 
 bool ssz_verify_multi_merkle_proof(bytes_t proof_data, bytes_t leafes, gindex_t* gindex, bytes32_t out) {
-  buffer_t witnesses_gindex  = {0};
-  buffer_t calculated_gindex = {0};
-  for (uint32_t i = 0; i < leafes.len / 32; i++)
-    ssz_add_multi_merkle_proof(gindex[i], &witnesses_gindex, &calculated_gindex);
-  /*
-  fprintf(stderr, "_______\nwitnesses_gindex:\n");
-  for (uint32_t i = 0; i < witnesses_gindex.data.len / sizeof(gindex_t); i++) {
-    fprintf(stderr, "witness gindex: %llu\n", ((gindex_t*) witnesses_gindex.data.data)[i]);
-  }
-
-  fprintf(stderr, "_______\ncalculated_gindex:\n");
-  for (uint32_t i = 0; i < calculated_gindex.data.len / sizeof(gindex_t); i++) {
-    fprintf(stderr, "path gindex: %llu\n", ((gindex_t*) calculated_gindex.data.data)[i]);
-  }
-  fprintf(stderr, "_______\nvalues:\n");
-  */
-
-  buffer_free(&calculated_gindex);
-
-  merkle_proof_data_t data = {
-      .leafes_gindex    = gindex,
-      .leafes_data      = leafes,
-      .leafes_len       = leafes.len / 32,
-      .witnesses_data   = proof_data,
-      .witnesses_gindex = (gindex_t*) witnesses_gindex.data.data,
-      .witnesses_len    = witnesses_gindex.data.len / sizeof(gindex_t),
-  };
-
-  if (data.witnesses_len != proof_data.len / 32) {
-    buffer_free(&witnesses_gindex);
+  uint32_t      leafes_len = leafes.len / 32;
+  gindex_list_t witnesses  = gindex_witnesses(gindex, leafes_len);
+  if (witnesses.len != proof_data.len / 32) {
+    free(witnesses.data);
     return false;
   }
 
-  // find the highest gindex since we want to start with that.
-  gindex_t start = 0;
-  for (uint32_t i = 0; i < data.leafes_len; i++) {
-    if (data.leafes_gindex[i] > start) start = data.leafes_gindex[i];
+  // each calculated node needs two known ones, so there are never more calculated nodes than given ones.
+  uint32_t known    = leafes_len + witnesses.len;
+  uint32_t capacity = 16;
+  while (capacity < known * 4) capacity <<= 1;
+  node_map_t map       = {.keys = calloc(capacity, sizeof(gindex_t)), .values = malloc(capacity * sizeof(uint8_t*)), .mask = capacity - 1};
+  gindex_t*  queue     = malloc(known * 2 * sizeof(gindex_t));
+  uint8_t*   nodes     = malloc(known * 32);
+  uint32_t   queue_len = 0;
+  uint32_t   nodes_len = 0;
+
+  for (uint32_t i = 0; i < leafes_len; i++) {
+    if (gindex[i] && node_map_add(&map, gindex[i], leafes.data + i * 32)) queue[queue_len++] = gindex[i];
   }
+  for (uint32_t i = 0; i < witnesses.len; i++) {
+    if (node_map_add(&map, witnesses.data[i], proof_data.data + i * 32)) queue[queue_len++] = witnesses.data[i];
+  }
+
+  // one pass bottom up: children always have a higher gindex than their parents
+  qsort(queue, queue_len, sizeof(gindex_t), cmp_gindex_desc);
+  for (uint32_t pos = 0; pos < queue_len; pos++) {
+    gindex_t parent = queue[pos] >> 1;
+    if (parent == 0 || node_map_get(&map, parent)) continue;
+    uint8_t* left  = node_map_get(&map, parent << 1);
+    uint8_t* right = node_map_get(&map, (parent << 1) | 1);
+    if (!left || !right) continue;
+    uint8_t* node = nodes + (nodes_len++) * 32;
+    sha256_merkle(bytes(left, 32), bytes(right, 32), node);
+    node_map_add(&map, parent, node);
+    queue[queue_len++] = parent;
+  }
+
+  uint8_t* root = node_map_get(&map, 1);
+  if (root) memcpy(out, root, 32);
 
-  bool result = merkle_proof(&data, start, 1, out);
-  buffer_free(&witnesses_gindex);
-  return result;
+  free(map.keys);
+  free(map.values);
+  free(queue);
+  free(nodes);
+  free(witnesses.data);
+  return root != NULL;
 }
 
 void ssz_verify_single_merkle_proof(bytes_t proof_data, bytes32_t leaf, gindex_t gindex, bytes32_t out) {
@@ -549,10 +739,11 @@ void ssz_verify_single_merkle_proof(bytes_t proof_data, bytes32_t leaf, gindex_t
 }
 
 gindex_t ssz_add_gindex(gindex_t gindex1, gindex_t gindex2) {
-  uint32_t depth = log2_ceil((uint32_t) gindex2 + 1) - 1;
-  if (depth > 63) {
-    log_error("gindex depth is too large: %u", depth);
+  if (!gindex1 || !gindex2) return 0;
+  int depth = log2_floor64(gindex2);
+  if (log2_floor64(gindex1) + depth > 63) {
+    log_error("gindex depth is too large: %d", log2_floor64(gindex1) + depth);
     return 0;
   }
-  return (gindex1 << depth) | (gindex2 & ((1 << depth) - 1));
+  return (gindex1 << depth) | (gindex2 & ((((gindex_t) 1) << depth) - 1));
 }
@@ -9,6 +9,11 @@ void c4_state_free(c4_state_t* state) {
     if (data_request->error) free(data_request->error);
     if (data_request->payload.data) free(data_request->payload.data);
     if (data_request->response.data) free(data_request->response.data);
+    json_index_free(data_request->json_index);
+    if (data_request->stream) {
+      json_stream_free(&data_request->stream->json);
+      data_request->stream->free(data_request->stream);
+    }
     free(data_request);
     data_request = next;
   }
@@ -57,6 +62,53 @@ data_request_t* c4_state_get_pending_request(c4_state_t* state) {
   return NULL;
 }
 
+static void stream_free(data_stream_t* stream) {
+  free(stream);
+}
+
+void c4_req_append_response(data_request_t* req, bytes_t data) {
+  // requests without consumer just collect the text
+  if (!req->stream) {
+    req->stream       = calloc(1, sizeof(data_stream_t));
+    req->stream->free = stream_free;
+  }
+  json_stream_append(&req->stream->json, (const char*) data.data, data.len);
+}
+
+void c4_req_finish_response(data_request_t* req) {
+  if (!req->stream) {
+    req->response = bytes(calloc(1, 1), 0);
+    return;
+  }
+  buffer_t* text = &req->stream->json.text;
+  buffer_grow(text, text->data.len + 1);
+  text->data.data[text->data.len] = 0;
+  req->response                   = text->data;
+  req->stream->done               = true;
+  *text                           = (buffer_t) {0};
+  buffer_free(&req->stream->json.value);
+  req->stream->json.value = (buffer_t) {0};
+}
+
+void c4_req_reset_response(data_request_t* req) {
+  data_stream_t* stream = req->stream;
+  if (!stream) return;
+  json_stream_free(&stream->json);
+  stream->json = (json_stream_t) {.property = stream->json.property, .on_value = stream->json.on_value, .ctx = stream->json.ctx};
+  stream->done = false;
+  if (stream->reset) stream->reset(stream);
+}
+
+void c4_req_stream_response(data_request_t* req) {
+  data_stream_t* stream = req->stream;
+  if (!stream || stream->done || !req->response.data) return;
+  json_stream_append(&stream->json, (const char*) req->response.data, req->response.len);
+  json_index_free(req->json_index);
+  free(req->response.data);
+  req->json_index = NULL;
+  c4_req_finish_response(req);
+}
+
 #ifdef TEST
 char* c4_req_mockname(data_request_t* req) {
   buffer_t buf = {0};
@@ -66,9 +118,8 @@ char* c4_req_mockname(data_request_t* req) {
   else if (req->payload.data) {
     json_t t = json_parse((char*) req->payload.data);
     bprintf(&buf, "%j", json_get(t, "method"));
-    json_t params = json_get(t, "params");
-    for (int i = 0; i < json_len(params); i++)
-      bprintf(&buf, "_%j", json_at(params, i));
+    json_for_each_value(json_get(t, "params"), param)
+        bprintf(&buf, "_%j", param);
   }
 
   for (int i = 0; i < buf.data.len; i++) {
@@ -34,6 +34,14 @@ typedef enum {
   C4_PENDING = 2
 } c4_status_t;
 
+// receives the values of the result of a json response, while the response is still being received.
+typedef struct data_stream {
+  json_stream_t json;                        // splits the result into its values and passes them to the consumer
+  bool          done;                        // true, if the complete response has been passed to the stream
+  void (*reset)(struct data_stream* stream); // drops all values received so far, before the request is sent again
+  void (*free)(struct data_stream* stream);  // frees the consumer
+} data_stream_t;
+
 typedef struct data_request {
   chain_id_t              chain_id;
   data_request_type_t     type;
@@ -42,6 +50,9 @@ typedef struct data_request {
   data_request_method_t   method;
   bytes_t                 payload;
   bytes_t                 response;
+  bool                    validated;           // true if the response has already been validated, so it does not need to be checked again
+  json_index_t*           json_index;          // the structural index of a json response, created with the first access
+  data_stream_t*          stream;              // if set, the values of the result are passed to the stream and only the remaining text is kept as response
   uint16_t                response_node_index; // index of the node that responded with the result
   uint16_t                node_exclude_mask;   // the bitlist marking nodes, which should be excluded when retrying ( 1st bit = index 0) max 16)
   char*                   error;
@@ -61,6 +72,15 @@ bool            c4_state_is_pending(data_request_t* req);
 void            c4_state_add_request(c4_state_t* state, data_request_t* data_request);
 data_request_t* c4_state_get_pending_request(c4_state_t* state);
 
+// passes the next chunk of the response, which may be called by the host while it is still receiving it.
+void c4_req_append_response(data_request_t* req, bytes_t data);
+// sets the response from all chunks passed so far.
+void c4_req_finish_response(data_request_t* req);
+// drops all chunks passed so far, if the request failed and will be sent to another node.
+void c4_req_reset_response(data_request_t* req);
+// passes a complete response, which was set at once, to the stream of the request and only keeps the remaining text.
+void c4_req_stream_response(data_request_t* req);
+
 // executes the function and returns the state if it was not successful
 #define TRY_ASYNC(fn)                      \
   do {                                     \
@@ -109,20 +129,26 @@ data_request_t* c4_state_get_pending_request(c4_state_t* state);
     return C4_ERROR;                                      \
   } while (0)
 
-#define CHECK_JSON(val, def, error_prefix)                   \
-  do {                                                       \
-    const char* err = json_validate(val, def, error_prefix); \
-    if (err) {                                               \
-      ctx->state.error = (char*) err;                        \
-      return C4_ERROR;                                       \
-    }                                                        \
+// the def is compiled only once per call site, so it must be a constant string.
+#define CHECK_JSON(val, def, error_prefix)                                                                    \
+  do {                                                                                                        \
+    static json_schema_t* schema = NULL;                                                                      \
+    const char*           err    = json_schema_validate(json_schema_cached(&schema, def), val, error_prefix); \
+    if (err) {                                                                                                \
+      ctx->state.error = (char*) err;                                                                         \
+      return C4_ERROR;                                                                                        \
+    }                                                                                                         \
   } while (0)
 
 #define RETRY_REQUEST(req)                                     \
   do {                                                         \
     req->node_exclude_mask |= (1 << req->response_node_index); \
     free(req->response.data);                                  \
-    req->response = NULL_BYTES;                                \
+    json_index_free(req->json_index);                          \
+    c4_req_reset_response(req);                                \
+    req->response   = NULL_BYTES;                              \
+    req->json_index = NULL;                                    \
+    req->validated  = false;                                   \
     return C4_PENDING;                                         \
   } while (0)
 
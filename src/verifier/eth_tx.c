@@ -89,6 +89,9 @@ static const rlp_def_t tx_type3_defs[] = {
     {"s", 1},
 };
 
+// the maximum number of fields of all tx types
+#define MAX_TX_FIELDS 14
+
 static const rlp_type_defs_t tx_type_defs[] = {
     {tx_legacy_defs, sizeof(tx_legacy_defs) / sizeof(rlp_def_t)},
     {tx_1_defs, sizeof(tx_1_defs) / sizeof(rlp_def_t)},
@@ -111,33 +114,37 @@ static bool get_and_remove_tx_type(verify_ctx_t* ctx, bytes_t* raw_tx, tx_type_t
 }
 
 bool c4_tx_create_from_address(verify_ctx_t* ctx, bytes_t raw_tx, uint8_t* address) {
-  buffer_t  buf      = {0};
-  bytes32_t raw_hash = {0};
-  bytes_t   last_item;
-  tx_type_t type = 0;
+  buffer_t   buf      = {0};
+  bytes32_t  raw_hash = {0};
+  rlp_item_t items[MAX_TX_FIELDS];
+  bytes_t    last_item;
+  tx_type_t  type = 0;
   if (!get_and_remove_tx_type(ctx, &raw_tx, &type)) RETURN_VERIFY_ERROR(ctx, "invalid tx data, missing type!");
   if (rlp_decode(&raw_tx, 0, &raw_tx) != RLP_LIST) RETURN_VERIFY_ERROR(ctx, "invalid tx data!");
   rlp_type_defs_t defs = tx_type_defs[type];
-  rlp_decode(&raw_tx, defs.len - 4, &last_item);
-  buffer_append(&buf, bytes(raw_tx.data, last_item.data + last_item.len - raw_tx.data));
-  uint64_t v = 0;
+  if (rlp_decode_list(raw_tx, items, MAX_TX_FIELDS) != (int) defs.len) RETURN_VERIFY_ERROR(ctx, "invalid tx data, missing fields!");
+  last_item = items[defs.len - 4].data;
+  bytes_t  payload   = bytes(raw_tx.data, last_item.data + last_item.len - raw_tx.data);
+  uint8_t  extra[16] = {0};
+  buffer_t extra_buf = stack_buffer(extra);
+  uint64_t v         = 0;
   if (type == TX_TYPE_LEGACY) {
-    v = rlp_get_uint64(raw_tx, 6);
+    v = bytes_as_be(items[6].data);
     if (v > 28) {
-      rlp_add_uint64(&buf, (v - 36 + v % 2) / 2);
-      rlp_add_item(&buf, NULL_BYTES);
-      rlp_add_item(&buf, NULL_BYTES);
+      rlp_add_uint64(&extra_buf, (v - 36 + v % 2) / 2);
+      rlp_add_item(&extra_buf, NULL_BYTES);
+      rlp_add_item(&extra_buf, NULL_BYTES);
     }
   }
   else
-    v = rlp_get_uint64(raw_tx, defs.len - 3);
-
-  rlp_to_list(&buf);
-
-  if (type != TX_TYPE_LEGACY) {
-    buffer_splice(&buf, 0, 0, bytes(NULL, 1));
-    buf.data.data[0] = (uint8_t) type;
-  }
+    v = bytes_as_be(items[defs.len - 3].data);
+
+  // the signed data is the type and the list of all fields without the signature
+  buffer_grow(&buf, rlp_list_len(payload.len + extra_buf.data.len) + 1);
+  if (type != TX_TYPE_LEGACY) buffer_add_bytes(&buf, 1, (uint8_t) type);
+  rlp_add_list_header(&buf, payload.len + extra_buf.data.len);
+  buffer_append(&buf, payload);
+  buffer_append(&buf, extra_buf.data);
   keccak(buf.data, raw_hash);
   buffer_free(&buf);
 
@@ -145,10 +152,11 @@ bool c4_tx_create_from_address(verify_ctx_t* ctx, bytes_t raw_tx, uint8_t* addre
 
   uint8_t sig[65]    = {0};
   uint8_t pubkey[64] = {0};
-  rlp_decode(&raw_tx, defs.len - 2, &last_item);
-  memcpy(sig + 32 - last_item.len, last_item.data, last_item.len);
-  rlp_decode(&raw_tx, defs.len - 1, &last_item);
-  memcpy(sig + 64 - last_item.len, last_item.data, last_item.len);
+  bytes_t r          = items[defs.len - 2].data;
+  bytes_t s          = items[defs.len - 1].data;
+  if (r.len > 32 || s.len > 32) RETURN_VERIFY_ERROR(ctx, "invalid  signature!");
+  memcpy(sig + 32 - r.len, r.data, r.len);
+  memcpy(sig + 64 - s.len, s.data, s.len);
   sig[64] = (uint8_t) (v > 28 ? (v % 2 ? 27 : 28) : v);
 
   if (!secp256k1_recover(raw_hash, bytes(sig, 65), pubkey)) RETURN_VERIFY_ERROR(ctx, "invalid  signature!");
@@ -168,16 +176,17 @@ bool c4_tx_verify_tx_data(verify_ctx_t* ctx, ssz_ob_t tx_data, bytes_t serialize
 
   // check data
   rlp_type_defs_t defs = tx_type_defs[type];
+  rlp_item_t      items[MAX_TX_FIELDS];
   if (rlp_decode(&raw_tx, 0, &raw_tx) != RLP_LIST) RETURN_VERIFY_ERROR(ctx, "invalid tx data!");
-  int len = rlp_decode(&raw_tx, -1, &raw_tx);
+  int len = rlp_decode_list(raw_tx, items, MAX_TX_FIELDS);
   if (len != defs.len) RETURN_VERIFY_ERROR(ctx, "invalid tx data, missing fields!");
   bytes32_t tmp = {0};
 
   for (int i = 0; i < len; i++) {
     rlp_def_t  def       = defs.defs[i];
-    bytes_t    rlp_value = {0};
+    bytes_t    rlp_value = items[i].data;
     ssz_ob_t   ssz_value = ssz_get(&tx_data, def.name);
-    rlp_type_t rlp_type  = rlp_decode(&raw_tx, i, &rlp_value);
+    rlp_type_t rlp_type  = items[i].type;
     if (rlp_type != (def.len == 2 ? RLP_LIST : RLP_ITEM)) RETURN_VERIFY_ERROR(ctx, "invalid tx data, missing fields!");
     switch (def.len) {
       case 20:
@@ -230,19 +239,22 @@ bool c4_tx_verify_tx_hash(verify_ctx_t* ctx, bytes_t raw) {
   RETURN_VERIFY_ERROR(ctx, "invalid method for tx proof!");
 }
 
-static bool matches(ssz_ob_t log, bytes_t logs) {
-  bytes_t val = {0};
-  if (rlp_decode(&logs, 0, &val) != RLP_ITEM || !bytes_eq(val, ssz_get(&log, "address").bytes)) return false;
-  if (rlp_decode(&logs, 2, &val) != RLP_ITEM || !bytes_eq(val, ssz_get(&log, "data").bytes)) return false;
-
-  log = ssz_get(&log, "topics");
-  if (rlp_decode(&logs, 1, &logs) != RLP_LIST) return false;
-  if (ssz_len(log) != rlp_decode(&logs, -1, &logs)) return false;
-  for (uint32_t topic_index = 0; topic_index < ssz_len(log); topic_index++) {
-    if (rlp_decode(&logs, topic_index, &val) != RLP_ITEM || !bytes_eq(val, ssz_at(log, topic_index).bytes)) return false;
+// compares the topics of a log with the rlp list of topics.
+static bool topics_match(ssz_ob_t topics, bytes_t list) {
+  bytes_t  val = {0};
+  uint32_t len = ssz_len(topics);
+  for (uint32_t topic_index = 0; topic_index < len; topic_index++) {
+    if (rlp_next(&list, &val) != RLP_ITEM || !bytes_eq(val, ssz_at(topics, topic_index).bytes)) return false;
   }
+  return list.len == 0;
+}
 
-  return true;
+static bool matches(ssz_ob_t log, bytes_t log_rlp) {
+  rlp_item_t items[3];
+  if (rlp_decode_list(log_rlp, items, 3) != 3) return false;
+  if (items[0].type != RLP_ITEM || !bytes_eq(items[0].data, ssz_get(&log, "address").bytes)) return false;
+  if (items[2].type != RLP_ITEM || !bytes_eq(items[2].data, ssz_get(&log, "data").bytes)) return false;
+  return items[1].type == RLP_LIST && topics_match(ssz_get(&log, "topics"), items[1].data);
 }
 
 bool c4_tx_verify_log_data(verify_ctx_t* ctx, ssz_ob_t log, bytes32_t block_hash, uint64_t block_number, uint32_t tx_index, bytes_t tx_raw, bytes_t receipt_raw) {
@@ -257,11 +269,9 @@ bool c4_tx_verify_log_data(verify_ctx_t* ctx, ssz_ob_t log, bytes32_t block_hash
   if (tx_index != ssz_get_uint32(&log, "transactionIndex")) RETURN_VERIFY_ERROR(ctx, "invalid transaction index!");
   if (!get_and_remove_tx_type(ctx, &receipt_raw, &type)) RETURN_VERIFY_ERROR(ctx, "invalid tx data, invalid type!");
   if (rlp_decode(&receipt_raw, 0, &receipt_raw) != RLP_LIST || rlp_decode(&receipt_raw, 3, &logs) != RLP_LIST) RETURN_VERIFY_ERROR(ctx, "invalid to data!");
-  uint32_t logs_len = rlp_decode(&logs, -1, &logs);
 
-  for (uint32_t i = 0; i < logs_len; i++) {
-    bytes_t log_rlp = {0};
-    rlp_decode(&logs, i, &log_rlp);
+  bytes_t log_rlp = {0};
+  while (rlp_next(&logs, &log_rlp) == RLP_LIST) {
     if (matches(log, log_rlp)) return true;
   }
   RETURN_VERIFY_ERROR(ctx, "missing the log within the tx");
@@ -287,31 +297,31 @@ bool c4_tx_verify_receipt_data(verify_ctx_t* ctx, ssz_ob_t receipt_data, bytes32
     receipt_raw.len--;
   }
 
-  if (rlp_decode(&receipt_raw, 0, &tx_raw) != RLP_LIST) RETURN_VERIFY_ERROR(ctx, "invalid receipt data!");
-  if (rlp_decode(&tx_raw, 0, &val) != RLP_ITEM || bytes_as_be(val) != ssz_get_uint64(&receipt_data, "status")) RETURN_VERIFY_ERROR(ctx, "invalid receipt data!");
-  if (rlp_decode(&tx_raw, 1, &val) != RLP_ITEM || bytes_as_be(val) != ssz_get_uint64(&receipt_data, "cumulativeGasUsed")) RETURN_VERIFY_ERROR(ctx, "invalid receipt data!");
-  if (rlp_decode(&tx_raw, 2, &val) != RLP_ITEM || !bytes_eq(val, ssz_get(&receipt_data, "logsBloom").bytes)) RETURN_VERIFY_ERROR(ctx, "invalid receipt data!");
-  if (rlp_decode(&tx_raw, 3, &tx_raw) != RLP_LIST) RETURN_VERIFY_ERROR(ctx, "invalid receipt data!");
-
-  ssz_ob_t logs = ssz_get(&receipt_data, "logs");
-  if (ssz_len(logs) != rlp_decode(&tx_raw, -1, &tx_raw)) RETURN_VERIFY_ERROR(ctx, "invalid log len!");
-
-  for (uint32_t log_index = 0; log_index < ssz_len(logs); log_index++) {
-    ssz_ob_t log     = ssz_at(logs, log_index);
-    bytes_t  log_rlp = {0};
-    if (rlp_decode(&tx_raw, log_index, &log_rlp) != RLP_LIST) RETURN_VERIFY_ERROR(ctx, "invalid receipt data!");
-    if (rlp_decode(&log_rlp, 0, &val) != RLP_ITEM || !bytes_eq(val, ssz_get(&log, "address").bytes)) RETURN_VERIFY_ERROR(ctx, "invalid receipt data!");
-    if (rlp_decode(&log_rlp, 2, &val) != RLP_ITEM || !bytes_eq(val, ssz_get(&log, "data").bytes)) RETURN_VERIFY_ERROR(ctx, "invalid receipt data!");
+  rlp_item_t fields[4];
+  if (rlp_decode(&receipt_raw, 0, &tx_raw) != RLP_LIST || rlp_decode_list(tx_raw, fields, 4) != 4) RETURN_VERIFY_ERROR(ctx, "invalid receipt data!");
+  if (fields[0].type != RLP_ITEM || bytes_as_be(fields[0].data) != ssz_get_uint64(&receipt_data, "status")) RETURN_VERIFY_ERROR(ctx, "invalid receipt data!");
+  if (fields[1].type != RLP_ITEM || bytes_as_be(fields[1].data) != ssz_get_uint64(&receipt_data, "cumulativeGasUsed")) RETURN_VERIFY_ERROR(ctx, "invalid receipt data!");
+  if (fields[2].type != RLP_ITEM || !bytes_eq(fields[2].data, ssz_get(&receipt_data, "logsBloom").bytes)) RETURN_VERIFY_ERROR(ctx, "invalid receipt data!");
+  if (fields[3].type != RLP_LIST) RETURN_VERIFY_ERROR(ctx, "invalid receipt data!");
+
+  ssz_ob_t logs     = ssz_get(&receipt_data, "logs");
+  uint32_t logs_len = ssz_len(logs);
+  tx_raw            = fields[3].data;
+
+  for (uint32_t log_index = 0; log_index < logs_len; log_index++) {
+    ssz_ob_t   log     = ssz_at(logs, log_index);
+    bytes_t    log_rlp = {0};
+    rlp_item_t items[3];
+    if (rlp_next(&tx_raw, &log_rlp) != RLP_LIST) RETURN_VERIFY_ERROR(ctx, "invalid log len!");
+    if (rlp_decode_list(log_rlp, items, 3) != 3) RETURN_VERIFY_ERROR(ctx, "invalid receipt data!");
+    if (items[0].type != RLP_ITEM || !bytes_eq(items[0].data, ssz_get(&log, "address").bytes)) RETURN_VERIFY_ERROR(ctx, "invalid receipt data!");
+    if (items[2].type != RLP_ITEM || !bytes_eq(items[2].data, ssz_get(&log, "data").bytes)) RETURN_VERIFY_ERROR(ctx, "invalid receipt data!");
     if (block_number != ssz_get_uint64(&log, "blockNumber")) RETURN_VERIFY_ERROR(ctx, "invalid block number!");
     if (!bytes_eq(ssz_get(&log, "blockHash").bytes, bytes(block_hash, 32))) RETURN_VERIFY_ERROR(ctx, "invalid block hash!");
-
-    log = ssz_get(&log, "topics");
-    if (rlp_decode(&log_rlp, 1, &log_rlp) != RLP_LIST) RETURN_VERIFY_ERROR(ctx, "invalid topics!");
-    if (ssz_len(log) != rlp_decode(&log_rlp, -1, &log_rlp)) RETURN_VERIFY_ERROR(ctx, "invalid topic len!");
-    for (uint32_t topic_index = 0; topic_index < ssz_len(log); topic_index++) {
-      if (rlp_decode(&log_rlp, topic_index, &val) != RLP_ITEM || !bytes_eq(val, ssz_at(log, topic_index).bytes)) RETURN_VERIFY_ERROR(ctx, "invalid topic data!");
-    }
+    if (items[1].type != RLP_LIST) RETURN_VERIFY_ERROR(ctx, "invalid topics!");
+    if (!topics_match(ssz_get(&log, "topics"), items[1].data)) RETURN_VERIFY_ERROR(ctx, "invalid topic data!");
   }
+  if (tx_raw.len) RETURN_VERIFY_ERROR(ctx, "invalid log len!");
 
   return true;
 }
@@ -7,11 +7,6 @@ extern "C" {
 
 #include "verify.h"
 
-#define GINDEX_RECEIPT_ROOT 803
-#define GINDEX_BLOCKUMBER   806
-#define GINDEX_BLOCHASH     812
-#define GINDEX_TXINDEX_G    1704984576L // gindex of the first tx
-
 // tools for eth tx and receipt handling
 
 bool c4_tx_create_from_address(verify_ctx_t* ctx, bytes_t raw_tx, uint8_t* address); // using ecrecover
@@ -4,26 +4,25 @@
 #include "../util/ssz.h"
 #include "../util/version.h"
 #include "types_beacon.h"
+#include "types_fields.h"
 #include "types_verify.h"
 #include "verify.h"
 #include <inttypes.h>
 #include <string.h>
 
-#define NEXT_SYNC_COMMITTEE_GINDEX 55
-
 static bool update_light_client_update(verify_ctx_t* ctx, ssz_ob_t* update, bytes32_t trusted_blockhash) {
   bytes32_t sync_root      = {0};
   bytes32_t merkle_root    = {0};
   bytes32_t blockhash      = {0};
-  ssz_ob_t  attested       = ssz_get(update, "attestedHeader");
-  ssz_ob_t  header         = ssz_get(&attested, "beacon");
-  ssz_ob_t  sync_aggregate = ssz_get(update, "syncAggregate");
-  ssz_ob_t  signature      = ssz_get(&sync_aggregate, "syncCommitteeSignature");
-  ssz_ob_t  sync_bits      = ssz_get(&sync_aggregate, "syncCommitteeBits");
-  ssz_ob_t  merkle_proof   = ssz_get(update, "nextSyncCommitteeBranch");
-  ssz_ob_t  sync_committee = ssz_get(update, "nextSyncCommittee");
-  ssz_ob_t  state_root     = ssz_get(&header, "stateRoot");
-  uint64_t  slot           = ssz_get_uint64(&header, "slot");
+  ssz_ob_t  attested       = light_client_update_attested_header(update);
+  ssz_ob_t  header         = light_client_header_beacon(&attested);
+  ssz_ob_t  sync_aggregate = light_client_update_sync_aggregate(update);
+  ssz_ob_t  signature      = sync_aggregate_sync_committee_signature(&sync_aggregate);
+  ssz_ob_t  sync_bits      = sync_aggregate_sync_committee_bits(&sync_aggregate);
+  ssz_ob_t  merkle_proof   = light_client_update_next_sync_committee_branch(update);
+  ssz_ob_t  sync_committee = light_client_update_next_sync_committee(update);
+  ssz_ob_t  state_root     = beacon_block_header_state_root(&header);
+  uint64_t  slot           = ssz_uint64(beacon_block_header_slot(&header));
   if (ssz_is_error(header) || ssz_is_error(state_root) || ssz_is_error(signature) || ssz_is_error(sync_bits) || ssz_is_error(merkle_proof) || ssz_is_error(sync_committee))
     RETURN_VERIFY_ERROR(ctx, "invalid light client update!");
 
@@ -35,17 +34,23 @@ static bool update_light_client_update(verify_ctx_t* ctx, ssz_ob_t* update, byte
     if (!bytes_all_zero(bytes(trusted_blockhash, 32)) && memcmp(trusted_blockhash, blockhash, 32)) RETURN_VERIFY_ERROR(ctx, "invalid blockhash!");
   }
   else {
-    if (!c4_verify_blockroot_signature(ctx, &header, &sync_bits, &signature, slot)) RETURN_VERIFY_ERROR(ctx, "invalid signature in light client update!");
+    // the next sync committee is stored right away, so its signature is never deferred to a batch
+    c4_signature_batch_t* batch = ctx->batch;
+    ctx->batch                  = NULL;
+    bool valid                  = c4_verify_blockroot_signature(ctx, &header, &sync_bits, &signature, slot);
+    ctx->batch                  = batch;
+    if (!valid) RETURN_VERIFY_ERROR(ctx, "invalid signature in light client update!");
   }
 
   // create merkle root from proof
   ssz_hash_tree_root(sync_committee, sync_root);
-  ssz_verify_single_merkle_proof(merkle_proof.bytes, sync_root, NEXT_SYNC_COMMITTEE_GINDEX, merkle_root);
+  ssz_verify_single_merkle_proof(merkle_proof.bytes, sync_root, c4_chain_gindexes(ctx->chain_id, slot)->next_sync_committee, merkle_root);
 
   // verify the merkle root
   if (memcmp(merkle_root, state_root.bytes.data, 32)) RETURN_VERIFY_ERROR(ctx, "invalid merkle root in light client update!");
 
-  return c4_set_sync_period(slot, blockhash, ssz_get(&sync_committee, "pubkeys").bytes, ctx->chain_id);
+  // the pubkeys are stored together with their aggregate, which is part of the verified sync committee
+  return c4_set_sync_period(slot, blockhash, sync_committee.bytes, ctx->chain_id);
 }
 
 bool c4_update_from_sync_data(verify_ctx_t* ctx) {
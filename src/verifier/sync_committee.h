@@ -15,6 +15,7 @@ typedef struct {
   uint32_t current_period;
   bytes_t  validators;
   bool     deserialized;
+  uint8_t* aggregated_pubkey; // the aggregate of all 512 keys stored after them or NULL for states stored without it
 } c4_sync_state_t;
 
 typedef struct {
@@ -230,17 +230,22 @@ const c4_sync_state_t c4_get_validators(uint32_t period, chain_id_t chain_id) {
 
   if (found && storage_conf.get) storage_conf.get(name, &validators);
 #ifdef BLS_DESERIALIZE
-  if (validators.data.data && validators.data.len == 512 * 48) {
-    bytes_t b = blst_deserialize_p1_affine(validators.data.data, 512);
+  if (validators.data.data && (validators.data.len == 512 * 48 || validators.data.len == 513 * 48)) {
+    bytes_t b = blst_deserialize_p1_affine(validators.data.data, validators.data.len / 48);
     buffer_free(&validators);
     validators.data = b;
     storage_conf.set(name, b);
   }
 #endif
 
+  // the keys are either compressed (48 bytes) or deserialized (96 bytes) and may be followed by their aggregate
+  bool     deserialized = validators.data.data && validators.data.len >= 512 * 96;
+  uint32_t key_len      = deserialized ? 96 : 48;
+
   return (c4_sync_state_t) {
-      .deserialized   = validators.data.data && validators.data.len > 512 * 48,
-      .current_period = period,
-      .last_period    = last_period,
-      .validators     = validators.data};
+      .deserialized      = deserialized,
+      .current_period    = period,
+      .last_period       = last_period,
+      .validators        = validators.data,
+      .aggregated_pubkey = validators.data.len == 513 * key_len ? validators.data.data + 512 * key_len : NULL};
 }
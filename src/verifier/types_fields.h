@@ -0,0 +1,334 @@
+// generated by scripts/update_ssz_fields.js from the type definitions - do not edit!
+#ifndef types_fields_h__
+#define types_fields_h__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "../util/ssz.h"
+
+// BEACON_BLOCK_HEADER (fixed length: 112)
+extern const ssz_def_t BEACON_BLOCK_HEADER[];
+#define IDX_BEACON_BLOCK_HEADER_SLOT           0
+#define IDX_BEACON_BLOCK_HEADER_PROPOSER_INDEX 1
+#define IDX_BEACON_BLOCK_HEADER_PARENT_ROOT    2
+#define IDX_BEACON_BLOCK_HEADER_STATE_ROOT     3
+#define IDX_BEACON_BLOCK_HEADER_BODY_ROOT      4
+static inline ssz_ob_t beacon_block_header_slot(ssz_ob_t* ob) { return ssz_get_fixed_field(ob, BEACON_BLOCK_HEADER, IDX_BEACON_BLOCK_HEADER_SLOT, 0, 8); }
+static inline ssz_ob_t beacon_block_header_proposer_index(ssz_ob_t* ob) { return ssz_get_fixed_field(ob, BEACON_BLOCK_HEADER, IDX_BEACON_BLOCK_HEADER_PROPOSER_INDEX, 8, 8); }
+static inline ssz_ob_t beacon_block_header_parent_root(ssz_ob_t* ob) { return ssz_get_fixed_field(ob, BEACON_BLOCK_HEADER, IDX_BEACON_BLOCK_HEADER_PARENT_ROOT, 16, 32); }
+static inline ssz_ob_t beacon_block_header_state_root(ssz_ob_t* ob) { return ssz_get_fixed_field(ob, BEACON_BLOCK_HEADER, IDX_BEACON_BLOCK_HEADER_STATE_ROOT, 48, 32); }
+static inline ssz_ob_t beacon_block_header_body_root(ssz_ob_t* ob) { return ssz_get_fixed_field(ob, BEACON_BLOCK_HEADER, IDX_BEACON_BLOCK_HEADER_BODY_ROOT, 80, 32); }
+
+// SYNC_COMMITTEE (fixed length: 24624)
+extern const ssz_def_t SYNC_COMMITTEE[];
+#define IDX_SYNC_COMMITTEE_PUBKEYS          0
+#define IDX_SYNC_COMMITTEE_AGGREGATE_PUBKEY 1
+static inline ssz_ob_t sync_committee_pubkeys(ssz_ob_t* ob) { return ssz_get_fixed_field(ob, SYNC_COMMITTEE, IDX_SYNC_COMMITTEE_PUBKEYS, 0, 24576); }
+static inline ssz_ob_t sync_committee_aggregate_pubkey(ssz_ob_t* ob) { return ssz_get_fixed_field(ob, SYNC_COMMITTEE, IDX_SYNC_COMMITTEE_AGGREGATE_PUBKEY, 24576, 48); }
+
+// EXECUTION_PAYLOAD_HEADER (dynamic)
+extern const ssz_def_t EXECUTION_PAYLOAD_HEADER[];
+#define IDX_EXECUTION_PAYLOAD_HEADER_PARENT_HASH       0
+#define IDX_EXECUTION_PAYLOAD_HEADER_FEE_RECIPIENT     1
+#define IDX_EXECUTION_PAYLOAD_HEADER_STATE_ROOT        2
+#define IDX_EXECUTION_PAYLOAD_HEADER_RECEIPTS_ROOT     3
+#define IDX_EXECUTION_PAYLOAD_HEADER_LOGS_BLOOM        4
+#define IDX_EXECUTION_PAYLOAD_HEADER_PREV_RANDAO       5
+#define IDX_EXECUTION_PAYLOAD_HEADER_BLOCK_NUMBER      6
+#define IDX_EXECUTION_PAYLOAD_HEADER_GAS_LIMIT         7
+#define IDX_EXECUTION_PAYLOAD_HEADER_GAS_USED          8
+#define IDX_EXECUTION_PAYLOAD_HEADER_TIMESTAMP         9
+#define IDX_EXECUTION_PAYLOAD_HEADER_EXTRA_DATA        10
+#define IDX_EXECUTION_PAYLOAD_HEADER_BASE_FEE_PER_GAS  11
+#define IDX_EXECUTION_PAYLOAD_HEADER_BLOCK_HASH        12
+#define IDX_EXECUTION_PAYLOAD_HEADER_TRANSACTIONS_ROOT 13
+#define IDX_EXECUTION_PAYLOAD_HEADER_WITHDRAWALS_ROOT  14
+#define IDX_EXECUTION_PAYLOAD_HEADER_BLOB_GAS_USED     15
+#define IDX_EXECUTION_PAYLOAD_HEADER_EXCESS_BLOB_GAS   16
+static inline ssz_ob_t execution_payload_header_parent_hash(ssz_ob_t* ob) { return ssz_get_fixed_field(ob, EXECUTION_PAYLOAD_HEADER, IDX_EXECUTION_PAYLOAD_HEADER_PARENT_HASH, 0, 32); }
+static inline ssz_ob_t execution_payload_header_fee_recipient(ssz_ob_t* ob) { return ssz_get_fixed_field(ob, EXECUTION_PAYLOAD_HEADER, IDX_EXECUTION_PAYLOAD_HEADER_FEE_RECIPIENT, 32, 20); }
+static inline ssz_ob_t execution_payload_header_state_root(ssz_ob_t* ob) { return ssz_get_fixed_field(ob, EXECUTION_PAYLOAD_HEADER, IDX_EXECUTION_PAYLOAD_HEADER_STATE_ROOT, 52, 32); }
+static inline ssz_ob_t execution_payload_header_receipts_root(ssz_ob_t* ob) { return ssz_get_fixed_field(ob, EXECUTION_PAYLOAD_HEADER, IDX_EXECUTION_PAYLOAD_HEADER_RECEIPTS_ROOT, 84, 32); }
+static inline ssz_ob_t execution_payload_header_logs_bloom(ssz_ob_t* ob) { return ssz_get_fixed_field(ob, EXECUTION_PAYLOAD_HEADER, IDX_EXECUTION_PAYLOAD_HEADER_LOGS_BLOOM, 116, 256); }
+static inline ssz_ob_t execution_payload_header_prev_randao(ssz_ob_t* ob) { return ssz_get_fixed_field(ob, EXECUTION_PAYLOAD_HEADER, IDX_EXECUTION_PAYLOAD_HEADER_PREV_RANDAO, 372, 32); }
+static inline ssz_ob_t execution_payload_header_block_number(ssz_ob_t* ob) { return ssz_get_fixed_field(ob, EXECUTION_PAYLOAD_HEADER, IDX_EXECUTION_PAYLOAD_HEADER_BLOCK_NUMBER, 404, 8); }
+static inline ssz_ob_t execution_payload_header_gas_limit(ssz_ob_t* ob) { return ssz_get_fixed_field(ob, EXECUTION_PAYLOAD_HEADER, IDX_EXECUTION_PAYLOAD_HEADER_GAS_LIMIT, 412, 8); }
+static inline ssz_ob_t execution_payload_header_gas_used(ssz_ob_t* ob) { return ssz_get_fixed_field(ob, EXECUTION_PAYLOAD_HEADER, IDX_EXECUTION_PAYLOAD_HEADER_GAS_USED, 420, 8); }
+static inline ssz_ob_t execution_payload_header_timestamp(ssz_ob_t* ob) { return ssz_get_fixed_field(ob, EXECUTION_PAYLOAD_HEADER, IDX_EXECUTION_PAYLOAD_HEADER_TIMESTAMP, 428, 8); }
+static inline ssz_ob_t execution_payload_header_extra_data(ssz_ob_t* ob) { return ssz_get_indexed_field(ob, EXECUTION_PAYLOAD_HEADER, IDX_EXECUTION_PAYLOAD_HEADER_EXTRA_DATA); }
+static inline ssz_ob_t execution_payload_header_base_fee_per_gas(ssz_ob_t* ob) { return ssz_get_fixed_field(ob, EXECUTION_PAYLOAD_HEADER, IDX_EXECUTION_PAYLOAD_HEADER_BASE_FEE_PER_GAS, 440, 32); }
+static inline ssz_ob_t execution_payload_header_block_hash(ssz_ob_t* ob) { return ssz_get_fixed_field(ob, EXECUTION_PAYLOAD_HEADER, IDX_EXECUTION_PAYLOAD_HEADER_BLOCK_HASH, 472, 32); }
+static inline ssz_ob_t execution_payload_header_transactions_root(ssz_ob_t* ob) { return ssz_get_fixed_field(ob, EXECUTION_PAYLOAD_HEADER, IDX_EXECUTION_PAYLOAD_HEADER_TRANSACTIONS_ROOT, 504, 32); }
+static inline ssz_ob_t execution_payload_header_withdrawals_root(ssz_ob_t* ob) { return ssz_get_fixed_field(ob, EXECUTION_PAYLOAD_HEADER, IDX_EXECUTION_PAYLOAD_HEADER_WITHDRAWALS_ROOT, 536, 32); }
+static inline ssz_ob_t execution_payload_header_blob_gas_used(ssz_ob_t* ob) { return ssz_get_fixed_field(ob, EXECUTION_PAYLOAD_HEADER, IDX_EXECUTION_PAYLOAD_HEADER_BLOB_GAS_USED, 568, 8); }
+static inline ssz_ob_t execution_payload_header_excess_blob_gas(ssz_ob_t* ob) { return ssz_get_fixed_field(ob, EXECUTION_PAYLOAD_HEADER, IDX_EXECUTION_PAYLOAD_HEADER_EXCESS_BLOB_GAS, 576, 8); }
+
+// SYNC_AGGREGATE (fixed length: 160)
+extern const ssz_def_t SYNC_AGGREGATE[];
+#define IDX_SYNC_AGGREGATE_SYNC_COMMITTEE_BITS      0
+#define IDX_SYNC_AGGREGATE_SYNC_COMMITTEE_SIGNATURE 1
+static inline ssz_ob_t sync_aggregate_sync_committee_bits(ssz_ob_t* ob) { return ssz_get_fixed_field(ob, SYNC_AGGREGATE, IDX_SYNC_AGGREGATE_SYNC_COMMITTEE_BITS, 0, 64); }
+static inline ssz_ob_t sync_aggregate_sync_committee_signature(ssz_ob_t* ob) { return ssz_get_fixed_field(ob, SYNC_AGGREGATE, IDX_SYNC_AGGREGATE_SYNC_COMMITTEE_SIGNATURE, 64, 96); }
+
+// LIGHT_CLIENT_HEADER (dynamic)
+extern const ssz_def_t LIGHT_CLIENT_HEADER[];
+#define IDX_LIGHT_CLIENT_HEADER_BEACON           0
+#define IDX_LIGHT_CLIENT_HEADER_EXECUTION        1
+#define IDX_LIGHT_CLIENT_HEADER_EXECUTION_BRANCH 2
+static inline ssz_ob_t light_client_header_beacon(ssz_ob_t* ob) { return ssz_get_fixed_field(ob, LIGHT_CLIENT_HEADER, IDX_LIGHT_CLIENT_HEADER_BEACON, 0, 112); }
+static inline ssz_ob_t light_client_header_execution(ssz_ob_t* ob) { return ssz_get_indexed_field(ob, LIGHT_CLIENT_HEADER, IDX_LIGHT_CLIENT_HEADER_EXECUTION); }
+static inline ssz_ob_t light_client_header_execution_branch(ssz_ob_t* ob) { return ssz_get_fixed_field(ob, LIGHT_CLIENT_HEADER, IDX_LIGHT_CLIENT_HEADER_EXECUTION_BRANCH, 116, 128); }
+
+// LIGHT_CLIENT_UPDATE (dynamic)
+extern const ssz_def_t LIGHT_CLIENT_UPDATE[];
+#define IDX_LIGHT_CLIENT_UPDATE_ATTESTED_HEADER            0
+#define IDX_LIGHT_CLIENT_UPDATE_NEXT_SYNC_COMMITTEE        1
+#define IDX_LIGHT_CLIENT_UPDATE_NEXT_SYNC_COMMITTEE_BRANCH 2
+#define IDX_LIGHT_CLIENT_UPDATE_FINALIZED_HEADER           3
+#define IDX_LIGHT_CLIENT_UPDATE_FINALITY_BRANCH            4
+#define IDX_LIGHT_CLIENT_UPDATE_SYNC_AGGREGATE             5
+#define IDX_LIGHT_CLIENT_UPDATE_SIGNATURE_SLOT             6
+static inline ssz_ob_t light_client_update_attested_header(ssz_ob_t* ob) { return ssz_get_indexed_field(ob, LIGHT_CLIENT_UPDATE, IDX_LIGHT_CLIENT_UPDATE_ATTESTED_HEADER); }
+static inline ssz_ob_t light_client_update_next_sync_committee(ssz_ob_t* ob) { return ssz_get_fixed_field(ob, LIGHT_CLIENT_UPDATE, IDX_LIGHT_CLIENT_UPDATE_NEXT_SYNC_COMMITTEE, 4, 24624); }
+static inline ssz_ob_t light_client_update_next_sync_committee_branch(ssz_ob_t* ob) { return ssz_get_fixed_field(ob, LIGHT_CLIENT_UPDATE, IDX_LIGHT_CLIENT_UPDATE_NEXT_SYNC_COMMITTEE_BRANCH, 24628, 160); }
+static inline ssz_ob_t light_client_update_finalized_header(ssz_ob_t* ob) { return ssz_get_indexed_field(ob, LIGHT_CLIENT_UPDATE, IDX_LIGHT_CLIENT_UPDATE_FINALIZED_HEADER); }
+static inline ssz_ob_t light_client_update_finality_branch(ssz_ob_t* ob) { return ssz_get_fixed_field(ob, LIGHT_CLIENT_UPDATE, IDX_LIGHT_CLIENT_UPDATE_FINALITY_BRANCH, 24792, 192); }
+static inline ssz_ob_t light_client_update_sync_aggregate(ssz_ob_t* ob) { return ssz_get_fixed_field(ob, LIGHT_CLIENT_UPDATE, IDX_LIGHT_CLIENT_UPDATE_SYNC_AGGREGATE, 24984, 160); }
+static inline ssz_ob_t light_client_update_signature_slot(ssz_ob_t* ob) { return ssz_get_fixed_field(ob, LIGHT_CLIENT_UPDATE, IDX_LIGHT_CLIENT_UPDATE_SIGNATURE_SLOT, 25144, 8); }
+
+// BLOCK_HASH_PROOF (dynamic)
+extern const ssz_def_t BLOCK_HASH_PROOF[];
+#define IDX_BLOCK_HASH_PROOF_BLOCKHASH_PROOF          0
+#define IDX_BLOCK_HASH_PROOF_HEADER                   1
+#define IDX_BLOCK_HASH_PROOF_SYNC_COMMITTEE_BITS      2
+#define IDX_BLOCK_HASH_PROOF_SYNC_COMMITTEE_SIGNATURE 3
+static inline ssz_ob_t block_hash_proof_blockhash_proof(ssz_ob_t* ob) { return ssz_get_indexed_field(ob, BLOCK_HASH_PROOF, IDX_BLOCK_HASH_PROOF_BLOCKHASH_PROOF); }
+static inline ssz_ob_t block_hash_proof_header(ssz_ob_t* ob) { return ssz_get_fixed_field(ob, BLOCK_HASH_PROOF, IDX_BLOCK_HASH_PROOF_HEADER, 4, 112); }
+static inline ssz_ob_t block_hash_proof_sync_committee_bits(ssz_ob_t* ob) { return ssz_get_fixed_field(ob, BLOCK_HASH_PROOF, IDX_BLOCK_HASH_PROOF_SYNC_COMMITTEE_BITS, 116, 64); }
+static inline ssz_ob_t block_hash_proof_sync_committee_signature(ssz_ob_t* ob) { return ssz_get_fixed_field(ob, BLOCK_HASH_PROOF, IDX_BLOCK_HASH_PROOF_SYNC_COMMITTEE_SIGNATURE, 180, 96); }
+
+// ETH_STATE_PROOF (dynamic)
+extern const ssz_def_t ETH_STATE_PROOF[];
+#define IDX_ETH_STATE_PROOF_STATE_PROOF              0
+#define IDX_ETH_STATE_PROOF_HEADER                   1
+#define IDX_ETH_STATE_PROOF_SYNC_COMMITTEE_BITS      2
+#define IDX_ETH_STATE_PROOF_SYNC_COMMITTEE_SIGNATURE 3
+static inline ssz_ob_t eth_state_proof_state_proof(ssz_ob_t* ob) { return ssz_get_indexed_field(ob, ETH_STATE_PROOF, IDX_ETH_STATE_PROOF_STATE_PROOF); }
+static inline ssz_ob_t eth_state_proof_header(ssz_ob_t* ob) { return ssz_get_fixed_field(ob, ETH_STATE_PROOF, IDX_ETH_STATE_PROOF_HEADER, 4, 112); }
+static inline ssz_ob_t eth_state_proof_sync_committee_bits(ssz_ob_t* ob) { return ssz_get_fixed_field(ob, ETH_STATE_PROOF, IDX_ETH_STATE_PROOF_SYNC_COMMITTEE_BITS, 116, 64); }
+static inline ssz_ob_t eth_state_proof_sync_committee_signature(ssz_ob_t* ob) { return ssz_get_fixed_field(ob, ETH_STATE_PROOF, IDX_ETH_STATE_PROOF_SYNC_COMMITTEE_SIGNATURE, 180, 96); }
+
+// ETH_STORAGE_PROOF (dynamic)
+extern const ssz_def_t ETH_STORAGE_PROOF[];
+#define IDX_ETH_STORAGE_PROOF_KEY   0
+#define IDX_ETH_STORAGE_PROOF_PROOF 1
+#define IDX_ETH_STORAGE_PROOF_VALUE 2
+static inline ssz_ob_t eth_storage_proof_key(ssz_ob_t* ob) { return ssz_get_fixed_field(ob, ETH_STORAGE_PROOF, IDX_ETH_STORAGE_PROOF_KEY, 0, 32); }
+static inline ssz_ob_t eth_storage_proof_proof(ssz_ob_t* ob) { return ssz_get_indexed_field(ob, ETH_STORAGE_PROOF, IDX_ETH_STORAGE_PROOF_PROOF); }
+static inline ssz_ob_t eth_storage_proof_value(ssz_ob_t* ob) { return ssz_get_fixed_field(ob, ETH_STORAGE_PROOF, IDX_ETH_STORAGE_PROOF_VALUE, 36, 32); }
+
+// ETH_ACCESS_LIST_DATA (dynamic)
+extern const ssz_def_t ETH_ACCESS_LIST_DATA[];
+#define IDX_ETH_ACCESS_LIST_DATA_ADDRESS      0
+#define IDX_ETH_ACCESS_LIST_DATA_STORAGE_KEYS 1
+static inline ssz_ob_t eth_access_list_data_address(ssz_ob_t* ob) { return ssz_get_fixed_field(ob, ETH_ACCESS_LIST_DATA, IDX_ETH_ACCESS_LIST_DATA_ADDRESS, 0, 20); }
+static inline ssz_ob_t eth_access_list_data_storage_keys(ssz_ob_t* ob) { return ssz_get_indexed_field(ob, ETH_ACCESS_LIST_DATA, IDX_ETH_ACCESS_LIST_DATA_STORAGE_KEYS); }
+
+// ETH_TX_DATA (dynamic)
+extern const ssz_def_t ETH_TX_DATA[];
+#define IDX_ETH_TX_DATA_BLOCK_HASH               0
+#define IDX_ETH_TX_DATA_BLOCK_NUMBER             1
+#define IDX_ETH_TX_DATA_HASH                     2
+#define IDX_ETH_TX_DATA_TRANSACTION_INDEX        3
+#define IDX_ETH_TX_DATA_TYPE                     4
+#define IDX_ETH_TX_DATA_NONCE                    5
+#define IDX_ETH_TX_DATA_INPUT                    6
+#define IDX_ETH_TX_DATA_R                        7
+#define IDX_ETH_TX_DATA_S                        8
+#define IDX_ETH_TX_DATA_CHAIN_ID                 9
+#define IDX_ETH_TX_DATA_V                        10
+#define IDX_ETH_TX_DATA_GAS                      11
+#define IDX_ETH_TX_DATA_FROM                     12
+#define IDX_ETH_TX_DATA_TO                       13
+#define IDX_ETH_TX_DATA_VALUE                    14
+#define IDX_ETH_TX_DATA_GAS_PRICE                15
+#define IDX_ETH_TX_DATA_MAX_FEE_PER_GAS          16
+#define IDX_ETH_TX_DATA_MAX_PRIORITY_FEE_PER_GAS 17
+#define IDX_ETH_TX_DATA_ACCESS_LIST              18
+#define IDX_ETH_TX_DATA_BLOB_VERSIONED_HASHES    19
+#define IDX_ETH_TX_DATA_Y_PARITY                 20
+static inline ssz_ob_t eth_tx_data_block_hash(ssz_ob_t* ob) { return ssz_get_fixed_field(ob, ETH_TX_DATA, IDX_ETH_TX_DATA_BLOCK_HASH, 0, 32); }
+static inline ssz_ob_t eth_tx_data_block_number(ssz_ob_t* ob) { return ssz_get_fixed_field(ob, ETH_TX_DATA, IDX_ETH_TX_DATA_BLOCK_NUMBER, 32, 8); }
+static inline ssz_ob_t eth_tx_data_hash(ssz_ob_t* ob) { return ssz_get_fixed_field(ob, ETH_TX_DATA, IDX_ETH_TX_DATA_HASH, 40, 32); }
+static inline ssz_ob_t eth_tx_data_transaction_index(ssz_ob_t* ob) { return ssz_get_fixed_field(ob, ETH_TX_DATA, IDX_ETH_TX_DATA_TRANSACTION_INDEX, 72, 4); }
+static inline ssz_ob_t eth_tx_data_type(ssz_ob_t* ob) { return ssz_get_fixed_field(ob, ETH_TX_DATA, IDX_ETH_TX_DATA_TYPE, 76, 1); }
+static inline ssz_ob_t eth_tx_data_nonce(ssz_ob_t* ob) { return ssz_get_fixed_field(ob, ETH_TX_DATA, IDX_ETH_TX_DATA_NONCE, 77, 8); }
+static inline ssz_ob_t eth_tx_data_input(ssz_ob_t* ob) { return ssz_get_indexed_field(ob, ETH_TX_DATA, IDX_ETH_TX_DATA_INPUT); }
+static inline ssz_ob_t eth_tx_data_r(ssz_ob_t* ob) { return ssz_get_fixed_field(ob, ETH_TX_DATA, IDX_ETH_TX_DATA_R, 89, 32); }
+static inline ssz_ob_t eth_tx_data_s(ssz_ob_t* ob) { return ssz_get_fixed_field(ob, ETH_TX_DATA, IDX_ETH_TX_DATA_S, 121, 32); }
+static inline ssz_ob_t eth_tx_data_chain_id(ssz_ob_t* ob) { return ssz_get_fixed_field(ob, ETH_TX_DATA, IDX_ETH_TX_DATA_CHAIN_ID, 153, 4); }
+static inline ssz_ob_t eth_tx_data_v(ssz_ob_t* ob) { return ssz_get_fixed_field(ob, ETH_TX_DATA, IDX_ETH_TX_DATA_V, 157, 1); }
+static inline ssz_ob_t eth_tx_data_gas(ssz_ob_t* ob) { return ssz_get_fixed_field(ob, ETH_TX_DATA, IDX_ETH_TX_DATA_GAS, 158, 8); }
+static inline ssz_ob_t eth_tx_data_from(ssz_ob_t* ob) { return ssz_get_fixed_field(ob, ETH_TX_DATA, IDX_ETH_TX_DATA_FROM, 166, 20); }
+static inline ssz_ob_t eth_tx_data_to(ssz_ob_t* ob) { return ssz_get_indexed_field(ob, ETH_TX_DATA, IDX_ETH_TX_DATA_TO); }
+static inline ssz_ob_t eth_tx_data_value(ssz_ob_t* ob) { return ssz_get_fixed_field(ob, ETH_TX_DATA, IDX_ETH_TX_DATA_VALUE, 190, 32); }
+static inline ssz_ob_t eth_tx_data_gas_price(ssz_ob_t* ob) { return ssz_get_fixed_field(ob, ETH_TX_DATA, IDX_ETH_TX_DATA_GAS_PRICE, 222, 8); }
+static inline ssz_ob_t eth_tx_data_max_fee_per_gas(ssz_ob_t* ob) { return ssz_get_fixed_field(ob, ETH_TX_DATA, IDX_ETH_TX_DATA_MAX_FEE_PER_GAS, 230, 8); }
+static inline ssz_ob_t eth_tx_data_max_priority_fee_per_gas(ssz_ob_t* ob) { return ssz_get_fixed_field(ob, ETH_TX_DATA, IDX_ETH_TX_DATA_MAX_PRIORITY_FEE_PER_GAS, 238, 8); }
+static inline ssz_ob_t eth_tx_data_access_list(ssz_ob_t* ob) { return ssz_get_indexed_field(ob, ETH_TX_DATA, IDX_ETH_TX_DATA_ACCESS_LIST); }
+static inline ssz_ob_t eth_tx_data_blob_versioned_hashes(ssz_ob_t* ob) { return ssz_get_indexed_field(ob, ETH_TX_DATA, IDX_ETH_TX_DATA_BLOB_VERSIONED_HASHES); }
+static inline ssz_ob_t eth_tx_data_y_parity(ssz_ob_t* ob) { return ssz_get_fixed_field(ob, ETH_TX_DATA, IDX_ETH_TX_DATA_Y_PARITY, 254, 1); }
+
+// ETH_RECEIPT_DATA_LOG (dynamic)
+extern const ssz_def_t ETH_RECEIPT_DATA_LOG[];
+#define IDX_ETH_RECEIPT_DATA_LOG_BLOCK_HASH        0
+#define IDX_ETH_RECEIPT_DATA_LOG_BLOCK_NUMBER      1
+#define IDX_ETH_RECEIPT_DATA_LOG_TRANSACTION_HASH  2
+#define IDX_ETH_RECEIPT_DATA_LOG_TRANSACTION_INDEX 3
+#define IDX_ETH_RECEIPT_DATA_LOG_ADDRESS           4
+#define IDX_ETH_RECEIPT_DATA_LOG_LOG_INDEX         5
+#define IDX_ETH_RECEIPT_DATA_LOG_REMOVED           6
+#define IDX_ETH_RECEIPT_DATA_LOG_TOPICS            7
+#define IDX_ETH_RECEIPT_DATA_LOG_DATA              8
+static inline ssz_ob_t eth_receipt_data_log_block_hash(ssz_ob_t* ob) { return ssz_get_fixed_field(ob, ETH_RECEIPT_DATA_LOG, IDX_ETH_RECEIPT_DATA_LOG_BLOCK_HASH, 0, 32); }
+static inline ssz_ob_t eth_receipt_data_log_block_number(ssz_ob_t* ob) { return ssz_get_fixed_field(ob, ETH_RECEIPT_DATA_LOG, IDX_ETH_RECEIPT_DATA_LOG_BLOCK_NUMBER, 32, 8); }
+static inline ssz_ob_t eth_receipt_data_log_transaction_hash(ssz_ob_t* ob) { return ssz_get_fixed_field(ob, ETH_RECEIPT_DATA_LOG, IDX_ETH_RECEIPT_DATA_LOG_TRANSACTION_HASH, 40, 32); }
+static inline ssz_ob_t eth_receipt_data_log_transaction_index(ssz_ob_t* ob) { return ssz_get_fixed_field(ob, ETH_RECEIPT_DATA_LOG, IDX_ETH_RECEIPT_DATA_LOG_TRANSACTION_INDEX, 72, 4); }
+static inline ssz_ob_t eth_receipt_data_log_address(ssz_ob_t* ob) { return ssz_get_fixed_field(ob, ETH_RECEIPT_DATA_LOG, IDX_ETH_RECEIPT_DATA_LOG_ADDRESS, 76, 20); }
+static inline ssz_ob_t eth_receipt_data_log_log_index(ssz_ob_t* ob) { return ssz_get_fixed_field(ob, ETH_RECEIPT_DATA_LOG, IDX_ETH_RECEIPT_DATA_LOG_LOG_INDEX, 96, 4); }
+static inline ssz_ob_t eth_receipt_data_log_removed(ssz_ob_t* ob) { return ssz_get_fixed_field(ob, ETH_RECEIPT_DATA_LOG, IDX_ETH_RECEIPT_DATA_LOG_REMOVED, 100, 1); }
+static inline ssz_ob_t eth_receipt_data_log_topics(ssz_ob_t* ob) { return ssz_get_indexed_field(ob, ETH_RECEIPT_DATA_LOG, IDX_ETH_RECEIPT_DATA_LOG_TOPICS); }
+static inline ssz_ob_t eth_receipt_data_log_data(ssz_ob_t* ob) { return ssz_get_indexed_field(ob, ETH_RECEIPT_DATA_LOG, IDX_ETH_RECEIPT_DATA_LOG_DATA); }
+
+// ETH_RECEIPT_DATA (dynamic)
+extern const ssz_def_t ETH_RECEIPT_DATA[];
+#define IDX_ETH_RECEIPT_DATA_BLOCK_HASH          0
+#define IDX_ETH_RECEIPT_DATA_BLOCK_NUMBER        1
+#define IDX_ETH_RECEIPT_DATA_TRANSACTION_HASH    2
+#define IDX_ETH_RECEIPT_DATA_TRANSACTION_INDEX   3
+#define IDX_ETH_RECEIPT_DATA_TYPE                4
+#define IDX_ETH_RECEIPT_DATA_FROM                5
+#define IDX_ETH_RECEIPT_DATA_TO                  6
+#define IDX_ETH_RECEIPT_DATA_CUMULATIVE_GAS_USED 7
+#define IDX_ETH_RECEIPT_DATA_GAS_USED            8
+#define IDX_ETH_RECEIPT_DATA_LOGS                9
+#define IDX_ETH_RECEIPT_DATA_LOGS_BLOOM          10
+#define IDX_ETH_RECEIPT_DATA_STATUS              11
+#define IDX_ETH_RECEIPT_DATA_EFFECTIVE_GAS_PRICE 12
+static inline ssz_ob_t eth_receipt_data_block_hash(ssz_ob_t* ob) { return ssz_get_fixed_field(ob, ETH_RECEIPT_DATA, IDX_ETH_RECEIPT_DATA_BLOCK_HASH, 0, 32); }
+static inline ssz_ob_t eth_receipt_data_block_number(ssz_ob_t* ob) { return ssz_get_fixed_field(ob, ETH_RECEIPT_DATA, IDX_ETH_RECEIPT_DATA_BLOCK_NUMBER, 32, 8); }
+static inline ssz_ob_t eth_receipt_data_transaction_hash(ssz_ob_t* ob) { return ssz_get_fixed_field(ob, ETH_RECEIPT_DATA, IDX_ETH_RECEIPT_DATA_TRANSACTION_HASH, 40, 32); }
+static inline ssz_ob_t eth_receipt_data_transaction_index(ssz_ob_t* ob) { return ssz_get_fixed_field(ob, ETH_RECEIPT_DATA, IDX_ETH_RECEIPT_DATA_TRANSACTION_INDEX, 72, 4); }
+static inline ssz_ob_t eth_receipt_data_type(ssz_ob_t* ob) { return ssz_get_fixed_field(ob, ETH_RECEIPT_DATA, IDX_ETH_RECEIPT_DATA_TYPE, 76, 1); }
+static inline ssz_ob_t eth_receipt_data_from(ssz_ob_t* ob) { return ssz_get_fixed_field(ob, ETH_RECEIPT_DATA, IDX_ETH_RECEIPT_DATA_FROM, 77, 20); }
+static inline ssz_ob_t eth_receipt_data_to(ssz_ob_t* ob) { return ssz_get_indexed_field(ob, ETH_RECEIPT_DATA, IDX_ETH_RECEIPT_DATA_TO); }
+static inline ssz_ob_t eth_receipt_data_cumulative_gas_used(ssz_ob_t* ob) { return ssz_get_fixed_field(ob, ETH_RECEIPT_DATA, IDX_ETH_RECEIPT_DATA_CUMULATIVE_GAS_USED, 101, 8); }
+static inline ssz_ob_t eth_receipt_data_gas_used(ssz_ob_t* ob) { return ssz_get_fixed_field(ob, ETH_RECEIPT_DATA, IDX_ETH_RECEIPT_DATA_GAS_USED, 109, 8); }
+static inline ssz_ob_t eth_receipt_data_logs(ssz_ob_t* ob) { return ssz_get_indexed_field(ob, ETH_RECEIPT_DATA, IDX_ETH_RECEIPT_DATA_LOGS); }
+static inline ssz_ob_t eth_receipt_data_logs_bloom(ssz_ob_t* ob) { return ssz_get_fixed_field(ob, ETH_RECEIPT_DATA, IDX_ETH_RECEIPT_DATA_LOGS_BLOOM, 121, 256); }
+static inline ssz_ob_t eth_receipt_data_status(ssz_ob_t* ob) { return ssz_get_fixed_field(ob, ETH_RECEIPT_DATA, IDX_ETH_RECEIPT_DATA_STATUS, 377, 1); }
+static inline ssz_ob_t eth_receipt_data_effective_gas_price(ssz_ob_t* ob) { return ssz_get_fixed_field(ob, ETH_RECEIPT_DATA, IDX_ETH_RECEIPT_DATA_EFFECTIVE_GAS_PRICE, 378, 8); }
+
+// ETH_RECEIPT_PROOF (dynamic)
+extern const ssz_def_t ETH_RECEIPT_PROOF[];
+#define IDX_ETH_RECEIPT_PROOF_TRANSACTION              0
+#define IDX_ETH_RECEIPT_PROOF_TRANSACTION_INDEX        1
+#define IDX_ETH_RECEIPT_PROOF_BLOCK_NUMBER             2
+#define IDX_ETH_RECEIPT_PROOF_BLOCK_HASH               3
+#define IDX_ETH_RECEIPT_PROOF_RECEIPT_PROOF            4
+#define IDX_ETH_RECEIPT_PROOF_BLOCK_PROOF              5
+#define IDX_ETH_RECEIPT_PROOF_HEADER                   6
+#define IDX_ETH_RECEIPT_PROOF_SYNC_COMMITTEE_BITS      7
+#define IDX_ETH_RECEIPT_PROOF_SYNC_COMMITTEE_SIGNATURE 8
+static inline ssz_ob_t eth_receipt_proof_transaction(ssz_ob_t* ob) { return ssz_get_indexed_field(ob, ETH_RECEIPT_PROOF, IDX_ETH_RECEIPT_PROOF_TRANSACTION); }
+static inline ssz_ob_t eth_receipt_proof_transaction_index(ssz_ob_t* ob) { return ssz_get_fixed_field(ob, ETH_RECEIPT_PROOF, IDX_ETH_RECEIPT_PROOF_TRANSACTION_INDEX, 4, 4); }
+static inline ssz_ob_t eth_receipt_proof_block_number(ssz_ob_t* ob) { return ssz_get_fixed_field(ob, ETH_RECEIPT_PROOF, IDX_ETH_RECEIPT_PROOF_BLOCK_NUMBER, 8, 8); }
+static inline ssz_ob_t eth_receipt_proof_block_hash(ssz_ob_t* ob) { return ssz_get_fixed_field(ob, ETH_RECEIPT_PROOF, IDX_ETH_RECEIPT_PROOF_BLOCK_HASH, 16, 32); }
+static inline ssz_ob_t eth_receipt_proof_receipt_proof(ssz_ob_t* ob) { return ssz_get_indexed_field(ob, ETH_RECEIPT_PROOF, IDX_ETH_RECEIPT_PROOF_RECEIPT_PROOF); }
+static inline ssz_ob_t eth_receipt_proof_block_proof(ssz_ob_t* ob) { return ssz_get_indexed_field(ob, ETH_RECEIPT_PROOF, IDX_ETH_RECEIPT_PROOF_BLOCK_PROOF); }
+static inline ssz_ob_t eth_receipt_proof_header(ssz_ob_t* ob) { return ssz_get_fixed_field(ob, ETH_RECEIPT_PROOF, IDX_ETH_RECEIPT_PROOF_HEADER, 56, 112); }
+static inline ssz_ob_t eth_receipt_proof_sync_committee_bits(ssz_ob_t* ob) { return ssz_get_fixed_field(ob, ETH_RECEIPT_PROOF, IDX_ETH_RECEIPT_PROOF_SYNC_COMMITTEE_BITS, 168, 64); }
+static inline ssz_ob_t eth_receipt_proof_sync_committee_signature(ssz_ob_t* ob) { return ssz_get_fixed_field(ob, ETH_RECEIPT_PROOF, IDX_ETH_RECEIPT_PROOF_SYNC_COMMITTEE_SIGNATURE, 232, 96); }
+
+// ETH_LOGS_TX (dynamic)
+extern const ssz_def_t ETH_LOGS_TX[];
+#define IDX_ETH_LOGS_TX_TRANSACTION       0
+#define IDX_ETH_LOGS_TX_TRANSACTION_INDEX 1
+static inline ssz_ob_t eth_logs_tx_transaction(ssz_ob_t* ob) { return ssz_get_indexed_field(ob, ETH_LOGS_TX, IDX_ETH_LOGS_TX_TRANSACTION); }
+static inline ssz_ob_t eth_logs_tx_transaction_index(ssz_ob_t* ob) { return ssz_get_fixed_field(ob, ETH_LOGS_TX, IDX_ETH_LOGS_TX_TRANSACTION_INDEX, 4, 4); }
+
+// ETH_LOGS_BLOCK (dynamic)
+extern const ssz_def_t ETH_LOGS_BLOCK[];
+#define IDX_ETH_LOGS_BLOCK_BLOCK_NUMBER             0
+#define IDX_ETH_LOGS_BLOCK_BLOCK_HASH               1
+#define IDX_ETH_LOGS_BLOCK_PROOF                    2
+#define IDX_ETH_LOGS_BLOCK_HEADER                   3
+#define IDX_ETH_LOGS_BLOCK_SYNC_COMMITTEE_BITS      4
+#define IDX_ETH_LOGS_BLOCK_SYNC_COMMITTEE_SIGNATURE 5
+#define IDX_ETH_LOGS_BLOCK_TXS                      6
+#define IDX_ETH_LOGS_BLOCK_RECEIPT_PROOF            7
+static inline ssz_ob_t eth_logs_block_block_number(ssz_ob_t* ob) { return ssz_get_fixed_field(ob, ETH_LOGS_BLOCK, IDX_ETH_LOGS_BLOCK_BLOCK_NUMBER, 0, 8); }
+static inline ssz_ob_t eth_logs_block_block_hash(ssz_ob_t* ob) { return ssz_get_fixed_field(ob, ETH_LOGS_BLOCK, IDX_ETH_LOGS_BLOCK_BLOCK_HASH, 8, 32); }
+static inline ssz_ob_t eth_logs_block_proof(ssz_ob_t* ob) { return ssz_get_indexed_field(ob, ETH_LOGS_BLOCK, IDX_ETH_LOGS_BLOCK_PROOF); }
+static inline ssz_ob_t eth_logs_block_header(ssz_ob_t* ob) { return ssz_get_fixed_field(ob, ETH_LOGS_BLOCK, IDX_ETH_LOGS_BLOCK_HEADER, 44, 112); }
+static inline ssz_ob_t eth_logs_block_sync_committee_bits(ssz_ob_t* ob) { return ssz_get_fixed_field(ob, ETH_LOGS_BLOCK, IDX_ETH_LOGS_BLOCK_SYNC_COMMITTEE_BITS, 156, 64); }
+static inline ssz_ob_t eth_logs_block_sync_committee_signature(ssz_ob_t* ob) { return ssz_get_fixed_field(ob, ETH_LOGS_BLOCK, IDX_ETH_LOGS_BLOCK_SYNC_COMMITTEE_SIGNATURE, 220, 96); }
+static inline ssz_ob_t eth_logs_block_txs(ssz_ob_t* ob) { return ssz_get_indexed_field(ob, ETH_LOGS_BLOCK, IDX_ETH_LOGS_BLOCK_TXS); }
+static inline ssz_ob_t eth_logs_block_receipt_proof(ssz_ob_t* ob) { return ssz_get_indexed_field(ob, ETH_LOGS_BLOCK, IDX_ETH_LOGS_BLOCK_RECEIPT_PROOF); }
+
+// ETH_TRANSACTION_PROOF (dynamic)
+extern const ssz_def_t ETH_TRANSACTION_PROOF[];
+#define IDX_ETH_TRANSACTION_PROOF_TRANSACTION              0
+#define IDX_ETH_TRANSACTION_PROOF_TRANSACTION_INDEX        1
+#define IDX_ETH_TRANSACTION_PROOF_BLOCK_NUMBER             2
+#define IDX_ETH_TRANSACTION_PROOF_BLOCK_HASH               3
+#define IDX_ETH_TRANSACTION_PROOF_PROOF                    4
+#define IDX_ETH_TRANSACTION_PROOF_HEADER                   5
+#define IDX_ETH_TRANSACTION_PROOF_SYNC_COMMITTEE_BITS      6
+#define IDX_ETH_TRANSACTION_PROOF_SYNC_COMMITTEE_SIGNATURE 7
+static inline ssz_ob_t eth_transaction_proof_transaction(ssz_ob_t* ob) { return ssz_get_indexed_field(ob, ETH_TRANSACTION_PROOF, IDX_ETH_TRANSACTION_PROOF_TRANSACTION); }
+static inline ssz_ob_t eth_transaction_proof_transaction_index(ssz_ob_t* ob) { return ssz_get_fixed_field(ob, ETH_TRANSACTION_PROOF, IDX_ETH_TRANSACTION_PROOF_TRANSACTION_INDEX, 4, 4); }
+static inline ssz_ob_t eth_transaction_proof_block_number(ssz_ob_t* ob) { return ssz_get_fixed_field(ob, ETH_TRANSACTION_PROOF, IDX_ETH_TRANSACTION_PROOF_BLOCK_NUMBER, 8, 8); }
+static inline ssz_ob_t eth_transaction_proof_block_hash(ssz_ob_t* ob) { return ssz_get_fixed_field(ob, ETH_TRANSACTION_PROOF, IDX_ETH_TRANSACTION_PROOF_BLOCK_HASH, 16, 32); }
+static inline ssz_ob_t eth_transaction_proof_proof(ssz_ob_t* ob) { return ssz_get_indexed_field(ob, ETH_TRANSACTION_PROOF, IDX_ETH_TRANSACTION_PROOF_PROOF); }
+static inline ssz_ob_t eth_transaction_proof_header(ssz_ob_t* ob) { return ssz_get_fixed_field(ob, ETH_TRANSACTION_PROOF, IDX_ETH_TRANSACTION_PROOF_HEADER, 52, 112); }
+static inline ssz_ob_t eth_transaction_proof_sync_committee_bits(ssz_ob_t* ob) { return ssz_get_fixed_field(ob, ETH_TRANSACTION_PROOF, IDX_ETH_TRANSACTION_PROOF_SYNC_COMMITTEE_BITS, 164, 64); }
+static inline ssz_ob_t eth_transaction_proof_sync_committee_signature(ssz_ob_t* ob) { return ssz_get_fixed_field(ob, ETH_TRANSACTION_PROOF, IDX_ETH_TRANSACTION_PROOF_SYNC_COMMITTEE_SIGNATURE, 228, 96); }
+
+// ETH_ACCOUNT_PROOF (dynamic)
+extern const ssz_def_t ETH_ACCOUNT_PROOF[];
+#define IDX_ETH_ACCOUNT_PROOF_ACCOUNT_PROOF 0
+#define IDX_ETH_ACCOUNT_PROOF_ADDRESS       1
+#define IDX_ETH_ACCOUNT_PROOF_BALANCE       2
+#define IDX_ETH_ACCOUNT_PROOF_CODE_HASH     3
+#define IDX_ETH_ACCOUNT_PROOF_NONCE         4
+#define IDX_ETH_ACCOUNT_PROOF_STORAGE_HASH  5
+#define IDX_ETH_ACCOUNT_PROOF_STORAGE_PROOF 6
+#define IDX_ETH_ACCOUNT_PROOF_STATE_PROOF   7
+static inline ssz_ob_t eth_account_proof_account_proof(ssz_ob_t* ob) { return ssz_get_indexed_field(ob, ETH_ACCOUNT_PROOF, IDX_ETH_ACCOUNT_PROOF_ACCOUNT_PROOF); }
+static inline ssz_ob_t eth_account_proof_address(ssz_ob_t* ob) { return ssz_get_fixed_field(ob, ETH_ACCOUNT_PROOF, IDX_ETH_ACCOUNT_PROOF_ADDRESS, 4, 20); }
+static inline ssz_ob_t eth_account_proof_balance(ssz_ob_t* ob) { return ssz_get_fixed_field(ob, ETH_ACCOUNT_PROOF, IDX_ETH_ACCOUNT_PROOF_BALANCE, 24, 32); }
+static inline ssz_ob_t eth_account_proof_code_hash(ssz_ob_t* ob) { return ssz_get_fixed_field(ob, ETH_ACCOUNT_PROOF, IDX_ETH_ACCOUNT_PROOF_CODE_HASH, 56, 32); }
+static inline ssz_ob_t eth_account_proof_nonce(ssz_ob_t* ob) { return ssz_get_fixed_field(ob, ETH_ACCOUNT_PROOF, IDX_ETH_ACCOUNT_PROOF_NONCE, 88, 32); }
+static inline ssz_ob_t eth_account_proof_storage_hash(ssz_ob_t* ob) { return ssz_get_fixed_field(ob, ETH_ACCOUNT_PROOF, IDX_ETH_ACCOUNT_PROOF_STORAGE_HASH, 120, 32); }
+static inline ssz_ob_t eth_account_proof_storage_proof(ssz_ob_t* ob) { return ssz_get_indexed_field(ob, ETH_ACCOUNT_PROOF, IDX_ETH_ACCOUNT_PROOF_STORAGE_PROOF); }
+static inline ssz_ob_t eth_account_proof_state_proof(ssz_ob_t* ob) { return ssz_get_indexed_field(ob, ETH_ACCOUNT_PROOF, IDX_ETH_ACCOUNT_PROOF_STATE_PROOF); }
+
+// C4_REQUEST (dynamic)
+extern const ssz_def_t C4_REQUEST[];
+#define IDX_C4_REQUEST_VERSION   0
+#define IDX_C4_REQUEST_DATA      1
+#define IDX_C4_REQUEST_PROOF     2
+#define IDX_C4_REQUEST_SYNC_DATA 3
+static inline ssz_ob_t c4_request_version(ssz_ob_t* ob) { return ssz_get_fixed_field(ob, C4_REQUEST, IDX_C4_REQUEST_VERSION, 0, 4); }
+static inline ssz_ob_t c4_request_data(ssz_ob_t* ob) { return ssz_get_indexed_field(ob, C4_REQUEST, IDX_C4_REQUEST_DATA); }
+static inline ssz_ob_t c4_request_proof(ssz_ob_t* ob) { return ssz_get_indexed_field(ob, C4_REQUEST, IDX_C4_REQUEST_PROOF); }
+static inline ssz_ob_t c4_request_sync_data(ssz_ob_t* ob) { return ssz_get_indexed_field(ob, C4_REQUEST, IDX_C4_REQUEST_SYNC_DATA); }
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -142,20 +142,20 @@ const ssz_def_t ETH_RECEIPT_PROOF[] = {
     SSZ_BYTE_VECTOR("sync_committee_signature", 96)}; // the signature of the sync committee
 
 const ssz_def_t ETH_LOGS_TX[] = {
-    SSZ_BYTES("transaction", 1073741824),  // the raw transaction payload
-    SSZ_UINT32("transactionIndex"),        // the index of the transaction in the block
-    SSZ_LIST("proof", ssz_bytes_1024, 64), // the Merklr Patricia Proof of the transaction receipt ending in the receipt root
+    SSZ_BYTES("transaction", 1073741824), // the raw transaction payload
+    SSZ_UINT32("transactionIndex"),       // the index of the transaction in the block
 };
 const ssz_def_t ETH_LOGS_TX_CONTAINER = SSZ_CONTAINER("LogsTx", ETH_LOGS_TX);
 
 const ssz_def_t ETH_LOGS_BLOCK[] = {
-    SSZ_UINT64("blockNumber"),                       // the number of the execution block containing the transaction
-    SSZ_BYTES32("blockHash"),                        // the blockHash of the execution block containing the transaction
-    SSZ_LIST("proof", ssz_bytes32, 64),              // the multi proof of the transaction, receipt_root,blockNumber and blockHash
-    SSZ_CONTAINER("header", BEACON_BLOCK_HEADER),    // the header of the beacon block
-    SSZ_BIT_VECTOR("sync_committee_bits", 512),      // the bits of the validators that signed the block
-    SSZ_BYTE_VECTOR("sync_committee_signature", 96), // the signature of the sync committee
-    SSZ_LIST("txs", ETH_LOGS_TX_CONTAINER, 256)};    // the transactions of the block
+    SSZ_UINT64("blockNumber"),                        // the number of the execution block containing the transaction
+    SSZ_BYTES32("blockHash"),                         // the blockHash of the execution block containing the transaction
+    SSZ_LIST("proof", ssz_bytes32, 64),               // the multi proof of the transaction, receipt_root,blockNumber and blockHash
+    SSZ_CONTAINER("header", BEACON_BLOCK_HEADER),     // the header of the beacon block
+    SSZ_BIT_VECTOR("sync_committee_bits", 512),       // the bits of the validators that signed the block
+    SSZ_BYTE_VECTOR("sync_committee_signature", 96),  // the signature of the sync committee
+    SSZ_LIST("txs", ETH_LOGS_TX_CONTAINER, 256),      // the transactions of the block
+    SSZ_LIST("receipt_proof", ssz_bytes_1024, 1024)}; // the Merkle Patricia multi proof of all receipts of the txs, containing each node only once starting with the receipt root
 
 const ssz_def_t ETH_LOGS_BLOCK_CONTAINER = SSZ_CONTAINER("LogsBlock", ETH_LOGS_BLOCK);
 
@@ -5,7 +5,7 @@
 #include "types_verify.h"
 #include <string.h>
 
-void c4_verify_from_bytes(verify_ctx_t* ctx, bytes_t request, char* method, json_t args, chain_id_t chain_id) {
+void c4_verify_init(verify_ctx_t* ctx, bytes_t request, char* method, json_t args, chain_id_t chain_id) {
   ssz_ob_t req = ssz_ob(C4_REQUEST_CONTAINER, request);
   memset(ctx, 0, sizeof(verify_ctx_t));
   if (!ssz_is_valid(req, true, &ctx->state)) return;
@@ -15,9 +15,23 @@ void c4_verify_from_bytes(verify_ctx_t* ctx, bytes_t request, char* method, json
   ctx->sync_data = ssz_get(&req, "sync_data");
   ctx->method    = method;
   ctx->args      = args;
+}
+
+void c4_verify_from_bytes(verify_ctx_t* ctx, bytes_t request, char* method, json_t args, chain_id_t chain_id) {
+  c4_verify_init(ctx, request, method, args, chain_id);
   c4_verify(ctx);
 }
 
+void c4_verify_batch(verify_ctx_t* ctxs, uint32_t len) {
+  c4_signature_batch_t batch = {0};
+  for (uint32_t i = 0; i < len; i++) {
+    ctxs[i].batch = &batch;
+    c4_verify(ctxs + i);
+    ctxs[i].batch = NULL;
+  }
+  c4_verify_signatures(&batch);
+}
+
 void c4_verify(verify_ctx_t* ctx) {
   if (ctx->state.error) return;
   // check if there are sync_datat, we should use to update the state
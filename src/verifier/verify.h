@@ -22,22 +22,32 @@ typedef enum {
   PROOF_TYPE_TRANSACTION,
 } proof_type_t;
 
+// collects the signatures of many proofs or blocks, so they are verified together with one multi pairing
 typedef struct {
-  proof_type_t type;
-  char*        method;
-  json_t       args;
-  ssz_ob_t     proof;
-  ssz_ob_t     data;
-  ssz_ob_t     sync_data;
-  uint64_t     first_missing_period;
-  uint64_t     last_missing_period;
-  bool         success;
-  c4_state_t   state;
-  chain_id_t   chain_id;
+  buffer_t items;  // the bls_batch_item_t to verify
+  buffer_t owners; // the verify_ctx_t* for each item
+} c4_signature_batch_t;
+
+typedef struct {
+  proof_type_t          type;
+  char*                 method;
+  json_t                args;
+  ssz_ob_t              proof;
+  ssz_ob_t              data;
+  ssz_ob_t              sync_data;
+  uint64_t              first_missing_period;
+  uint64_t              last_missing_period;
+  bool                  success;
+  c4_state_t            state;
+  chain_id_t            chain_id;
+  c4_signature_batch_t* batch; // if set, the blockroot signatures are only collected and verified later with c4_verify_signatures
 } verify_ctx_t;
 
 void c4_verify(verify_ctx_t* ctx);
+void c4_verify_init(verify_ctx_t* ctx, bytes_t request, char* method, json_t args, chain_id_t chain_id);
 void c4_verify_from_bytes(verify_ctx_t* ctx, bytes_t request, char* method, json_t args, chain_id_t chain_id);
+// verifies all contexts (initialized with c4_verify_init) and checks the signatures of all their proofs at once.
+void c4_verify_batch(verify_ctx_t* ctxs, uint32_t len);
 bool verify_blockhash_proof(verify_ctx_t* ctx);
 bool verify_account_proof(verify_ctx_t* ctx);
 bool verify_tx_proof(verify_ctx_t* ctx);
@@ -46,6 +56,8 @@ bool verify_logs_proof(verify_ctx_t* ctx);
 
 // helper
 bool c4_verify_blockroot_signature(verify_ctx_t* ctx, ssz_ob_t* header, ssz_ob_t* sync_committee_bits, ssz_ob_t* sync_committee_signature, uint64_t slot);
+// verifies the collected signatures and marks the contexts of invalid ones as failed. The batch is freed afterwards.
+bool c4_verify_signatures(c4_signature_batch_t* batch);
 #pragma endregion
 #ifdef MESSAGES
 #define RETURN_VERIFY_ERROR(ctx, msg)                                             \
@@ -3,6 +3,7 @@
 #include "../util/crypto.h"
 #include "../util/ssz.h"
 #include "sync_committee.h"
+#include "types_fields.h"
 #include "verify.h"
 #include <stdbool.h>
 #include <stdint.h>
@@ -10,41 +11,11 @@
 #include <stdlib.h>
 #include <string.h>
 
-/** the combined GIndex of the blockhash in the block body path = executionPayload*/
-#define BLOCKHASH_BLOCKBODY_GINDEX 812
-
-// combining the root with a domain to ensure uniqueness of the signing message
-static const ssz_def_t SIGNING_DATA[] = {
-    SSZ_BYTES32("root"),    // the hashed root of the data to sign
-    SSZ_BYTES32("domain")}; // the domain of the data to sign
-
-static const ssz_def_t SIGNING_DATA_CONTAINER = SSZ_CONTAINER("SigningData", SIGNING_DATA);
-
-// the fork data is used to create the domain
-static const ssz_def_t FORK_DATA[] = {
-    SSZ_BYTE_VECTOR("version", 4), // the version of the fork
-    SSZ_BYTES32("state")};         // the state of the Genisis Block
-
-static const ssz_def_t FORK_DATA_CONTAINER = SSZ_CONTAINER("ForkDate", FORK_DATA);
-
+// the signing root is the hash_tree_root of the SigningData (root, domain), which is a single hash of both.
 static bool calculate_signing_message(verify_ctx_t* ctx, uint64_t slot, bytes32_t blockhash, bytes32_t signing_message) {
-  uint8_t   buffer[64] = {0};
-  bytes32_t root       = {0};
-
-  // compute fork_data root hash to the seconf 32 bytes of bffer
-  buffer[0] = (uint8_t) c4_chain_fork_id(ctx->chain_id, (slot - 1) >> 5);
-  if (!c4_chain_genesis_validators_root(ctx->chain_id, buffer + 4)) RETURN_VERIFY_ERROR(ctx, "unsupported chain!");
-
-  ssz_hash_tree_root(ssz_ob(FORK_DATA_CONTAINER, bytes(buffer, 36)), root);
-
-  // build domain by replacing the first 4 bytes with the sync committee domain which creates the domain-data in the 2nd 32 bytes of buffer
-  memcpy(buffer, blockhash, 32);
-  memset(buffer + 32, 0, 4);
-  memcpy(buffer + 36, root, 28);
-  buffer[32] = 7; // Domain-Type SYNC_COMMITTEE
-
-  ssz_hash_tree_root(ssz_ob(SIGNING_DATA_CONTAINER, bytes(buffer, 64)), signing_message);
-
+  bytes32_t domain = {0};
+  if (!c4_chain_domain(ctx->chain_id, c4_chain_fork_id(ctx->chain_id, (slot - 1) >> 5), C4_DOMAIN_SYNC_COMMITTEE, domain)) RETURN_VERIFY_ERROR(ctx, "unsupported chain!");
+  sha256_merkle(bytes(blockhash, 32), bytes(domain, 32), signing_message);
   return true;
 }
 
@@ -52,7 +23,7 @@ bool c4_verify_blockroot_signature(verify_ctx_t* ctx, ssz_ob_t* header, ssz_ob_t
   bytes32_t       root       = {0};
   c4_sync_state_t sync_state = {0};
 
-  if (slot == 0) slot = ssz_get_uint64(header, "slot");
+  if (slot == 0) slot = ssz_uint64(beacon_block_header_slot(header));
   if (slot == 0) RETURN_VERIFY_ERROR(ctx, "slot is missing in beacon header!");
 
   // compute blockhash
@@ -71,7 +42,20 @@ bool c4_verify_blockroot_signature(verify_ctx_t* ctx, ssz_ob_t* header, ssz_ob_t
     return false;
   }
 
-  bool valid = blst_verify(root, sync_committee_signature->bytes.data, sync_state.validators.data, 512, sync_committee_bits->bytes, sync_state.deserialized);
+  bool valid = false;
+  if (ctx->batch) {
+    // only the aggregated key is kept, so the signature can be verified later together with all others
+    bls_batch_item_t item = {0};
+    valid                 = sync_committee_signature->bytes.len == 96 && blst_aggregate_pubkeys(sync_state.validators.data, 512, sync_committee_bits->bytes, sync_state.deserialized, sync_state.aggregated_pubkey, item.pubkey);
+    if (valid) {
+      memcpy(item.message, root, 32);
+      memcpy(item.signature, sync_committee_signature->bytes.data, 96);
+      buffer_append(&ctx->batch->items, bytes(&item, sizeof(bls_batch_item_t)));
+      buffer_append(&ctx->batch->owners, bytes(&ctx, sizeof(verify_ctx_t*)));
+    }
+  }
+  else
+    valid = blst_verify(root, sync_committee_signature->bytes.data, sync_state.validators.data, 512, sync_committee_bits->bytes, sync_state.deserialized, sync_state.aggregated_pubkey);
 
 #ifndef C4_STATIC_MEMORY
   free(sync_state.validators.data);
@@ -83,12 +67,32 @@ bool c4_verify_blockroot_signature(verify_ctx_t* ctx, ssz_ob_t* header, ssz_ob_t
   return true;
 }
 
-static bool verify_beacon_header(ssz_ob_t* header, bytes32_t exec_blockhash, bytes_t blockhash_proof) {
+bool c4_verify_signatures(c4_signature_batch_t* batch) {
+  uint32_t       len    = batch->items.data.len / sizeof(bls_batch_item_t);
+  verify_ctx_t** owners = (verify_ctx_t**) batch->owners.data.data;
+  bool*          valid  = len ? calloc(len, sizeof(bool)) : NULL;
+  bool           result = !len || blst_verify_batch((bls_batch_item_t*) batch->items.data.data, (int) len, valid);
+
+  // only if the batch failed, the owners of the invalid signatures are marked as failed
+  for (uint32_t i = 0; i < len && !result; i++) {
+    if (valid[i]) continue;
+    owners[i]->success = false;
+    if (!owners[i]->state.error) owners[i]->state.error = strdup("invalid blockhash signature!");
+  }
+
+  free(valid);
+  buffer_free(&batch->items);
+  buffer_free(&batch->owners);
+  *batch = (c4_signature_batch_t) {0};
+  return result;
+}
+
+static bool verify_beacon_header(verify_ctx_t* ctx, ssz_ob_t* header, bytes32_t exec_blockhash, bytes_t blockhash_proof) {
 
   // check merkle proof
-  ssz_ob_t  header_body_root = ssz_get(header, "bodyRoot");
+  ssz_ob_t  header_body_root = beacon_block_header_body_root(header);
   bytes32_t root_hash;
-  ssz_verify_single_merkle_proof(blockhash_proof, exec_blockhash, BLOCKHASH_BLOCKBODY_GINDEX, root_hash);
+  ssz_verify_single_merkle_proof(blockhash_proof, exec_blockhash, c4_chain_gindexes(ctx->chain_id, ssz_uint64(beacon_block_header_slot(header)))->block_hash, root_hash);
   if (ssz_is_error(header_body_root) || header_body_root.bytes.len != 32 || memcmp(root_hash, header_body_root.bytes.data, 32)) return false;
 
   return true;
@@ -105,7 +109,7 @@ bool verify_blockhash_proof(verify_ctx_t* ctx) {
   if (ssz_is_error(header) || ssz_is_error(blockhash_proof)) RETURN_VERIFY_ERROR(ctx, "invalid proof, missing header or blockhash_proof!");
   if (ssz_is_error(sync_committee_bits) || sync_committee_bits.bytes.len != 64 || ssz_is_error(sync_committee_signature) || sync_committee_signature.bytes.len != 96) RETURN_VERIFY_ERROR(ctx, "invalid proof, missing sync committee bits or signature!");
   if (!ctx->data.def || !ssz_is_type(&ctx->data, &ssz_bytes32) || ctx->data.bytes.data == NULL || ctx->data.bytes.len != 32) RETURN_VERIFY_ERROR(ctx, "invalid data, data is not a bytes32!");
-  if (!verify_beacon_header(&header, ctx->data.bytes.data, blockhash_proof.bytes)) RETURN_VERIFY_ERROR(ctx, "invalid merkle proof for blockhash!");
+  if (!verify_beacon_header(ctx, &header, ctx->data.bytes.data, blockhash_proof.bytes)) RETURN_VERIFY_ERROR(ctx, "invalid merkle proof for blockhash!");
   if (!c4_verify_blockroot_signature(ctx, &header, &sync_committee_bits, &sync_committee_signature, 0)) RETURN_VERIFY_ERROR(ctx, "invalid blockhash signature!");
 
   ctx->success = true;
@@ -7,6 +7,7 @@
 #include "../util/ssz.h"
 #include "eth_tx.h"
 #include "sync_committee.h"
+#include "types_fields.h"
 #include "types_verify.h"
 #include "verify.h"
 #include <stdbool.h>
@@ -16,30 +17,31 @@
 #include <string.h>
 
 static bool verify_merkle_proof(verify_ctx_t* ctx, ssz_ob_t block, bytes32_t receipt_root) {
-  ssz_ob_t  txs          = ssz_get(&block, "txs");
-  int       tx_count     = ssz_len(txs);
-  uint8_t*  leafes       = calloc(3 + tx_count, 32);
-  gindex_t* gindexes     = calloc(3 + tx_count, sizeof(gindex_t));
-  bytes_t   block_number = ssz_get(&block, "blockNumber").bytes;
-  bytes_t   block_hash   = ssz_get(&block, "blockHash").bytes;
-  ssz_ob_t  header       = ssz_get(&block, "header");
-  ssz_ob_t  proof        = ssz_get(&block, "proof");
-  bytes32_t root_hash    = {0}; // calculated body root hash
-  bytes_t   body_root    = ssz_get(&header, "bodyRoot").bytes;
+  ssz_ob_t             txs          = eth_logs_block_txs(&block);
+  int                  tx_count     = ssz_len(txs);
+  uint8_t*             leafes       = calloc(3 + tx_count, 32);
+  gindex_t*            gindexes     = calloc(3 + tx_count, sizeof(gindex_t));
+  bytes_t              block_number = eth_logs_block_block_number(&block).bytes;
+  bytes_t              block_hash   = eth_logs_block_block_hash(&block).bytes;
+  ssz_ob_t             header       = eth_logs_block_header(&block);
+  ssz_ob_t             proof        = eth_logs_block_proof(&block);
+  bytes32_t            root_hash    = {0}; // calculated body root hash
+  bytes_t              body_root    = beacon_block_header_body_root(&header).bytes;
+  const c4_gindexes_t* gindex       = c4_chain_gindexes(ctx->chain_id, ssz_uint64(beacon_block_header_slot(&header)));
 
   // copy data to leafes and gindexes
   memcpy(leafes, block_number.data, block_number.len);
   memcpy(leafes + 32, block_hash.data, block_hash.len);
   memcpy(leafes + 64, receipt_root, 32);
 
-  gindexes[0] = GINDEX_BLOCKUMBER;
-  gindexes[1] = GINDEX_BLOCHASH;
-  gindexes[2] = GINDEX_RECEIPT_ROOT;
+  gindexes[0] = gindex->block_number;
+  gindexes[1] = gindex->block_hash;
+  gindexes[2] = gindex->receipts_root;
 
   for (int i = 0; i < tx_count; i++) {
     ssz_ob_t tx = ssz_at(txs, i);
-    ssz_hash_tree_root(ssz_get(&tx, "transaction"), leafes + 96 + 32 * i);
-    gindexes[3 + i] = GINDEX_TXINDEX_G + ssz_get_uint64(&tx, "transactionIndex");
+    ssz_hash_tree_root(eth_logs_tx_transaction(&tx), leafes + 96 + 32 * i);
+    gindexes[3 + i] = gindex->transactions + ssz_uint64(eth_logs_tx_transaction_index(&tx));
   }
 
   bool merkle_proof_match = ssz_verify_multi_merkle_proof(proof.bytes, bytes(leafes, (3 + tx_count) * 32), gindexes, root_hash);
@@ -52,42 +54,59 @@ static bool verify_merkle_proof(verify_ctx_t* ctx, ssz_ob_t block, bytes32_t rec
   return true;
 }
 
-static bool verify_tx(verify_ctx_t* ctx, ssz_ob_t block, ssz_ob_t tx, bytes32_t receipt_root) {
-  bytes_t   raw_receipt  = {0};
-  bytes32_t root_hash    = {0};
-  uint32_t  log_len      = ssz_len(ctx->data);
-  ssz_ob_t  tidx         = ssz_get(&tx, "transactionIndex");
-  bytes_t   block_hash   = ssz_get(&block, "blockHash").bytes;
-  ssz_ob_t  block_number = ssz_get(&block, "blockNumber");
-
-  // verify receipt proof
-  if (!c4_tx_verify_receipt_proof(ctx, ssz_get(&tx, "proof"), ssz_uint32(tidx), root_hash, &raw_receipt)) RETURN_VERIFY_ERROR(ctx, "invalid receipt proof!");
-  if (bytes_all_zero(bytes(receipt_root, 32)))
-    memcpy(receipt_root, root_hash, 32);
-  else if (memcmp(receipt_root, root_hash, 32) != 0)
-    RETURN_VERIFY_ERROR(ctx, "invalid receipt proof, receipt root mismatch!");
+// verifies the receipts of all txs with the multi proof of the block, which hashes each node of the receipts trie only once.
+static bool verify_receipts(verify_ctx_t* ctx, ssz_ob_t block, bytes32_t receipt_root, bytes_t* receipts) {
+  ssz_ob_t txs      = eth_logs_block_txs(&block);
+  uint32_t tx_count = ssz_len(txs);
+  bytes_t* paths    = calloc(tx_count, sizeof(bytes_t));
+  uint8_t* tmp      = calloc(tx_count, 8);
+  for (uint32_t i = 0; i < tx_count; i++) {
+    ssz_ob_t tx  = ssz_at(txs, i);
+    buffer_t buf = {.data = bytes(tmp + i * 8, 0), .allocated = -8};
+    paths[i]     = c4_eth_create_tx_path(ssz_uint32(eth_logs_tx_transaction_index(&tx)), &buf);
+  }
+  bool valid = patricia_verify_multi(receipt_root, eth_logs_block_receipt_proof(&block), paths, receipts, tx_count);
+  free(paths);
+  free(tmp);
+
+  if (!valid) RETURN_VERIFY_ERROR(ctx, "invalid receipt proof!");
+  for (uint32_t i = 0; i < tx_count; i++) {
+    if (!receipts[i].data) RETURN_VERIFY_ERROR(ctx, "invalid receipt proof, missing receipt!");
+  }
+  return true;
+}
+
+static bool verify_tx(verify_ctx_t* ctx, ssz_ob_t block, ssz_ob_t tx, bytes_t raw_receipt) {
+  uint32_t log_len      = ssz_len(ctx->data);
+  ssz_ob_t tidx         = eth_logs_tx_transaction_index(&tx);
+  bytes_t  block_hash   = eth_logs_block_block_hash(&block).bytes;
+  ssz_ob_t block_number = eth_logs_block_block_number(&block);
 
   for (int i = 0; i < log_len; i++) {
     ssz_ob_t log = ssz_at(ctx->data, i);
-    if (bytes_eq(block_number.bytes, ssz_get(&log, "blockNumber").bytes) && bytes_eq(tidx.bytes, ssz_get(&log, "transactionIndex").bytes)) {
-      if (!c4_tx_verify_log_data(ctx, log, block_hash.data, ssz_uint64(block_number), ssz_uint32(tidx), ssz_get(&tx, "transaction").bytes, raw_receipt)) RETURN_VERIFY_ERROR(ctx, "invalid log data!");
+    if (bytes_eq(block_number.bytes, eth_receipt_data_log_block_number(&log).bytes) && bytes_eq(tidx.bytes, eth_receipt_data_log_transaction_index(&log).bytes)) {
+      if (!c4_tx_verify_log_data(ctx, log, block_hash.data, ssz_uint64(block_number), ssz_uint32(tidx), eth_logs_tx_transaction(&tx).bytes, raw_receipt)) RETURN_VERIFY_ERROR(ctx, "invalid log data!");
     }
   }
   return true;
 }
 
 static bool verif_block(verify_ctx_t* ctx, ssz_ob_t block) {
-  ssz_ob_t  header                   = ssz_get(&block, "header");
-  ssz_ob_t  sync_committee_bits      = ssz_get(&block, "sync_committee_bits");
-  ssz_ob_t  sync_committee_signature = ssz_get(&block, "sync_committee_signature");
-  ssz_ob_t  txs                      = ssz_get(&block, "txs");
+  ssz_ob_t  header                   = eth_logs_block_header(&block);
+  ssz_ob_t  sync_committee_bits      = eth_logs_block_sync_committee_bits(&block);
+  ssz_ob_t  sync_committee_signature = eth_logs_block_sync_committee_signature(&block);
+  ssz_ob_t  txs                      = eth_logs_block_txs(&block);
   bytes32_t receipt_root             = {0};
   uint32_t  tx_count                 = ssz_len(txs);
+  bytes_t*  receipts                 = calloc(tx_count, sizeof(bytes_t));
+  bool      valid                    = verify_receipts(ctx, block, receipt_root, receipts);
 
-  // verify each tx and get the receipt root
-  for (int i = 0; i < tx_count; i++) {
-    if (!verify_tx(ctx, block, ssz_at(txs, i), receipt_root)) RETURN_VERIFY_ERROR(ctx, "invalid receipt proof!");
-  }
+  // verify the logs of each tx against its receipt
+  for (int i = 0; i < tx_count && valid; i++)
+    valid = verify_tx(ctx, block, ssz_at(txs, i), receipts[i]);
+  free(receipts);
+
+  if (!valid) RETURN_VERIFY_ERROR(ctx, "invalid receipt proof!");
   if (!verify_merkle_proof(ctx, block, receipt_root)) RETURN_VERIFY_ERROR(ctx, "invalid tx proof!");
   if (!c4_verify_blockroot_signature(ctx, &header, &sync_committee_bits, &sync_committee_signature, 0)) RETURN_VERIFY_ERROR(ctx, "invalid blockhash signature!");
 
@@ -97,12 +116,12 @@ static bool verif_block(verify_ctx_t* ctx, ssz_ob_t block) {
 static bool has_proof(verify_ctx_t* ctx, bytes_t block_number, bytes_t tx_index, uint32_t block_count) {
   for (int i = 0; i < block_count; i++) {
     ssz_ob_t block = ssz_at(ctx->proof, i);
-    if (bytes_eq(block_number, ssz_get(&block, "blockNumber").bytes)) {
-      ssz_ob_t txs      = ssz_get(&block, "txs");
+    if (bytes_eq(block_number, eth_logs_block_block_number(&block).bytes)) {
+      ssz_ob_t txs      = eth_logs_block_txs(&block);
       uint32_t tx_count = ssz_len(txs);
       for (int j = 0; j < tx_count; j++) {
         ssz_ob_t tx = ssz_at(txs, j);
-        if (bytes_eq(tx_index, ssz_get(&tx, "transactionIndex").bytes))
+        if (bytes_eq(tx_index, eth_logs_tx_transaction_index(&tx).bytes))
           return true;
       }
       return false;
@@ -111,8 +130,7 @@ static bool has_proof(verify_ctx_t* ctx, bytes_t block_number, bytes_t tx_index,
   return false;
 }
 
-bool verify_logs_proof(verify_ctx_t* ctx) {
-
+static bool verify_blocks(verify_ctx_t* ctx) {
   uint32_t log_count   = ssz_len(ctx->data);
   uint32_t block_count = ssz_len(ctx->proof);
 
@@ -124,9 +142,20 @@ bool verify_logs_proof(verify_ctx_t* ctx) {
   // make sure we have a proof for each log
   for (int i = 0; i < log_count; i++) {
     ssz_ob_t log = ssz_at(ctx->data, i);
-    if (!has_proof(ctx, ssz_get(&log, "blockNumber").bytes, ssz_get(&log, "transactionIndex").bytes, block_count)) RETURN_VERIFY_ERROR(ctx, "missing log proof!");
+    if (!has_proof(ctx, eth_receipt_data_log_block_number(&log).bytes, eth_receipt_data_log_transaction_index(&log).bytes, block_count)) RETURN_VERIFY_ERROR(ctx, "missing log proof!");
   }
 
   ctx->success = true;
   return true;
+}
+
+bool verify_logs_proof(verify_ctx_t* ctx) {
+  if (ctx->batch) return verify_blocks(ctx);
+
+  // the signatures of all blocks are verified together
+  c4_signature_batch_t batch = {0};
+  ctx->batch                 = &batch;
+  bool valid                 = verify_blocks(ctx);
+  ctx->batch                 = NULL;
+  return c4_verify_signatures(&batch) && valid;
 }
\ No newline at end of file
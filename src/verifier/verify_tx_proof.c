@@ -15,14 +15,10 @@
 #include <stdlib.h>
 #include <string.h>
 
-#define GINDEX_BLOCKUMBER 806
-#define GINDEX_BLOCHASH   812
-#define GINDEX_TXINDEX_G  1704984576L // gindex of the first tx
-
-static bool verify_merkle_proof(verify_ctx_t* ctx, ssz_ob_t proof, bytes_t block_hash, bytes_t block_number, bytes_t raw, uint32_t tx_index, bytes32_t body_root) {
-  uint8_t   leafes[96] = {0};                                                               // 3 leafes, 32 bytes each
-  bytes32_t root_hash  = {0};                                                               // calculated body root hash
-  gindex_t  gindexes[] = {GINDEX_BLOCKUMBER, GINDEX_BLOCHASH, GINDEX_TXINDEX_G + tx_index}; // calculate the gindexes for the proof
+static bool verify_merkle_proof(verify_ctx_t* ctx, ssz_ob_t proof, const c4_gindexes_t* gindex, bytes_t block_hash, bytes_t block_number, bytes_t raw, uint32_t tx_index, bytes32_t body_root) {
+  uint8_t   leafes[96] = {0};                                                                         // 3 leafes, 32 bytes each
+  bytes32_t root_hash  = {0};                                                                         // calculated body root hash
+  gindex_t  gindexes[] = {gindex->block_number, gindex->block_hash, gindex->transactions + tx_index}; // calculate the gindexes for the proof
 
   // copy leaf data
   memcpy(leafes, block_number.data, block_number.len);
@@ -52,7 +48,7 @@ bool verify_tx_proof(verify_ctx_t* ctx) {
 
   if (!c4_tx_verify_tx_data(ctx, ctx->data, raw.bytes, block_hash.bytes.data, ssz_uint64(block_number))) RETURN_VERIFY_ERROR(ctx, "invalid tx data!");
   if (!c4_tx_verify_tx_hash(ctx, raw.bytes)) RETURN_VERIFY_ERROR(ctx, "invalid tx hash!");
-  if (!verify_merkle_proof(ctx, tx_proof, block_hash.bytes, block_number.bytes, raw.bytes, ssz_uint32(tx_index), body_root.bytes.data)) RETURN_VERIFY_ERROR(ctx, "invalid tx proof!");
+  if (!verify_merkle_proof(ctx, tx_proof, c4_chain_gindexes(ctx->chain_id, ssz_get_uint64(&header, "slot")), block_hash.bytes, block_number.bytes, raw.bytes, ssz_uint32(tx_index), body_root.bytes.data)) RETURN_VERIFY_ERROR(ctx, "invalid tx proof!");
   if (!c4_verify_blockroot_signature(ctx, &header, &sync_committee_bits, &sync_committee_signature, 0)) RETURN_VERIFY_ERROR(ctx, "invalid blockhash signature!");
 
   ctx->success = true;
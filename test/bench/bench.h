@@ -0,0 +1,42 @@
+#ifndef bench_h__
+#define bench_h__
+
+#include "util/bytes.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+// reads a file from the testdata dir or exits
+static inline bytes_t bench_read_testdata(const char* filename) {
+  buffer_t path = {0};
+  bytes_t  data = bytes_read(bprintf(&path, "%s/%s", TESTDATA_DIR, filename));
+  buffer_free(&path);
+  if (!data.data) {
+    fprintf(stderr, "testdata %s not found\n", filename);
+    exit(EXIT_FAILURE);
+  }
+  return data;
+}
+
+static inline double bench_now() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// prints the time per run and the throughput, if bytes is not 0
+static inline void bench_report(const char* name, int runs, double seconds, uint64_t bytes) {
+  if (bytes)
+    printf("%-40s %10.3f us/op %10.2f MB/s\n", name, seconds * 1e6 / runs, (double) bytes * runs / seconds / (1024 * 1024));
+  else
+    printf("%-40s %10.3f us/op\n", name, seconds * 1e6 / runs);
+}
+
+#define BENCH(name, runs, bytes, code)                     \
+  do {                                                     \
+    double _start = bench_now();                           \
+    for (int _i = 0; _i < (runs); _i++) { code; }          \
+    bench_report(name, runs, bench_now() - _start, bytes); \
+  } while (0)
+
+#endif
@@ -0,0 +1,36 @@
+#include "bench.h"
+#include "util/bytes.h"
+#include "util/json.h"
+
+int main(int argc, char* argv[]) {
+  int      runs = argc > 1 ? atoi(argv[1]) : 1000;
+  uint8_t  bloom[256];
+  buffer_t hex = {0};
+  buffer_t out = {0};
+  for (int i = 0; i < 256; i++) bloom[i] = (uint8_t) (i * 31 + 7);
+
+  // a logsBloom as found in every receipt
+  BENCH("hex encode logsBloom", runs * 10, sizeof(bloom), hex.data.len = 0; buffer_add_hex_chars(&hex, bytes(bloom, sizeof(bloom)), "0x", NULL));
+  BENCH("hex decode logsBloom", runs * 10, sizeof(bloom), hex_to_bytes((char*) hex.data.data, hex.data.len, bytes(bloom, sizeof(bloom))));
+  BENCH("bprintf %x logsBloom", runs * 10, sizeof(bloom), hex.data.len = 0; bprintf(&hex, "\"0x%x\"", bytes(bloom, sizeof(bloom))));
+
+  // all logsBlooms of the recorded receipts
+  bytes_t  data = bench_read_testdata("eth_getLogs1/eth_getBlockReceipts_0x14d7970.json");
+  buffer_t text = {0};
+  buffer_append(&text, data);
+  buffer_append(&text, bytes(NULL, 1));
+  json_t   receipts = json_get(json_parse((char*) text.data.data), "result");
+  size_t   len      = json_len(receipts);
+  json_t*  blooms   = calloc(len, sizeof(json_t));
+  uint64_t sum      = 0;
+  for (size_t i = 0; i < len; i++) blooms[i] = json_get(json_at(receipts, i), "logsBloom");
+  BENCH("json_as_bytes logsBloom of receipts", runs, len * 256, for (size_t i = 0; i < len; i++) sum += json_as_bytes(blooms[i], &out).len);
+  if (!sum) printf("invalid receipts\n");
+
+  buffer_free(&hex);
+  buffer_free(&out);
+  free(blooms);
+  buffer_free(&text);
+  free(data.data);
+  return 0;
+}
@@ -0,0 +1,65 @@
+#include "bench.h"
+#include "util/json.h"
+
+// reads all fields used to serialize a receipt
+static uint64_t read_receipts(json_t receipts) {
+  uint64_t sum = 0;
+  for (size_t i = 0, len = json_len(receipts); i < len; i++) {
+    json_t r = json_at(receipts, i);
+    sum += json_get_uint64(r, "type") + json_get_uint64(r, "status") + json_get_uint64(r, "cumulativeGasUsed");
+    sum += json_get(r, "logsBloom").len + json_get(r, "stateRoot").len + json_len(json_get(r, "logs"));
+  }
+  return sum;
+}
+
+// skips over all values of the result without an index
+static uint64_t skip_values(json_t result) {
+  uint64_t sum = 0;
+  json_for_each_value(result, val) {
+    sum += val.len;
+  }
+  return sum;
+}
+
+static char* read_text(const char* name, size_t* len) {
+  bytes_t  data = bench_read_testdata(name);
+  buffer_t text = {0};
+  buffer_append(&text, data);
+  buffer_append(&text, bytes(NULL, 1));
+  *len = data.len;
+  free(data.data);
+  return (char*) text.data.data;
+}
+
+#define RECEIPTS_DEF "[{type:hexuint,status:hexuint,cumulativeGasUsed:hexuint,logs:[{address:address,topics:[bytes32],data:bytes,blockNumber:hexuint,transactionHash:bytes32,transactionIndex:hexuint,blockHash:bytes32,logIndex:hexuint,removed:bool}],logsBloom:bytes,transactionHash:bytes32,transactionIndex:hexuint,blockHash:bytes32,gasUsed:hexuint,effectiveGasPrice:hexuint,from:address,to?:address,contractAddress?:address}]"
+
+int main(int argc, char* argv[]) {
+  int         runs     = argc > 1 ? atoi(argv[1]) : 100;
+  size_t      len      = 0;
+  size_t      logs_len = 0;
+  uint64_t    sum      = 0;
+  const char* json     = read_text("eth_getLogs1/eth_getBlockReceipts_0x14d7970.json", &len);
+  const char* logs     = read_text("eth_getLogs1/eth_getLogs___address____0xdac17f958d2ee523a2206206994597c13d831ec7____fromBlock___0x14d7970___toBlock___0x14d7970__.json", &logs_len);
+
+  printf("json scan backend: %s\n", json_scan_backend());
+  json_index_t* index = NULL;
+  BENCH("json_parse receipts", runs, len, sum += json_parse(json).len);
+  BENCH("json_parse logs", runs, logs_len, sum += json_parse(logs).len);
+  BENCH("skip receipts", runs, len, sum += skip_values(json_get(json_parse(json), "result")));
+  BENCH("skip logs", runs, logs_len, sum += skip_values(json_get(json_parse(logs), "result")));
+  BENCH("json_parse_indexed receipts", runs, len, json_index_free(index); index = NULL; sum += json_parse_indexed(json, len, &index).len);
+  BENCH("read receipts (scanning)", runs, len, sum += read_receipts(json_get(json_parse(json), "result")));
+  BENCH("read receipts (indexed)", runs, len, sum += read_receipts(json_get(json_parse_indexed(json, len, &index), "result")));
+
+  json_t         receipts = json_get(json_parse_indexed(json, len, &index), "result");
+  json_schema_t* schema   = json_schema_compile(RECEIPTS_DEF);
+  BENCH("json_validate receipts", runs, len, sum += !json_validate(receipts, RECEIPTS_DEF, ""));
+  BENCH("json_schema_validate receipts", runs, len, sum += !json_schema_validate(schema, receipts, ""));
+  json_schema_free(schema);
+  json_index_free(index);
+  if (!sum) printf("invalid receipts\n");
+
+  free((void*) json);
+  free((void*) logs);
+  return 0;
+}
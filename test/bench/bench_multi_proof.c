@@ -0,0 +1,61 @@
+#include "bench.h"
+#include "util/crypto.h"
+#include "util/ssz.h"
+
+#define NUM_VALUES 8192
+
+static const ssz_def_t VALUES[] = {
+    SSZ_UINT64("count"),
+    SSZ_LIST("values", ssz_bytes32, NUM_VALUES),
+};
+static const ssz_def_t VALUES_CONTAINER = SSZ_CONTAINER("Values", VALUES);
+
+int main(int argc, char* argv[]) {
+  int      runs = argc > 1 ? atoi(argv[1]) : 20;
+  buffer_t data = {0};
+  buffer_t name = {0};
+
+  // count + offset + values
+  buffer_grow(&data, 12 + NUM_VALUES * 32);
+  data.data.len = 12 + NUM_VALUES * 32;
+  uint64_to_le(data.data.data, NUM_VALUES);
+  uint32_to_le(data.data.data + 8, 12);
+  for (uint32_t i = 0; i < NUM_VALUES; i++) sha256(bytes((uint8_t*) &i, 4), data.data.data + 12 + i * 32);
+
+  ssz_ob_t      ob   = ssz_ob(VALUES_CONTAINER, data.data);
+  ssz_hashed_t* view = ssz_hashed_create(ob);
+  bytes32_t     root = {0};
+  ssz_hashed_root(view, root);
+
+  int leafes_counts[] = {1, 16, 256, 4096};
+  for (int n = 0; n < 4; n++) {
+    int       count  = leafes_counts[n];
+    gindex_t* gindex = malloc(count * sizeof(gindex_t));
+    uint8_t*  leafes = malloc(count * 32);
+    for (int i = 0; i < count; i++) {
+      gindex[i] = ssz_gindex(ob.def, 2, "values", i * (NUM_VALUES / count));
+      ssz_hashed_get(view, gindex[i], leafes + i * 32);
+    }
+
+    bytes_t   proof = ssz_hashed_multi_proof(view, gindex, count);
+    bytes32_t out   = {0};
+    if (!ssz_verify_multi_merkle_proof(proof, bytes(leafes, count * 32), gindex, out) || memcmp(out, root, 32)) {
+      fprintf(stderr, "invalid proof for %d leafes\n", count);
+      return EXIT_FAILURE;
+    }
+
+    buffer_reset(&name);
+    BENCH(bprintf(&name, "create multi proof (%d leafes)", count), runs, 0, free(ssz_hashed_multi_proof(view, gindex, count).data));
+    buffer_reset(&name);
+    BENCH(bprintf(&name, "verify multi proof (%d leafes)", count), runs, 0, ssz_verify_multi_merkle_proof(proof, bytes(leafes, count * 32), gindex, out));
+
+    free(proof.data);
+    free(gindex);
+    free(leafes);
+  }
+
+  ssz_hashed_free(view);
+  buffer_free(&data);
+  buffer_free(&name);
+  return 0;
+}
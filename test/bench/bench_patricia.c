@@ -0,0 +1,130 @@
+#include "bench.h"
+#include "proofer/eth_req.h"
+#include "util/bytes.h"
+#include "util/crypto.h"
+#include "util/json.h"
+#include "util/patricia.h"
+#include <inttypes.h>
+
+static const ssz_def_t PROOF = SSZ_LIST("proof", ssz_bytes_list, 1024);
+
+#ifdef __GLIBC__
+// counts the heap allocations by wrapping the allocator of glibc
+extern void*    __libc_malloc(size_t size);
+extern void*    __libc_calloc(size_t n, size_t size);
+extern void*    __libc_realloc(void* ptr, size_t size);
+static uint64_t allocations = 0;
+void*           malloc(size_t size) { return allocations++, __libc_malloc(size); }
+void*           calloc(size_t n, size_t size) { return allocations++, __libc_calloc(n, size); }
+void*           realloc(void* ptr, size_t size) { return allocations++, __libc_realloc(ptr, size); }
+#define COUNT_ALLOCATIONS(name, code)                                    \
+  do {                                                                   \
+    uint64_t _start = allocations;                                       \
+    code;                                                                \
+    printf("%-40s %10" PRIu64 " allocations\n", name, allocations - _start); \
+  } while (0)
+#else
+#define COUNT_ALLOCATIONS(name, code) code
+#endif
+
+// the account proof of eth_getProof as ssz list
+static int bench_account_proof(int runs) {
+  bytes_t       data    = bench_read_testdata("eth_getBalance1/eth_getProof_0x95222290DD7278Aa3Ddd389Cc1E1d165CC4BAfe5____0x14d0303.json");
+  buffer_t      text    = {0};
+  buffer_t      tmp     = {0};
+  ssz_builder_t builder = {.def = &PROOF};
+  bytes32_t     root    = {0};
+  bytes32_t     path    = {0};
+  buffer_append(&text, data);
+  buffer_append(&text, bytes(NULL, 1));
+
+  json_t result = json_get(json_parse((char*) text.data.data), "result");
+  json_t nodes  = json_get(result, "accountProof");
+  json_for_each_value(nodes, node) ssz_add_dynamic_list_bytes(&builder, json_len(nodes), json_as_bytes(node, &tmp));
+  keccak(json_get_bytes(result, "address", &tmp), path);
+
+  ssz_ob_t proof   = ssz_builder_to_bytes(&builder);
+  bytes_t  key     = bytes(path, 32);
+  bytes_t  account = {0};
+  if (!patricia_verify(root, &key, proof, &account) || !account.data) {
+    fprintf(stderr, "invalid account proof\n");
+    return EXIT_FAILURE;
+  }
+  printf("account proof: %u nodes\n", ssz_len(proof));
+  COUNT_ALLOCATIONS("patricia_verify account proof", patricia_verify(root, &key, proof, &account));
+  BENCH("patricia_verify account proof", runs * 10, 0, account = NULL_BYTES; patricia_verify(root, &key, proof, &account));
+
+  free(proof.bytes.data);
+  buffer_free(&tmp);
+  buffer_free(&text);
+  free(data.data);
+  return 0;
+}
+
+int main(int argc, char* argv[]) {
+  int      runs = argc > 1 ? atoi(argv[1]) : 100;
+  bytes_t  data = bench_read_testdata("eth_getLogs1/eth_getBlockReceipts_0x14d7970.json");
+  buffer_t text = {0};
+  buffer_t rlp  = {0};
+  buffer_append(&text, data);
+  buffer_append(&text, bytes(NULL, 1));
+
+  // the serialized receipts of a block
+  json_t   receipts = json_get(json_parse((char*) text.data.data), "result");
+  uint32_t len      = json_len(receipts);
+  bytes_t* keys     = calloc(len * 2, sizeof(bytes_t));
+  bytes_t* values   = keys + len;
+  for (uint32_t i = 0; i < len; i++) {
+    json_t    receipt = json_at(receipts, i);
+    bytes32_t tmp     = {0};
+    buffer_t  buf     = stack_buffer(tmp);
+    keys[i]           = bytes_dup(c4_eth_create_tx_path(json_get_uint32(receipt, "transactionIndex"), &buf));
+    values[i]         = bytes_dup(c4_serialize_receipt(receipt, &rlp));
+  }
+
+  node_t* a = NULL;
+  node_t* b = patricia_build(keys, values, len);
+  for (uint32_t i = 0; i < len; i++) patricia_set_value(&a, keys[i], values[i]);
+  if (memcmp(patricia_get_root(a).data, patricia_get_root(b).data, 32)) {
+    fprintf(stderr, "invalid receipts root\n");
+    return EXIT_FAILURE;
+  }
+  patricia_node_free(a);
+
+  printf("receipts: %u\n", len);
+  BENCH("c4_serialize_receipt receipts", runs, 0, json_for_each_value(receipts, receipt) c4_serialize_receipt(receipt, &rlp));
+  BENCH("patricia_set_value receipts", runs, 0, a = NULL; for (uint32_t i = 0; i < len; i++) patricia_set_value(&a, keys[i], values[i]); patricia_node_free(a));
+  BENCH("patricia_build receipts", runs, 0, patricia_node_free(patricia_build(keys, values, len)));
+
+  // proofs for all receipts, one per receipt or one for all
+  ssz_ob_t* proofs      = calloc(len, sizeof(ssz_ob_t));
+  bytes_t*  found       = calloc(len, sizeof(bytes_t));
+  ssz_ob_t  multi_proof = patricia_create_multi_proof(b, keys, len);
+  bytes32_t root        = {0};
+  uint32_t  proof_size  = 0;
+  for (uint32_t i = 0; i < len; i++) {
+    proofs[i] = patricia_create_merkle_proof(b, keys[i]);
+    proof_size += proofs[i].bytes.len;
+  }
+  printf("proof size: %u bytes single, %u bytes multi\n", proof_size, multi_proof.bytes.len);
+  COUNT_ALLOCATIONS("patricia_verify all receipts", for (uint32_t i = 0; i < len; i++) patricia_verify(root, keys + i, proofs[i], found + i));
+  BENCH("patricia_verify all receipts", runs, 0, for (uint32_t i = 0; i < len; i++) patricia_verify(root, keys + i, proofs[i], found + i));
+  BENCH("patricia_verify_multi all receipts", runs, 0, patricia_verify_multi(root, multi_proof, keys, found, len));
+
+  for (uint32_t i = 0; i < len; i++) free(proofs[i].bytes.data);
+  free(proofs);
+  free(found);
+  free(multi_proof.bytes.data);
+  patricia_node_free(b);
+  if (bench_account_proof(runs)) return EXIT_FAILURE;
+
+  for (uint32_t i = 0; i < len; i++) {
+    free(keys[i].data);
+    free(values[i].data);
+  }
+  free(keys);
+  buffer_free(&rlp);
+  buffer_free(&text);
+  free(data.data);
+  return 0;
+}
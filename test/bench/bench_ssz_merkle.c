@@ -0,0 +1,40 @@
+#include "bench.h"
+#include "proofer/ssz_types.h"
+#include "util/crypto.h"
+#include "util/ssz.h"
+
+int main(int argc, char* argv[]) {
+  int       runs         = argc > 1 ? atoi(argv[1]) : 200;
+  bytes_t   data         = bench_read_testdata("body.ssz");
+  bytes_t   data2        = bench_read_testdata("body_11038724.ssz");
+  ssz_ob_t  signed_block = ssz_ob(SIGNED_BEACON_BLOCK_CONTAINER, data);
+  ssz_ob_t  block        = ssz_get(&signed_block, "message");
+  ssz_ob_t  body         = ssz_ob(BEACON_BLOCK_BODY_CONTAINER, data2);
+  bytes32_t root         = {0};
+
+  uint8_t* level = calloc(1024, 64);
+  printf("sha256 backend: %s\n", sha256_backend());
+  BENCH("sha256_pairs 1024", runs, 1024 * 64, sha256_pairs(level, 1024, level));
+  free(level);
+
+  BENCH("hash_tree_root body.ssz", runs, block.bytes.len, ssz_hash_tree_root(block, root));
+  BENCH("hash_tree_root body_11038724.ssz", runs, body.bytes.len, ssz_hash_tree_root(body, root));
+
+  gindex_t gindex = ssz_gindex(body.def, 2, "executionPayload", "stateRoot");
+  BENCH("create_proof stateRoot", runs, 0, free(ssz_create_proof(body, root, gindex).data));
+
+  ssz_hashed_t* view = NULL;
+  BENCH("hashed view create", runs, body.bytes.len, ssz_hashed_free(view); view = ssz_hashed_create(body));
+  BENCH("hashed view proof stateRoot", runs * 100, 0, free(ssz_hashed_multi_proof(view, &gindex, 1).data));
+  ssz_hashed_free(view);
+
+  uint64_t number = 0;
+  BENCH("ssz_get executionPayload.blockNumber", runs * 1000, 0, ssz_ob_t payload = ssz_get(&body, "executionPayload"); number += ssz_get_uint64(&payload, "blockNumber"));
+  BENCH("ssz_is_valid body.ssz", runs, signed_block.bytes.len, number += ssz_is_valid(signed_block, true, NULL));
+  BENCH("ssz_is_valid body_11038724.ssz", runs, body.bytes.len, number += ssz_is_valid(body, true, NULL));
+  if (!number) printf("invalid block number\n");
+
+  free(data.data);
+  free(data2.data);
+  return 0;
+}
@@ -119,11 +119,8 @@ static void set_state(chain_id_t chain_id, char* dirname) {
   }
   free(state_content.data);
 }
-static void verify_count(char* dirname, char* method, char* args, chain_id_t chain_id, size_t count) {
-  char tmp[1024];
-
-  set_state(chain_id, dirname);
-
+static proofer_ctx_t* create_proof(char* dirname, char* method, char* args, chain_id_t chain_id) {
+  char    tmp[1024];
   bytes_t proof_data = {0};
 
   // proofer
@@ -138,19 +135,34 @@ static void verify_count(char* dirname, char* method, char* args, chain_id_t cha
           free(filename);
           bytes_t content = read_testdata(tmp);
           TEST_ASSERT_NOT_NULL_MESSAGE(content.data, "Die not find the testdata!");
-          req->response = content;
+          if (req->stream) {
+            // pass streamed responses in chunks like a http client would
+            for (uint32_t i = 0; i < content.len; i += 1000)
+              c4_req_append_response(req, bytes(content.data + i, content.len - i < 1000 ? content.len - i : 1000));
+            c4_req_finish_response(req);
+            free(content.data);
+          }
+          else
+            req->response = content;
         }
         break;
 
       case C4_ERROR:
         TEST_FAIL_MESSAGE(proof_ctx->state.error);
-        return;
+        return NULL;
 
       case C4_SUCCESS:
         proof_data = proof_ctx->proof;
         break;
     }
   }
+  return proof_ctx;
+}
+
+static void verify_count(char* dirname, char* method, char* args, chain_id_t chain_id, size_t count) {
+  set_state(chain_id, dirname);
+  proofer_ctx_t* proof_ctx = create_proof(dirname, method, args, chain_id);
+  if (!proof_ctx) return;
 
   for (int n = 0; n < count; n++) {
     // now verify
@@ -185,3 +197,35 @@ static void verify_count(char* dirname, char* method, char* args, chain_id_t cha
 static void verify(char* dirname, char* method, char* args, chain_id_t chain_id) {
   verify_count(dirname, method, args, chain_id, 1);
 }
+
+// verifies the same proof count times within one batch, after the sync state was set up by a single verification.
+// If invalid is a valid index, the signature of this proof is negated, which is still a valid point, but must fail.
+static void verify_batch(char* dirname, char* method, char* args, chain_id_t chain_id, size_t count, int invalid) {
+  verify(dirname, method, args, chain_id);
+  proofer_ctx_t* proof_ctx = create_proof(dirname, method, args, chain_id);
+  if (!proof_ctx) return;
+
+  bytes_t       corrupted = bytes_dup(proof_ctx->proof);
+  verify_ctx_t* ctxs      = calloc(count, sizeof(verify_ctx_t));
+  for (size_t i = 0; i < count; i++) c4_verify_init(ctxs + i, (int) i == invalid ? corrupted : proof_ctx->proof, method, json_parse(args), chain_id);
+  if (invalid >= 0 && invalid < (int) count) {
+    ssz_ob_t proof     = ctxs[invalid].proof;
+    ssz_ob_t block     = proof.def->type == SSZ_TYPE_LIST ? ssz_at(proof, 0) : proof;
+    ssz_ob_t signature = ssz_get(&block, "sync_committee_signature");
+    TEST_ASSERT_EQUAL_UINT32_MESSAGE(96, signature.bytes.len, "no signature to corrupt");
+    signature.bytes.data[0] ^= 0x20; // flips the sign of the compressed point
+  }
+
+  c4_verify_batch(ctxs, (uint32_t) count);
+  for (size_t i = 0; i < count; i++) {
+    if ((int) i == invalid) {
+      TEST_ASSERT_FALSE_MESSAGE(ctxs[i].success, "the corrupted signature must fail");
+      free(ctxs[i].state.error); // set by c4_verify_signatures
+    }
+    else
+      TEST_ASSERT_TRUE_MESSAGE(ctxs[i].success, ctxs[i].state.error);
+  }
+  free(ctxs);
+  free(corrupted.data);
+  c4_proofer_free(proof_ctx);
+}
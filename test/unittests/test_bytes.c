@@ -0,0 +1,92 @@
+#include "c4_assert.h"
+#include "unity.h"
+#include "util/bytes.h"
+#include "util/json.h"
+#include <ctype.h>
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+// hex conversion of all lengths crossing the 16 bytes of the simd kernels
+void test_hex_roundtrip() {
+  uint8_t data[100];
+  uint8_t decoded[100];
+  char    expected[203];
+  for (int i = 0; i < 100; i++) data[i] = (uint8_t) (i * 37 + 11);
+
+  for (int len = 0; len <= 100; len++) {
+    buffer_t hex = {0};
+    buffer_add_hex_chars(&hex, bytes(data, len), "0x", NULL);
+    sprintf(expected, "0x");
+    for (int i = 0; i < len; i++) sprintf(expected + 2 + i * 2, "%02x", data[i]);
+    TEST_ASSERT_EQUAL_STRING(expected, (char*) hex.data.data);
+
+    memset(decoded, 0, sizeof(decoded));
+    TEST_ASSERT_EQUAL(len, hex_to_bytes((char*) hex.data.data, hex.data.len, bytes(decoded, sizeof(decoded))));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(data, decoded, len);
+
+    // uppercase without prefix
+    for (int i = 0; i < len * 2; i++) expected[i] = (char) toupper(expected[i + 2]);
+    expected[len * 2] = 0;
+    TEST_ASSERT_EQUAL(len, hex_to_bytes(expected, -1, bytes(decoded, sizeof(decoded))));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(data, decoded, len);
+    buffer_free(&hex);
+  }
+}
+
+void test_hex_invalid() {
+  uint8_t     decoded[64];
+  char        hex[131];
+  const char* invalid = "gG/:@`\x80\xff \"";
+  for (int pos = 0; pos < 128; pos++) {
+    for (const char* c = invalid; *c; c++) {
+      for (int i = 0; i < 128; i++) hex[i] = "0123456789abcdefABCDEF"[i % 22];
+      hex[pos] = *c;
+      hex[128] = 0;
+      TEST_ASSERT_EQUAL(-1, hex_to_bytes(hex, -1, bytes(decoded, sizeof(decoded))));
+    }
+  }
+
+  // odd length and too small buffers
+  TEST_ASSERT_EQUAL(2, hex_to_bytes("0x123", -1, bytes(decoded, sizeof(decoded))));
+  TEST_ASSERT_EQUAL_UINT8(0x01, decoded[0]);
+  TEST_ASSERT_EQUAL_UINT8(0x23, decoded[1]);
+  TEST_ASSERT_EQUAL(-1, hex_to_bytes("0xg23", -1, bytes(decoded, sizeof(decoded))));
+  TEST_ASSERT_EQUAL(-1, hex_to_bytes("0x1234", -1, bytes(decoded, 1)));
+  TEST_ASSERT_EQUAL(0, hex_to_bytes("0x", -1, bytes(decoded, sizeof(decoded))));
+}
+
+void test_hex_format() {
+  uint8_t  data[40];
+  buffer_t buf = {0};
+  for (int i = 0; i < 40; i++) data[i] = (uint8_t) i;
+  bprintf(&buf, "\"0x%x\",0x%u", bytes(data, 17), bytes(data, 3));
+  TEST_ASSERT_EQUAL_STRING("\"0x000102030405060708090a0b0c0d0e0f10\",0x102", (char*) buf.data.data);
+
+  buffer_t out  = {0};
+  json_t   json = json_parse("\"0x000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f2021\"");
+  TEST_ASSERT_EQUAL(34, json_as_bytes(json, &out).len);
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(data, out.data.data, 34);
+  TEST_ASSERT_EQUAL(0, json_as_bytes(json_parse("\"0x00010203040506070809x0a0b0c0d0e0f1011\""), &out).len);
+
+  // stack buffers are truncated
+  char     tmp[10];
+  buffer_t stack = stack_buffer(tmp);
+  buffer_add_hex_chars(&stack, bytes(data, 8), NULL, NULL);
+  TEST_ASSERT_EQUAL(10, stack.data.len);
+  TEST_ASSERT_EQUAL_UINT8_ARRAY("0001020304", tmp, 10);
+
+  buffer_free(&buf);
+  buffer_free(&out);
+}
+
+int main(void) {
+  UNITY_BEGIN();
+  RUN_TEST(test_hex_roundtrip);
+  RUN_TEST(test_hex_invalid);
+  RUN_TEST(test_hex_format);
+  return UNITY_END();
+}
@@ -0,0 +1,279 @@
+#include "c4_assert.h"
+#include "unity.h"
+#include "util/json.h"
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+static void assert_same_value(json_t expected, json_t actual) {
+  TEST_ASSERT_EQUAL(expected.type, actual.type);
+  if (expected.type == JSON_TYPE_NOT_FOUND || expected.type == JSON_TYPE_INVALID) return;
+  TEST_ASSERT_EQUAL_PTR(expected.start, actual.start);
+  TEST_ASSERT_EQUAL(expected.len, actual.len);
+}
+
+// compares all values reachable from the indexed value with the values found by scanning the text
+static void assert_same_tree(json_t scanned, json_t indexed) {
+  assert_same_value(scanned, indexed);
+  if (scanned.type == JSON_TYPE_ARRAY) {
+    size_t len = json_len(scanned);
+    TEST_ASSERT_EQUAL(len, json_len(indexed));
+    for (size_t i = 0; i < len; i++) assert_same_tree(json_at(scanned, i), json_at(indexed, i));
+    assert_same_value(json_at(scanned, len), json_at(indexed, len));
+  }
+  else if (scanned.type == JSON_TYPE_OBJECT) {
+    bytes_t name          = NULL_BYTES;
+    bytes_t indexed_name  = NULL_BYTES;
+    char    property[100] = {0};
+    json_t  next          = json_next_value(indexed, &indexed_name, JSON_NEXT_FIRST);
+    json_for_each_property(scanned, val, name) {
+      TEST_ASSERT_EQUAL_PTR(name.data, indexed_name.data);
+      TEST_ASSERT_EQUAL(name.len, indexed_name.len);
+      assert_same_value(val, next);
+      memcpy(property, name.data, name.len < 99 ? name.len : 99);
+      property[name.len < 99 ? name.len : 99] = 0;
+      assert_same_tree(json_get(scanned, property), json_get(indexed, property));
+      next = json_next_value(next, &indexed_name, JSON_NEXT_PROPERTY);
+    }
+    TEST_ASSERT_EQUAL(JSON_TYPE_NOT_FOUND, next.type);
+    assert_same_value(json_get(scanned, "unknown"), json_get(indexed, "unknown"));
+  }
+}
+
+void test_index_values() {
+  const char*   data  = " { \"a\": [1, -2.5e3, \"x\\\"]\", [], {}], \"b\" : {\"c\": true, \"d\": null, \"c\": false}, \"\": \"empty\" } ";
+  json_index_t* index = NULL;
+  json_t        json  = json_parse_indexed(data, strlen(data), &index);
+  TEST_ASSERT_NOT_NULL(index);
+  TEST_ASSERT_EQUAL_PTR(index, json.index);
+  assert_same_tree(json_parse(data), json);
+
+  // the first of duplicate properties wins like when scanning
+  TEST_ASSERT_TRUE(json_as_bool(json_get(json_get(json, "b"), "c")));
+  char* str = json_new_string(json_at(json_get(json, "a"), 2));
+  TEST_ASSERT_EQUAL_STRING("\"x\\\"]\"", str);
+  free(str);
+
+  // the existing index is used without scanning again
+  json_t again = json_parse_indexed(data, strlen(data), &index);
+  TEST_ASSERT_EQUAL_PTR(json.start, again.start);
+  TEST_ASSERT_EQUAL(json.len, again.len);
+  json_index_free(index);
+
+  // invalid json is parsed without an index
+  const char* invalid[] = {"{\"a\":1,}", "[1 2]", "{\"a\" 1}", "[1,{]", "{\"a\":[1}", "tru"};
+  for (int i = 0; i < (int) (sizeof(invalid) / sizeof(invalid[0])); i++) {
+    index = NULL;
+    json  = json_parse_indexed(invalid[i], strlen(invalid[i]), &index);
+    TEST_ASSERT_NULL(index);
+    TEST_ASSERT_NULL(json.index);
+  }
+
+  // the text does not need to be terminated
+  index = NULL;
+  json  = json_parse_indexed("[1,2]xxx", 5, &index);
+  TEST_ASSERT_NOT_NULL(index);
+  TEST_ASSERT_EQUAL(2, json_len(json));
+  json_index_free(index);
+}
+
+void test_index_receipts() {
+  bytes_t data = read_testdata("eth_getLogs1/eth_getBlockReceipts_0x14d7970.json");
+  TEST_ASSERT_NOT_NULL_MESSAGE(data.data, "receipts not found");
+  buffer_t text = {0};
+  buffer_append(&text, data);
+  buffer_append(&text, bytes(NULL, 1));
+  free(data.data);
+
+  json_index_t* index   = NULL;
+  json_t        indexed = json_parse_indexed((char*) text.data.data, text.data.len - 1, &index);
+  TEST_ASSERT_NOT_NULL(index);
+  assert_same_tree(json_parse((char*) text.data.data), indexed);
+  TEST_ASSERT_NULL(json_validate(json_get(indexed, "result"), "[{blockNumber:hexuint,transactionIndex:hexuint,logs:[{address:address,topics:[bytes32]}]}]", "receipts"));
+
+  json_index_free(index);
+  buffer_free(&text);
+}
+
+// strings, escapes and whitespace crossing the boundaries of the simd vectors at every alignment
+void test_scan_boundaries() {
+  char text[256];
+  for (int offset = 0; offset < 64; offset++) {
+    for (int len = 0; len < 100; len++) {
+      char* p = text + offset;
+      int   n = 0;
+      p[n++]  = '{';
+      for (int i = 0; i < offset % 40; i++) p[n++] = i % 3 ? ' ' : '\n';
+      n += sprintf(p + n, "\"a\":\"");
+      int str_start = n - 1;
+      for (int i = 0; i < len; i++) {
+        if (i % 17 == (offset % 17)) {
+          p[n++] = '\\';
+          p[n++] = i % 2 ? '"' : '\\';
+          i++;
+        }
+        else
+          p[n++] = i % 5 ? 'x' : '}';
+      }
+      p[n++] = '"';
+      int str_len = n - str_start;
+      n += sprintf(p + n, ",\t\"b\" : [ 1 , {\"c\":\"]\"} ]}");
+      p[n] = 0;
+
+      json_t json = json_parse(p);
+      TEST_ASSERT_EQUAL(JSON_TYPE_OBJECT, json.type);
+      TEST_ASSERT_EQUAL(n, json.len);
+      TEST_ASSERT_EQUAL(str_len, json_get(json, "a").len);
+      TEST_ASSERT_EQUAL(2, json_len(json_get(json, "b")));
+      TEST_ASSERT_EQUAL_PTR(p + n - 4, json_at(json_get(json, "b"), 1).start + json_at(json_get(json, "b"), 1).len - 1);
+
+      // without terminator
+      json_index_t* index = NULL;
+      p[n]                = '"';
+      json                = json_parse_indexed(p, n, &index);
+      TEST_ASSERT_NOT_NULL(index);
+      TEST_ASSERT_EQUAL(n, json.len);
+      TEST_ASSERT_EQUAL(str_len, json_get(json, "a").len);
+      json_index_free(index);
+
+      // an unterminated string is invalid
+      index = NULL;
+      json  = json_parse_indexed(p, str_start + 1 + len / 2, &index);
+      TEST_ASSERT_NULL(index);
+    }
+  }
+}
+
+// the compiled schemas report the same errors as parsing the definition while validating did
+void test_validate_errors() {
+  const char* cases[][4] = {
+      {"bytes32", "\"0x00\"", "P: ", "P: Expected hex string with fixed size (32) but got 1 bytes"},
+      {"hexuint", "\"0x01\"", "P: ", "P: no leading zeros allowed for uint"},
+      {"blocknumber", "\"earliest\"", "P: ", "P: Expected hex prefixed (0x) string"},
+      {"[address,[bytes32],block]", "[\"0x0000000000000000000000000000000000000001\",[\"0x01\"],\"latest\"]", "A: ", "A:  at elemtent (idx: 1 ) :  at elemtent (idx: 0 ) : Expected hex string with fixed size (32) but got 1 bytes"},
+      {"[address,[bytes32],block]", "[\"0x0000000000000000000000000000000000000001\",[],\"latest\",\"0x1\",\"x\"]", "A: ", "A:  at elemtent (idx: 4 ) : Expected hex prefixed (0x) string"},
+      {"[]", "[1]", "E: ", "E:  at elemtent (idx: 0 ) : Unknown type ]"},
+      {"[{a:bool]", "[]", "E: ", "E: Expected array"},
+      {"{a:bool,b?:[hexuint],c:{d:bytes}}", "{\"a\":true,\"b\":null,\"c\":{\"d\":\"0x\"}}", "O: ", NULL},
+      {"{a:bool,b?:[hexuint],c:{d:bytes}}", "{\"a\":true,\"b\":[\"0x1\",\"0x02\"],\"c\":{\"d\":\"0x\"}}", "O: ", "O: .b:O:  at elemtent (idx: 1 ) : no leading zeros allowed for uint"},
+      {"{a:bool,b?:[hexuint],c:{d:bytes}}", "{\"a\":true,\"c\":{\"d\":1}}", "O: ", "O: .c:O: .d:O: Expected hex string"},
+      {"{a:bool,b?:[hexuint],c:{d:bytes}}", "{\"a\":true}", "O: ", "O: missing property c"},
+      {"{ a : bool , b : foo }", "{\"a\":false,\"b\":1}", "O: ", "O: .b:O: Unknown type foo }"},
+      {"{a:bool,b bool}", "{\"a\":false,\"b\":1}", "O: ", "O: Expected in def :"},
+      {"{a:bool,b bool}", "{\"a\":1}", "O: ", "O: .a:Expected boolean"},
+      {"[{a:[{b:bytes32}]}]", "[{\"a\":[]},{\"a\":[{\"b\":\"0x1\"}]}]", NULL, " at elemtent (idx: 1 ) : .a: at elemtent (idx: 0 ) : .b:Expected hex string with fixed size (32) but got 0 bytes"},
+  };
+  for (int i = 0; i < (int) (sizeof(cases) / sizeof(cases[0])); i++) {
+    json_t         val    = json_parse(cases[i][1]);
+    json_schema_t* schema = json_schema_compile(cases[i][0]);
+    for (int n = 0; n < 2; n++) {
+      char* err = (char*) (n ? json_validate(val, cases[i][0], cases[i][2]) : json_schema_validate(schema, val, cases[i][2]));
+      if (cases[i][3])
+        TEST_ASSERT_EQUAL_STRING(cases[i][3], err ? err : "");
+      else
+        TEST_ASSERT_NULL(err);
+      free(err);
+    }
+    json_schema_free(schema);
+  }
+}
+
+void test_schema_cached() {
+  static json_schema_t* slot   = NULL;
+  const json_schema_t*  schema = json_schema_cached(&slot, "{a:bool}");
+  TEST_ASSERT_EQUAL_PTR(slot, schema);
+  TEST_ASSERT_EQUAL_PTR(schema, json_schema_cached(&slot, "{a:bool}"));
+  char* err = (char*) json_schema_validate(schema, json_parse("{\"a\":1}"), "O: ");
+  TEST_ASSERT_EQUAL_STRING("O: .a:Expected boolean", err);
+  free(err);
+
+  // freeing the cache resets the slot, so the next call compiles it again
+  json_schema_cache_free();
+  TEST_ASSERT_NULL(slot);
+  TEST_ASSERT_NULL(json_schema_validate(json_schema_cached(&slot, "{a:bool}"), json_parse("{\"a\":true}"), "O: "));
+  json_schema_cache_free();
+}
+
+typedef struct {
+  buffer_t values; // all values joined by a newline
+  int      count;
+} stream_values_t;
+
+static void collect_value(void* ctx, json_t value) {
+  stream_values_t* values = (stream_values_t*) ctx;
+  buffer_append(&values->values, bytes((uint8_t*) value.start, value.len));
+  buffer_add_chars(&values->values, "\n");
+  values->count++;
+}
+
+// streams the text in chunks of the given size and returns the remaining text
+static char* stream_chunks(const char* text, size_t len, size_t chunk, stream_values_t* values) {
+  json_stream_t stream = {.property = "result", .on_value = collect_value, .ctx = values};
+  for (size_t i = 0; i < len; i += chunk)
+    json_stream_append(&stream, text + i, len - i < chunk ? len - i : chunk);
+  buffer_add_chars(&stream.text, "");
+  buffer_free(&stream.value);
+  return (char*) stream.text.data.data;
+}
+
+void test_stream_values() {
+  const char* text = "{\"id\":1,\"error\":{\"result\":[7]}, \"result\" : [1, \"a\\\"],\" ,[2,[3]],{\"x\":\"]\"}, true ,null,-1.5e3],\"x\":[5]}";
+  for (size_t chunk = 1; chunk <= strlen(text); chunk++) {
+    stream_values_t values = {0};
+    char*           rest   = stream_chunks(text, strlen(text), chunk, &values);
+    TEST_ASSERT_EQUAL(7, values.count);
+    TEST_ASSERT_EQUAL_STRING("1\n\"a\\\"],\"\n[2,[3]]\n{\"x\":\"]\"}\ntrue\nnull\n-1.5e3\n", (char*) values.values.data.data);
+    json_t json = json_parse(rest);
+    TEST_ASSERT_EQUAL(JSON_TYPE_OBJECT, json.type);
+    TEST_ASSERT_EQUAL(0, json_len(json_get(json, "result")));
+    TEST_ASSERT_EQUAL(1, json_len(json_get(json_get(json, "error"), "result")));
+    TEST_ASSERT_EQUAL(1, json_len(json_get(json, "x")));
+    free(rest);
+    buffer_free(&values.values);
+  }
+}
+
+void test_stream_receipts() {
+  bytes_t data = read_testdata("eth_getLogs1/eth_getBlockReceipts_0x14d7970.json");
+  TEST_ASSERT_NOT_NULL_MESSAGE(data.data, "receipts not found");
+  buffer_t text = {0};
+  buffer_append(&text, data);
+  buffer_append(&text, bytes(NULL, 1));
+  free(data.data);
+  json_t   receipts = json_get(json_parse((char*) text.data.data), "result");
+  buffer_t expected = {0};
+  json_for_each_value(receipts, r) {
+    buffer_append(&expected, bytes((uint8_t*) r.start, r.len));
+    buffer_add_chars(&expected, "\n");
+  }
+
+  size_t chunks[] = {1, 100, 1000, 16384, text.data.len};
+  for (int i = 0; i < 5; i++) {
+    stream_values_t values = {0};
+    char*           rest   = stream_chunks((char*) text.data.data, text.data.len - 1, chunks[i], &values);
+    TEST_ASSERT_EQUAL(json_len(receipts), values.count);
+    TEST_ASSERT_EQUAL(expected.data.len, values.values.data.len);
+    TEST_ASSERT_TRUE(memcmp(expected.data.data, values.values.data.data, expected.data.len) == 0);
+    TEST_ASSERT_TRUE(strlen(rest) < 100);
+    TEST_ASSERT_EQUAL(0, json_len(json_get(json_parse(rest), "result")));
+    free(rest);
+    buffer_free(&values.values);
+  }
+  buffer_free(&expected);
+  buffer_free(&text);
+}
+
+int main(void) {
+  UNITY_BEGIN();
+  RUN_TEST(test_index_values);
+  RUN_TEST(test_index_receipts);
+  RUN_TEST(test_scan_boundaries);
+  RUN_TEST(test_validate_errors);
+  RUN_TEST(test_schema_cached);
+  RUN_TEST(test_stream_values);
+  RUN_TEST(test_stream_receipts);
+  return UNITY_END();
+}
@@ -64,18 +64,25 @@ static void run_test(const char* file, const char* testname) {
     json_get_bytes(test, "root", &buffer_root);
 
     // create
-    node_t* root = NULL;
+    node_t*  root       = NULL;
+    bytes_t  keys[64]   = {0};
+    bytes_t  values[64] = {0};
+    uint32_t len        = 0;
     if (in.type == JSON_TYPE_ARRAY) {
       json_for_each_value(in, item) {
         bytes_t key   = as_bytes(item, 0, &tmp1);
         bytes_t value = as_bytes(item, 1, &tmp2);
         patricia_set_value(&root, key, value);
+        keys[len]     = bytes_dup(key);
+        values[len++] = bytes_dup(value);
       }
     }
     else {
       json_for_each_property(in, item, name) {
         bytes_t value = as_bytes(item, -1, &tmp2);
         patricia_set_value(&root, name, value);
+        keys[len]     = bytes_dup(name);
+        values[len++] = bytes_dup(value);
       }
     }
     bytes_t root_hash = patricia_get_root(root);
@@ -84,6 +91,15 @@ static void run_test(const char* file, const char* testname) {
     //    patricia_dump(root);
     // printf("result: %d\n", memcmp(expected_root, root_hash.data, 32));
     patricia_node_free(root);
+
+    // the bulk builder must create the same trie
+    root = patricia_build(keys, values, len);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY_MESSAGE(expected_root, patricia_get_root(root).data, 32, "invalid root of bulk build");
+    patricia_node_free(root);
+    for (uint32_t i = 0; i < len; i++) {
+      free(keys[i].data);
+      free(values[i].data);
+    }
   }
 
   buffer_free(&tmp1);
@@ -128,6 +144,75 @@ void test_receipt_tree() {
   free((void*) block.start);
 }
 
+void test_multi_proof() {
+  json_t    receipts = read_test("block_receipts.json");
+  json_t    block    = read_test("block.json");
+  uint32_t  len      = json_len(receipts);
+  bytes_t*  keys     = calloc(len * 2, sizeof(bytes_t));
+  bytes_t*  values   = keys + len;
+  buffer_t  rlp      = {0};
+  bytes32_t root     = {0};
+  bytes32_t tmp      = {0};
+  buffer_t  buf      = stack_buffer(tmp);
+  for (uint32_t i = 0; i < len; i++) {
+    json_t r  = json_at(receipts, i);
+    keys[i]   = bytes_dup(c4_eth_create_tx_path(json_get_uint32(r, "transactionIndex"), &buf));
+    values[i] = bytes_dup(c4_serialize_receipt(r, &rlp));
+  }
+  node_t* trie          = patricia_build(keys, values, len);
+  bytes_t expected_root = json_get_bytes(block, "receiptsRoot", &buf);
+
+  // unsorted paths with a duplicate and one index not in the block
+  uint8_t  unknown[]    = {0x82, 0x10, 0x00};
+  bytes_t  paths[5]     = {keys[len - 1], keys[3], keys[0], keys[3], bytes(unknown, sizeof(unknown))};
+  bytes_t  found[5]     = {0};
+  ssz_ob_t proof        = patricia_create_multi_proof(trie, paths, 5);
+  uint32_t single_nodes = 0;
+  for (int i = 0; i < 5; i++) {
+    ssz_ob_t single = patricia_create_merkle_proof(trie, paths[i]);
+    single_nodes += ssz_len(single);
+    free(single.bytes.data);
+  }
+  TEST_ASSERT_TRUE_MESSAGE(ssz_len(proof) < single_nodes, "nodes must be shared");
+  TEST_ASSERT_TRUE_MESSAGE(patricia_verify_multi(root, proof, paths, found, 5), "invalid multi proof");
+  TEST_ASSERT_EQUAL_UINT8_ARRAY_MESSAGE(expected_root.data, root, 32, "invalid root");
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(values[len - 1].data, found[0].data, values[len - 1].len);
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(values[3].data, found[1].data, values[3].len);
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(values[0].data, found[2].data, values[0].len);
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(values[3].data, found[3].data, values[3].len);
+  TEST_ASSERT_NULL(found[4].data);
+
+  // a proof without the nodes of a path must fail
+  uint8_t index[] = {0x05};
+  bytes_t missing = bytes(index, 1);
+  TEST_ASSERT_FALSE_MESSAGE(patricia_verify_multi(root, proof, &missing, found, 1), "missing nodes must fail");
+
+  // single proofs for an existing and a missing path
+  ssz_ob_t single = patricia_create_merkle_proof(trie, keys[3]);
+  bytes_t  value  = NULL_BYTES;
+  TEST_ASSERT_TRUE_MESSAGE(patricia_verify(root, keys + 3, single, &value), "invalid proof");
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(values[3].data, value.data, values[3].len);
+  TEST_ASSERT_TRUE_MESSAGE(patricia_verify(root, keys + 3, single, values + 3), "value must match");
+  TEST_ASSERT_FALSE_MESSAGE(patricia_verify(root, keys + 3, single, values + 4), "other value must fail");
+  TEST_ASSERT_FALSE_MESSAGE(patricia_verify(root, keys + 3, single, NULL), "existing path is no proof of absence");
+  TEST_ASSERT_FALSE_MESSAGE(patricia_verify(root, &missing, single, NULL), "incomplete proof must fail");
+  free(single.bytes.data);
+  single = patricia_create_merkle_proof(trie, paths[4]);
+  TEST_ASSERT_TRUE_MESSAGE(patricia_verify(root, paths + 4, single, NULL), "invalid proof of absence");
+  free(single.bytes.data);
+
+  free(proof.bytes.data);
+  patricia_node_free(trie);
+  for (uint32_t i = 0; i < len; i++) {
+    free(keys[i].data);
+    free(values[i].data);
+  }
+  free(keys);
+  buffer_free(&rlp);
+  free((void*) receipts.start);
+  free((void*) block.start);
+}
+
 void test_basic() {
   run_test("trietest.json", "insert-middle-leaf");
   run_test("trietest.json", "branch-value-update");
@@ -137,9 +222,17 @@ void test_basic() {
   // run_test("trieanyorder.json", "singleItem");
 }
 
+void test_bulk_build() {
+  run_test("trietest.json", "insert-middle-leaf");
+  run_test("trietest.json", "branch-value-update");
+  run_test("trieanyorder.json", NULL);
+}
+
 int main(void) {
   UNITY_BEGIN();
   RUN_TEST(test_receipt_tree);
+  RUN_TEST(test_bulk_build);
+  RUN_TEST(test_multi_proof);
   //  RUN_TEST(test_basic);
   return UNITY_END();
 }
\ No newline at end of file
@@ -0,0 +1,119 @@
+#include "c4_assert.h"
+#include "unity.h"
+#include "util/bytes.h"
+#include "util/rlp.h"
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+// a list with short, long and nested items
+static bytes_t create_list(buffer_t* buf) {
+  uint8_t  data[300];
+  buffer_t nested = {0};
+  for (int i = 0; i < 300; i++) data[i] = (uint8_t) i;
+  rlp_add_uint64(&nested, 1);
+  rlp_add_item(&nested, bytes(data, 3));
+
+  rlp_add_item(buf, bytes(data + 5, 1)); // single byte
+  rlp_add_item(buf, NULL_BYTES);
+  rlp_add_item(buf, bytes(data, 55));
+  rlp_add_item(buf, bytes(data, 300));
+  rlp_add_list(buf, nested.data);
+  rlp_add_uint64(buf, 0x1234);
+  rlp_to_list(buf);
+  buffer_free(&nested);
+  return buf->data;
+}
+
+void test_decode_list() {
+  buffer_t   buf  = {0};
+  bytes_t    list = create_list(&buf);
+  bytes_t    item = {0};
+  rlp_item_t items[6];
+  TEST_ASSERT_EQUAL(RLP_LIST, rlp_decode(&list, 0, &list));
+  TEST_ASSERT_EQUAL(6, rlp_decode(&list, -1, NULL));
+  TEST_ASSERT_EQUAL(6, rlp_decode_list(list, items, 6));
+  TEST_ASSERT_EQUAL(RLP_OUT_OF_RANGE, rlp_decode_list(list, items, 5));
+
+  // the table, the iterator and the index access must return the same items
+  bytes_t iter = list;
+  for (int i = 0; i < 6; i++) {
+    TEST_ASSERT_EQUAL(items[i].type, rlp_decode(&list, i, &item));
+    TEST_ASSERT_TRUE(items[i].data.data == item.data && items[i].data.len == item.len);
+    TEST_ASSERT_EQUAL(items[i].type, rlp_next(&iter, &item));
+    TEST_ASSERT_TRUE(items[i].data.data == item.data && items[i].data.len == item.len);
+  }
+  TEST_ASSERT_EQUAL(RLP_NOT_FOUND, rlp_next(&iter, &item));
+  TEST_ASSERT_EQUAL(RLP_NOT_FOUND, rlp_decode(&list, 6, &item));
+
+  TEST_ASSERT_EQUAL_UINT32(1, items[1].type == RLP_ITEM && items[1].data.len == 0);
+  TEST_ASSERT_EQUAL_UINT32(300, items[3].data.len);
+  TEST_ASSERT_EQUAL(RLP_LIST, items[4].type);
+  TEST_ASSERT_EQUAL_UINT64(0x1234, rlp_get_uint64(list, 5));
+  buffer_free(&buf);
+}
+
+void test_decode_invalid() {
+  uint8_t    short_item[] = {0x83, 1, 2};        // 3 bytes announced, 2 given
+  uint8_t    long_item[]  = {0xb9, 0x01};        // length of the length is missing
+  uint8_t    long_list[]  = {0xf8, 0x40, 1, 2};  // list of 64 bytes with only 2
+  uint8_t    valid[]      = {0x01, 0x82, 5, 6};  // two items
+  bytes_t    item         = {0};
+  rlp_item_t items[4];
+
+  bytes_t data = bytes(short_item, sizeof(short_item));
+  TEST_ASSERT_EQUAL(RLP_OUT_OF_RANGE, rlp_next(&data, &item));
+  TEST_ASSERT_EQUAL(RLP_OUT_OF_RANGE, rlp_decode(&data, 0, &item));
+  TEST_ASSERT_EQUAL(RLP_OUT_OF_RANGE, rlp_decode(&data, -1, NULL));
+  TEST_ASSERT_EQUAL(RLP_OUT_OF_RANGE, rlp_decode_list(data, items, 4));
+
+  data = bytes(long_item, sizeof(long_item));
+  TEST_ASSERT_EQUAL(RLP_OUT_OF_RANGE, rlp_next(&data, &item));
+  data = bytes(long_list, sizeof(long_list));
+  TEST_ASSERT_EQUAL(RLP_OUT_OF_RANGE, rlp_decode(&data, 0, &item));
+
+  data = bytes(valid, sizeof(valid));
+  TEST_ASSERT_EQUAL(2, rlp_decode_list(data, items, 4));
+  TEST_ASSERT_EQUAL(RLP_OUT_OF_RANGE, rlp_decode(&data, 1, NULL));
+  TEST_ASSERT_EQUAL(RLP_ITEM, rlp_next(&data, NULL));
+  TEST_ASSERT_EQUAL_UINT32(3, data.len);
+}
+
+void test_encode_with_header() {
+  uint8_t  data[300];
+  buffer_t list   = {0};
+  buffer_t direct = {0};
+  for (int i = 0; i < 300; i++) data[i] = (uint8_t) (i + 1);
+
+  // the same list once moved behind its header and once written with the precomputed length
+  for (uint32_t len = 0; len < 300; len += 7) {
+    uint32_t payload = rlp_item_len(bytes(data, 1)) + rlp_item_len(bytes(data + 200, 1)) + rlp_item_len(bytes(data, len));
+    buffer_reset(&list);
+    buffer_reset(&direct);
+    rlp_add_item(&list, bytes(data, 1));
+    rlp_add_item(&list, bytes(data + 200, 1));
+    rlp_add_item(&list, bytes(data, len));
+    rlp_to_list(&list);
+
+    rlp_add_list_header(&direct, payload);
+    rlp_add_item(&direct, bytes(data, 1));
+    rlp_add_item(&direct, bytes(data + 200, 1));
+    rlp_add_item(&direct, bytes(data, len));
+    TEST_ASSERT_EQUAL_UINT32(rlp_list_len(payload), direct.data.len);
+    TEST_ASSERT_EQUAL_UINT32(list.data.len, direct.data.len);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(list.data.data, direct.data.data, list.data.len);
+  }
+  buffer_free(&list);
+  buffer_free(&direct);
+}
+
+int main(void) {
+  UNITY_BEGIN();
+  RUN_TEST(test_decode_list);
+  RUN_TEST(test_decode_invalid);
+  RUN_TEST(test_encode_with_header);
+  return UNITY_END();
+}
@@ -3,6 +3,10 @@
 #include "unity.h"
 #include "util/bytes.h"
 #include "util/ssz.h"
+#include "util/zero_hashes.h"
+#include "verifier/types_beacon.h"
+#include "verifier/types_fields.h"
+#include "verifier/types_verify.h"
 void setUp(void) {
   // Initialisierung vor jedem Test (falls erforderlich)
 }
@@ -54,14 +58,14 @@ void test_hash_root() {
 
   ssz_def_t TEST_ROOT[] = {
       SSZ_UINT8("count"),
-      SSZ_CONTAINER("sub", TEST_SUB),
+      SSZ_LOCAL_CONTAINER("sub", TEST_SUB),
   };
 
   TEST_ASSERT_EQUAL(7, ssz_add_gindex(3, 3));
   TEST_ASSERT_EQUAL(4, ssz_add_gindex(2, 2));
   TEST_ASSERT_EQUAL(14, ssz_add_gindex(7, 2));
 
-  ssz_def_t TEST_TYPE_CONTAINER = SSZ_CONTAINER("TEST_ROOT", TEST_ROOT);
+  ssz_def_t TEST_TYPE_CONTAINER = SSZ_LOCAL_CONTAINER("TEST_ROOT", TEST_ROOT);
   uint8_t   ssz_data[]          = {1, 2, 3, 4};
   bytes32_t root                = {0};
   ssz_ob_t  res                 = ssz_ob(TEST_TYPE_CONTAINER, bytes(ssz_data, sizeof(ssz_data)));
@@ -119,10 +123,330 @@ void test_hash_body() {
   free(data.data);
 }
 
+void test_hash_lists() {
+  ssz_def_t TEST_LISTS[] = {
+      SSZ_UINT8("a"),
+      SSZ_BYTES("data", 1024),
+      SSZ_BYTES("empty", 1024),
+      SSZ_LIST("values", ssz_uint8, 64),
+  };
+  ssz_def_t TEST_LISTS_CONTAINER = SSZ_LOCAL_CONTAINER("TEST_LISTS", TEST_LISTS);
+
+  // 70 bytes of data, so the packed list has an odd number of chunks with the last one only partially used
+  uint8_t ssz_data[1 + 3 * 4 + 70 + 3] = {0};
+  ssz_data[0]                          = 1;
+  uint32_to_le(ssz_data + 1, 13);
+  uint32_to_le(ssz_data + 5, 83);
+  uint32_to_le(ssz_data + 9, 83);
+  for (int i = 13; i < (int) sizeof(ssz_data); i++) ssz_data[i] = (uint8_t) i;
+  ssz_ob_t res = ssz_ob(TEST_LISTS_CONTAINER, bytes(ssz_data, sizeof(ssz_data)));
+
+  // the proof is created by visiting every node, which must result in the same root as the level-order hashing
+  bytes32_t root       = {0};
+  bytes32_t proof_root = {0};
+  ssz_hash_tree_root(res, root);
+  bytes_t proof = ssz_create_proof(res, proof_root, ssz_gindex(res.def, 1, "a"));
+  free(proof.data);
+  TEST_ASSERT_EQUAL_UINT8_ARRAY_MESSAGE(proof_root, root, 32, "level-order root must match the recursive root");
+}
+
+void test_hashed_view() {
+  bytes_t data = read_testdata("body_11038724.ssz");
+  TEST_ASSERT_NOT_NULL_MESSAGE(data.data, "body_11038724.ssz not found");
+  ssz_ob_t      body = ssz_ob(BEACON_BLOCK_BODY_CONTAINER, data);
+  ssz_hashed_t* view = ssz_hashed_create(body);
+  bytes32_t     root = {0};
+  ssz_hashed_root(view, root);
+  ASSERT_HEX_STRING_EQUAL("ef0d785cb18cb409d4ec8ae1a2f815542b66425716623b16192389e38af32ba7", root, 32, "invalid root of the hashed view");
+
+  // the view must create the same proofs as hashing the whole body
+  gindex_t gindex[] = {
+      ssz_gindex(body.def, 2, "executionPayload", "blockNumber"),
+      ssz_gindex(body.def, 2, "executionPayload", "blockHash"),
+      ssz_gindex(body.def, 2, "executionPayload", "receiptsRoot"),
+      ssz_gindex(body.def, 3, "executionPayload", "transactions", 0),
+      ssz_gindex(body.def, 3, "executionPayload", "transactions", 5)};
+  for (int n = 1; n <= 5; n++) {
+    bytes32_t expected_root = {0};
+    bytes_t   expected      = ssz_create_multi_proof_for_gindexes(body, expected_root, gindex + 5 - n, n);
+    bytes_t   proof         = ssz_hashed_multi_proof(view, gindex + 5 - n, n);
+    TEST_ASSERT_EQUAL_MESSAGE(expected.len, proof.len, "invalid proof length");
+    TEST_ASSERT_EQUAL_UINT8_ARRAY_MESSAGE(expected.data, proof.data, proof.len, "proof of the hashed view differs");
+    free(expected.data);
+    free(proof.data);
+  }
+
+  ssz_hashed_free(view);
+  free(data.data);
+}
+
+void test_layout() {
+  const ssz_def_t*    payload = BEACON_BLOCK_BODY_CONTAINER.def.container.elements + 9;
+  const ssz_layout_t* layout  = ssz_layout(payload);
+  TEST_ASSERT_NOT_NULL_MESSAGE(layout, "no layout for the executionPayload");
+  TEST_ASSERT_TRUE(layout->dynamic);
+  TEST_ASSERT_EQUAL_UINT32(528, layout->fixed_length);
+  TEST_ASSERT_EQUAL_UINT32(404, layout->fields[6].offset);  // blockNumber
+  TEST_ASSERT_EQUAL_UINT32(436, layout->fields[10].offset); // extraData
+  TEST_ASSERT_EQUAL_UINT32(504, layout->fields[10].next_offset);
+  // withdrawals is the last dynamic field
+  TEST_ASSERT_EQUAL_UINT32(0, layout->fields[14].next_offset);
+  TEST_ASSERT_NULL(ssz_layout(&ssz_bytes32));
+
+  // static definitions are cached and looked up by their address
+  TEST_ASSERT_EQUAL_PTR(layout, ssz_layout(payload));
+
+  // local definitions are not cached, since a later definition may reuse their address
+  ssz_def_t       fields[2] = {SSZ_UINT64("a"), SSZ_UINT64("b")};
+  const ssz_def_t container = SSZ_LOCAL_CONTAINER("local", fields);
+  ssz_layout_t*   owned     = NULL;
+  TEST_ASSERT_NULL(ssz_layout(&container));
+  TEST_ASSERT_EQUAL_UINT32(8, ssz_layout_of(&container, &owned)->fields[1].offset);
+  TEST_ASSERT_NOT_NULL(owned);
+  free(owned);
+  fields[0] = (ssz_def_t) SSZ_BYTES32("a");
+  TEST_ASSERT_EQUAL_UINT32(32, ssz_layout_of(&container, &owned)->fields[1].offset);
+  free(owned);
+  TEST_ASSERT_EQUAL_PTR(layout, ssz_layout_of(payload, &owned));
+  TEST_ASSERT_NULL(owned);
+
+  bytes_t data = read_testdata("body_11038724.ssz");
+  TEST_ASSERT_NOT_NULL_MESSAGE(data.data, "body_11038724.ssz not found");
+  ssz_ob_t body = ssz_ob(BEACON_BLOCK_BODY_CONTAINER, data);
+  TEST_ASSERT_TRUE_MESSAGE(ssz_is_valid(body, true, NULL), "body must be valid");
+  ssz_ob_t exec = ssz_get(&body, "executionPayload");
+  TEST_ASSERT_EQUAL_UINT64(21824259, ssz_get_uint64(&exec, "blockNumber"));
+  TEST_ASSERT_NULL(ssz_get(&exec, "unknown").def);
+
+  // an offset pointing into the fixed part must be rejected
+  uint32_t offset = uint32_from_le(exec.bytes.data + 436);
+  uint32_to_le(exec.bytes.data + 436, 400);
+  TEST_ASSERT_FALSE(ssz_is_valid(body, true, NULL));
+  uint32_to_le(exec.bytes.data + 436, offset);
+  free(data.data);
+}
+
+void test_field_accessors() {
+  uint8_t data[112];
+  for (int i = 0; i < (int) sizeof(data); i++) data[i] = (uint8_t) i;
+  ssz_ob_t header = ssz_ob(BEACON_BLOCKHEADER_CONTAINER, bytes(data, sizeof(data)));
+
+  // the generated accessors must return the same as the lookup by name
+  struct {
+    const char* name;
+    ssz_ob_t (*get)(ssz_ob_t*);
+  } fields[] = {
+      {"slot", beacon_block_header_slot},
+      {"proposerIndex", beacon_block_header_proposer_index},
+      {"parentRoot", beacon_block_header_parent_root},
+      {"stateRoot", beacon_block_header_state_root},
+      {"bodyRoot", beacon_block_header_body_root}};
+  for (int i = 0; i < 5; i++) {
+    ssz_ob_t expected = ssz_get(&header, fields[i].name);
+    ssz_ob_t field    = fields[i].get(&header);
+    TEST_ASSERT_EQUAL_PTR(expected.def, field.def);
+    TEST_ASSERT_EQUAL_PTR(expected.bytes.data, field.bytes.data);
+    TEST_ASSERT_EQUAL_UINT32(expected.bytes.len, field.bytes.len);
+  }
+
+  // a different container or a too short object must not be read
+  ssz_ob_t other = ssz_ob(ETH_STATE_PROOF_CONTAINER, bytes(data, sizeof(data)));
+  TEST_ASSERT_NULL(beacon_block_header_slot(&other).bytes.data);
+  header.bytes.len = 100;
+  TEST_ASSERT_NULL(beacon_block_header_body_root(&header).bytes.data);
+}
+
+void test_fork_gindexes() {
+  // the deneb table must match the gindexes of the body definition used by the proofer
+  const ssz_def_t*     body   = &BEACON_BLOCK_BODY_CONTAINER;
+  const c4_gindexes_t* gindex = c4_fork_gindexes(C4_FORK_DENEB);
+  TEST_ASSERT_EQUAL_UINT64(ssz_gindex(body, 2, "executionPayload", "stateRoot"), gindex->state_root);
+  TEST_ASSERT_EQUAL_UINT64(ssz_gindex(body, 2, "executionPayload", "receiptsRoot"), gindex->receipts_root);
+  TEST_ASSERT_EQUAL_UINT64(ssz_gindex(body, 2, "executionPayload", "blockNumber"), gindex->block_number);
+  TEST_ASSERT_EQUAL_UINT64(ssz_gindex(body, 2, "executionPayload", "blockHash"), gindex->block_hash);
+  TEST_ASSERT_EQUAL_UINT64(ssz_gindex(body, 3, "executionPayload", "transactions", 0), gindex->transactions);
+  TEST_ASSERT_EQUAL_UINT64(55, gindex->next_sync_committee);
+
+  // capella has a smaller execution payload and electra a bigger state
+  TEST_ASSERT_EQUAL_UINT64(402, c4_fork_gindexes(C4_FORK_CAPELLA)->state_root);
+  TEST_ASSERT_EQUAL_UINT64(802, c4_fork_gindexes(C4_FORK_ELECTRA)->state_root);
+  TEST_ASSERT_EQUAL_UINT64(87, c4_fork_gindexes(C4_FORK_ELECTRA)->next_sync_committee);
+  TEST_ASSERT_EQUAL_PTR(c4_fork_gindexes(C4_FORK_CAPELLA), c4_chain_gindexes(C4_CHAIN_MAINNET, 194048 * 32));
+  TEST_ASSERT_EQUAL_PTR(c4_fork_gindexes(C4_FORK_DENEB), c4_chain_gindexes(C4_CHAIN_MAINNET, 269568 * 32));
+}
+
+void test_validate() {
+  bytes_t data = read_testdata("body.ssz");
+  TEST_ASSERT_NOT_NULL_MESSAGE(data.data, "body.ssz not found");
+  TEST_ASSERT_TRUE(ssz_is_valid(ssz_ob(SIGNED_BEACON_BLOCK_CONTAINER, data), true, NULL));
+  free(data.data);
+
+  // the values of booleans within a list must be checked
+  const ssz_def_t bools   = SSZ_BOOLEAN("b");
+  const ssz_def_t list    = SSZ_LIST("bools", bools, 8);
+  uint8_t         flags[] = {0, 1, 2};
+  TEST_ASSERT_TRUE(ssz_is_valid(ssz_ob(list, bytes(flags, 2)), true, NULL));
+  TEST_ASSERT_FALSE(ssz_is_valid(ssz_ob(list, bytes(flags, 3)), true, NULL));
+  TEST_ASSERT_TRUE(ssz_is_valid(ssz_ob(list, bytes(flags, 3)), false, NULL));
+
+  // the offsets of a list of dynamic elements must be aligned
+  const ssz_def_t bytes_list = SSZ_LIST("bytes", ssz_bytes_list, 8);
+  uint8_t         offsets[]  = {8, 0, 0, 0, 9, 0, 0, 0, 1, 2};
+  TEST_ASSERT_TRUE(ssz_is_valid(ssz_ob(bytes_list, bytes(offsets, 10)), true, NULL));
+  offsets[0] = 6;
+  TEST_ASSERT_FALSE(ssz_is_valid(ssz_ob(bytes_list, bytes(offsets, 10)), true, NULL));
+}
+
+void test_sha256_pairs() {
+  // more than one batch of 8 pairs, so the vectorized backends also need to handle the rest
+  uint8_t data[64 * 11];
+  uint8_t pairs[32 * 11];
+  uint8_t expected[32];
+  for (int i = 0; i < (int) sizeof(data); i++) data[i] = (uint8_t) (i * 7);
+
+  sha256_pairs(data, 11, pairs);
+  for (int i = 0; i < 11; i++) {
+    sha256(bytes(data + i * 64, 64), expected);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY_MESSAGE(expected, pairs + i * 32, 32, "sha256_pairs must match sha256");
+  }
+
+  // hashing in place
+  sha256_pairs(data, 11, data);
+  TEST_ASSERT_EQUAL_UINT8_ARRAY_MESSAGE(pairs, data, sizeof(pairs), "sha256_pairs in place");
+
+  uint8_t abc[32];
+  sha256(bytes((uint8_t*) "abc", 3), abc);
+  ASSERT_HEX_STRING_EQUAL("0xba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad", abc, 32, "invalid sha256");
+}
+
+void test_node_builder() {
+  uint8_t   raw_tx[]    = {1, 2, 3, 4, 5};
+  uint8_t   proof[]     = {4, 0, 0, 0, 0xaa};
+  bytes32_t root        = {0};
+  uint8_t   header[112] = {0};
+  for (int i = 0; i < 32; i++) root[i] = (uint8_t) i;
+  for (int i = 0; i < 112; i++) header[i] = (uint8_t) (i + 1);
+
+  // the nested builders
+  ssz_builder_t block = ssz_builder_for(ETH_LOGS_BLOCK_CONTAINER);
+  ssz_builder_t txs   = ssz_builder_for(ETH_LOGS_BLOCK[6]);
+  ssz_add_uint64(&block, 12345);
+  ssz_add_bytes(&block, "blockHash", bytes(root, 32));
+  ssz_add_bytes(&block, "proof", bytes(root, 32));
+  ssz_add_bytes(&block, "header", bytes(header, 112));
+  ssz_add_bytes(&block, "sync_committee_bits", bytes(root, 32));
+  ssz_add_bytes(&block, "sync_committee_signature", bytes(NULL, 96));
+  for (int i = 0; i < 2; i++) {
+    ssz_builder_t tx = ssz_builder_for(ETH_LOGS_TX_CONTAINER);
+    ssz_add_bytes(&tx, "transaction", bytes(raw_tx, 5 - i));
+    ssz_add_uint32(&tx, i);
+    ssz_add_dynamic_list_builders(&txs, 2, tx);
+  }
+  ssz_add_builders(&block, "txs", txs);
+  ssz_add_bytes(&block, "receipt_proof", bytes(proof, 5));
+  ssz_ob_t expected = ssz_builder_to_bytes(&block);
+
+  // the same value as tree, serialized in one pass
+  ssz_node_t node = ssz_node(&ETH_LOGS_BLOCK_CONTAINER);
+  ssz_node_set_uint(&node, "blockNumber", 12345);
+  ssz_node_set_bytes(&node, "blockHash", bytes(root, 32));
+  ssz_node_set_bytes(&node, "proof", bytes(root, 32));
+  ssz_node_set_bytes(&node, "header", bytes(header, 112));
+  ssz_node_set_bytes(&node, "sync_committee_bits", bytes(root, 32));
+  ssz_node_t* tx = ssz_node_add_elements(ssz_node_get(&node, "txs"), 2);
+  for (int i = 0; i < 2; i++, tx++) {
+    ssz_node_set_bytes(tx, "transaction", bytes(raw_tx, 5 - i));
+    ssz_node_set_uint(tx, "transactionIndex", i);
+  }
+  ssz_node_set_bytes(&node, "receipt_proof", bytes(proof, 5));
+  ssz_ob_t result = ssz_node_to_bytes(&node);
+
+  TEST_ASSERT_EQUAL_UINT32(expected.bytes.len, result.bytes.len);
+  TEST_ASSERT_EQUAL_UINT8_ARRAY_MESSAGE(expected.bytes.data, result.bytes.data, expected.bytes.len, "node and builder must serialize the same bytes");
+  TEST_ASSERT_TRUE(ssz_is_valid(result, true, NULL));
+  TEST_ASSERT_EQUAL_UINT64(12345, ssz_get_uint64(&result, "blockNumber"));
+  ssz_ob_t last_tx = ssz_at(ssz_get(&result, "txs"), 1);
+  TEST_ASSERT_EQUAL_UINT32(1, ssz_get_uint32(&last_tx, "transactionIndex"));
+  TEST_ASSERT_NULL(node.children);
+  free(expected.bytes.data);
+  free(result.bytes.data);
+
+  // unions get their selector
+  const ssz_def_t union_def = SSZ_UNION("proofs", C4_REQUEST_PROOFS_UNION);
+  ssz_node_t      proofs    = ssz_node(&union_def);
+  ssz_node_add_elements(ssz_node_select(&proofs, "LogsProof"), 0);
+  result = ssz_node_to_bytes(&proofs);
+  TEST_ASSERT_EQUAL_UINT32(1, result.bytes.len);
+  TEST_ASSERT_EQUAL_UINT8(5, result.bytes.data[0]);
+  free(result.bytes.data);
+}
+
+void test_zero_hashes() {
+  // each entry of the generated table is the hash of two entries of the level below
+  bytes32_t hash = {0};
+  for (int h = 1; h <= ZERO_HASHES_MAX_HEIGHT; h++) {
+    sha256_merkle(bytes(ZERO_HASHES[h - 1], 32), bytes(ZERO_HASHES[h - 1], 32), hash);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY_MESSAGE(ZERO_HASHES[h], hash, 32, "invalid zero hash");
+  }
+
+  // a list with a depth of 32, which must only hash the used leafes
+  const ssz_def_t deep_list = SSZ_LIST("deep", ssz_bytes32, 0xffffffff);
+  uint8_t         data[64];
+  bytes32_t       expected = {0};
+  bytes32_t       root     = {0};
+  bytes32_t       length   = {2};
+  for (int i = 0; i < 64; i++) data[i] = (uint8_t) i;
+  sha256(bytes(data, 64), expected);
+  for (int h = 1; h < 32; h++) sha256_merkle(bytes(expected, 32), bytes(ZERO_HASHES[h], 32), expected);
+  sha256_merkle(bytes(expected, 32), bytes(length, 32), expected);
+
+  ssz_ob_t list = ssz_ob(deep_list, bytes(data, 64));
+  ssz_hash_tree_root(list, root);
+  TEST_ASSERT_EQUAL_UINT8_ARRAY_MESSAGE(expected, root, 32, "invalid root of a deep list");
+
+  // proofs for gindexes beyond 32 bits
+  gindex_t gindex = ssz_gindex(&deep_list, 1, 1);
+  TEST_ASSERT_EQUAL_UINT64((((gindex_t) 1) << 33) + 1, gindex);
+  bytes_t proof = ssz_create_proof(list, root, gindex);
+  TEST_ASSERT_EQUAL_UINT32(33 * 32, proof.len);
+  ssz_verify_single_merkle_proof(proof, data + 32, gindex, root);
+  TEST_ASSERT_EQUAL_UINT8_ARRAY_MESSAGE(expected, root, 32, "invalid proof of a deep list");
+  free(proof.data);
+}
+
+void test_chain_domain() {
+  // the precomputed fork data roots must match the hash_tree_root of the ForkData (version, genesis_validators_root)
+  const ssz_def_t fork_data[]         = {SSZ_BYTE_VECTOR("version", 4), SSZ_BYTES32("state")};
+  const ssz_def_t fork_data_container = SSZ_LOCAL_CONTAINER("ForkData", fork_data);
+  uint8_t         buffer[36]          = {0};
+  bytes32_t       root                = {0};
+  bytes32_t       domain              = {0};
+  TEST_ASSERT_TRUE(c4_chain_genesis_validators_root(C4_CHAIN_MAINNET, buffer + 4));
+
+  for (fork_id_t fork = C4_FORK_PHASE0; fork <= C4_FORK_FULU; fork++) {
+    buffer[0] = (uint8_t) fork;
+    ssz_hash_tree_root(ssz_ob(fork_data_container, bytes(buffer, 36)), root);
+    TEST_ASSERT_TRUE(c4_chain_domain(C4_CHAIN_MAINNET, fork, C4_DOMAIN_SYNC_COMMITTEE, domain));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY_MESSAGE(root, domain + 4, 28, "invalid fork data root");
+    TEST_ASSERT_EQUAL_UINT32(C4_DOMAIN_SYNC_COMMITTEE, uint32_from_le(domain));
+  }
+  TEST_ASSERT_FALSE(c4_chain_domain(C4_CHAIN_MAINNET, C4_FORK_FULU + 1, C4_DOMAIN_SYNC_COMMITTEE, domain));
+}
+
 int main(void) {
   UNITY_BEGIN();
   RUN_TEST(test_hash_body);
   RUN_TEST(test_hash_root);
   RUN_TEST(test_block_body);
+  RUN_TEST(test_hash_lists);
+  RUN_TEST(test_sha256_pairs);
+  RUN_TEST(test_hashed_view);
+  RUN_TEST(test_layout);
+  RUN_TEST(test_field_accessors);
+  RUN_TEST(test_fork_gindexes);
+  RUN_TEST(test_validate);
+  RUN_TEST(test_node_builder);
+  RUN_TEST(test_zero_hashes);
+  RUN_TEST(test_chain_domain);
   return UNITY_END();
 }
\ No newline at end of file
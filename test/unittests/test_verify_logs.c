@@ -15,8 +15,21 @@ void test_balance() {
   verify_count("eth_getLogs1", "eth_getLogs", "[{\"address\":[\"0xdac17f958d2ee523a2206206994597c13d831ec7\"],\"fromBlock\":\"0x14d7970\",\"toBlock\":\"0x14d7970\"}]", C4_CHAIN_MAINNET, 1);
 }
 
+void test_batch() {
+  verify_batch("eth_getLogs1", "eth_getLogs", "[{\"address\":[\"0xdac17f958d2ee523a2206206994597c13d831ec7\"],\"fromBlock\":\"0x14d7970\",\"toBlock\":\"0x14d7970\"}]", C4_CHAIN_MAINNET, 4, -1);
+}
+
+// large enough to be split over 4 threads. The last signature is invalid, so the merged pairing fails and each one is verified on its own.
+void test_batch_threads() {
+  blst_set_threads(4);
+  verify_batch("eth_getLogs1", "eth_getLogs", "[{\"address\":[\"0xdac17f958d2ee523a2206206994597c13d831ec7\"],\"fromBlock\":\"0x14d7970\",\"toBlock\":\"0x14d7970\"}]", C4_CHAIN_MAINNET, 16, 15);
+  blst_set_threads(0);
+}
+
 int main(void) {
   UNITY_BEGIN();
   RUN_TEST(test_balance);
+  RUN_TEST(test_batch);
+  RUN_TEST(test_batch_threads);
   return UNITY_END();
 }
\ No newline at end of file
@@ -0,0 +1,105 @@
+#include "../../libs/blst/blst.h"
+#include "c4_assert.h"
+#include "unity.h"
+#include "util/bytes.h"
+#include "verifier/types_fields.h"
+
+#define LOGS_DIR    "eth_getLogs1"
+#define LOGS_METHOD "eth_getLogs"
+#define LOGS_ARGS   "[{\"address\":[\"0xdac17f958d2ee523a2206206994597c13d831ec7\"],\"fromBlock\":\"0x14d7970\",\"toBlock\":\"0x14d7970\"}]"
+#define PERIOD      1351
+
+void setUp(void) {
+  reset_local_filecache();
+}
+
+void tearDown(void) {
+  reset_local_filecache();
+}
+
+// stores the keys of the period followed by their aggregate like a light client update does, either compressed or deserialized
+static void store_with_aggregate(bool compressed) {
+  char     name[100];
+  uint8_t  mask[64];
+  uint8_t  aggregate[96];
+  buffer_t data = {0};
+  set_state(C4_CHAIN_MAINNET, LOGS_DIR);
+  sprintf(name, "%s/sync_1_%d", LOGS_DIR, PERIOD);
+  bytes_t keys = read_testdata(name);
+  TEST_ASSERT_EQUAL_UINT32_MESSAGE(512 * 96, keys.len, "the fixture must hold deserialized keys");
+
+  memset(mask, 0xff, sizeof(mask));
+  TEST_ASSERT_TRUE(blst_aggregate_pubkeys(keys.data, 512, bytes(mask, 64), true, NULL, aggregate));
+  for (int i = 0; i <= 512; i++) {
+    uint8_t* key = i < 512 ? keys.data + i * 96 : aggregate;
+    if (compressed) {
+      uint8_t tmp[48];
+      blst_p1_affine_compress(tmp, (blst_p1_affine*) key);
+      buffer_append(&data, bytes(tmp, 48));
+    }
+    else
+      buffer_append(&data, bytes(key, 96));
+  }
+
+  sprintf(name, "sync_1_%d", PERIOD);
+  file_set(name, data.data);
+  buffer_free(&data);
+  free(keys.data);
+}
+
+// the aggregate minus the absent keys must be the same key as the sum of the signing keys
+static void check_aggregate(c4_sync_state_t* state, int signers) {
+  uint8_t mask[64]   = {0};
+  uint8_t added[96]  = {0};
+  uint8_t result[96] = {0};
+  for (int i = 0; i < signers; i++) mask[i / 8] |= 1 << (i % 8);
+  TEST_ASSERT_TRUE(blst_aggregate_pubkeys(state->validators.data, 512, bytes(mask, 64), state->deserialized, NULL, added));
+  TEST_ASSERT_TRUE(blst_aggregate_pubkeys(state->validators.data, 512, bytes(mask, 64), state->deserialized, state->aggregated_pubkey, result));
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(added, result, 96);
+}
+
+static void verify_with_aggregate(bool compressed) {
+  store_with_aggregate(compressed);
+  c4_sync_state_t state = c4_get_validators(PERIOD, C4_CHAIN_MAINNET);
+  TEST_ASSERT_NOT_NULL_MESSAGE(state.aggregated_pubkey, "the aggregate must be loaded with the keys");
+#ifdef BLS_DESERIALIZE
+  TEST_ASSERT_TRUE(state.deserialized);
+#else
+  TEST_ASSERT_EQUAL(!compressed, state.deserialized);
+#endif
+  check_aggregate(&state, 400); // more than half: the absent keys are subtracted
+  check_aggregate(&state, 256); // at most half: the signing keys are added
+#ifndef C4_STATIC_MEMORY
+  free(state.validators.data);
+#endif
+
+  // the header of the proof was signed by more than half of the committee
+  proofer_ctx_t* proof_ctx = create_proof(LOGS_DIR, LOGS_METHOD, LOGS_ARGS, C4_CHAIN_MAINNET);
+  TEST_ASSERT_NOT_NULL(proof_ctx);
+  verify_ctx_t ctx = {0};
+  c4_verify_init(&ctx, proof_ctx->proof, LOGS_METHOD, json_parse(LOGS_ARGS), C4_CHAIN_MAINNET);
+  ssz_ob_t block   = ssz_at(ctx.proof, 0);
+  bytes_t  bits    = eth_logs_block_sync_committee_bits(&block).bytes;
+  int      signers = 0;
+  for (uint32_t i = 0; i < bits.len * 8; i++) signers += (bits.data[i / 8] >> (i % 8)) & 1;
+  TEST_ASSERT_TRUE_MESSAGE(signers > 256, "the header must be signed by more than half of the committee");
+
+  c4_verify(&ctx);
+  TEST_ASSERT_TRUE_MESSAGE(ctx.success, ctx.state.error);
+  c4_proofer_free(proof_ctx);
+}
+
+void test_aggregate_compressed() {
+  verify_with_aggregate(true);
+}
+
+void test_aggregate_deserialized() {
+  verify_with_aggregate(false);
+}
+
+int main(void) {
+  UNITY_BEGIN();
+  RUN_TEST(test_aggregate_compressed);
+  RUN_TEST(test_aggregate_deserialized);
+  return UNITY_END();
+}
@@ -1,8 +1,14 @@
 // datei: test_addiere.c
 #include "c4_assert.h"
+#include "proofer/beacon.h"
 #include "unity.h"
 #include "util/bytes.h"
 #include "util/ssz.h"
+
+#define TX_DIR    "eth_getTransactionByHash1"
+#define TX_METHOD "eth_getTransactionByHash"
+#define TX_ARGS   "[\"0x5f41c75eabb3fee183e0896859a82c81635dbb40edf5630fa29555e8d6c3e7f1\"]"
+
 void setUp(void) {
   reset_local_filecache();
 }
@@ -12,11 +18,57 @@ void tearDown(void) {
 }
 
 void test_tx() {
-  verify("eth_getTransactionByHash1", "eth_getTransactionByHash", "[\"0x5f41c75eabb3fee183e0896859a82c81635dbb40edf5630fa29555e8d6c3e7f1\"]", C4_CHAIN_MAINNET);
+  verify(TX_DIR, TX_METHOD, TX_ARGS, C4_CHAIN_MAINNET);
+}
+
+void test_shared_body() {
+  c4_beacon_body_cache_free();
+
+  // two contexts proofing the same block hash the body only once
+  proofer_ctx_t* first  = create_proof(TX_DIR, TX_METHOD, TX_ARGS, C4_CHAIN_MAINNET);
+  proofer_ctx_t* second = create_proof(TX_DIR, TX_METHOD, TX_ARGS, C4_CHAIN_MAINNET);
+  TEST_ASSERT_NOT_NULL(first);
+  TEST_ASSERT_NOT_NULL(second);
+  TEST_ASSERT_EQUAL_UINT32(first->proof.len, second->proof.len);
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(first->proof.data, second->proof.data, first->proof.len);
+  c4_proofer_free(first);
+  c4_proofer_free(second);
+
+  c4_body_cache_stats_t stats = c4_beacon_body_cache_stats();
+  TEST_ASSERT_EQUAL_UINT32(1, stats.entries);
+  TEST_ASSERT_EQUAL_UINT64(1, stats.misses);
+  TEST_ASSERT_EQUAL_UINT64(1, stats.hits);
+  c4_beacon_body_cache_free();
+}
+
+void test_evicted_body() {
+  c4_beacon_body_cache_free();
+  bytes_t data = read_testdata("body_11038724.ssz");
+  TEST_ASSERT_NOT_NULL_MESSAGE(data.data, "body_11038724.ssz not found");
+  beacon_block_t block = {.slot = 0, .body = ssz_ob(BEACON_BLOCK_BODY_CONTAINER, data)};
+  block.execution      = ssz_get(&block.body, "executionPayload");
+
+  bytes32_t         root = {0};
+  bytes32_t         expected;
+  c4_hashed_body_t* held = c4_beacon_body_acquire(&block);
+  ssz_hash_tree_root(block.body, expected);
+  TEST_ASSERT_TRUE(held->body.data != data.data);
+
+  // more blocks evict the held body, which keeps its own copy of the data until it is released
+  for (block.slot = 1; block.slot <= 4; block.slot++) c4_beacon_body_release(c4_beacon_body_acquire(&block));
+  free(data.data);
+  TEST_ASSERT_EQUAL_UINT32(4, c4_beacon_body_cache_stats().entries);
+  TEST_ASSERT_EQUAL_UINT32(1, held->refs);
+  ssz_hashed_root(held->view, root);
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, root, 32);
+  c4_beacon_body_release(held);
+  c4_beacon_body_cache_free();
 }
 
 int main(void) {
   UNITY_BEGIN();
   RUN_TEST(test_tx);
+  RUN_TEST(test_shared_body);
+  RUN_TEST(test_evicted_body);
   return UNITY_END();
 }
\ No newline at end of file